@@ -10,6 +10,13 @@ namespace boost { namespace numeric { namespace ublas {
     
 #define UBLAS_USE_VECTORIZATION 1 // vectorization is the default option
 
+#if UBLAS_USE_VECTORIZATION && defined(__SSE2__)
+#define UBLAS_HAS_SSE2 1
+#else
+#define UBLAS_HAS_SSE2 0
+#endif
+#define UBLAS_HAS_SSE UBLAS_HAS_SSE2
+
 #if UBLAS_USE_VECTORIZATION && defined(__SSSE3__)
 #define UBLAS_HAS_SSE3 1
 #else
@@ -28,6 +35,18 @@ namespace boost { namespace numeric { namespace ublas {
 #define UBLAS_HAS_AVX 0
 #endif
 
+#if UBLAS_USE_VECTORIZATION && defined(__AVX2__)
+#define UBLAS_HAS_AVX2 1
+#else
+#define UBLAS_HAS_AVX2 0
+#endif
+
+#if UBLAS_USE_VECTORIZATION && defined(__FMA__)
+#define UBLAS_HAS_FMA 1
+#else
+#define UBLAS_HAS_FMA 0
+#endif
+
 template <bool Select, typename T1, typename T2>
 struct select_type {
     typedef T1 type;
@@ -71,7 +90,8 @@ struct is_numeric<double> {
 template <typename T>
 struct is_vectorizable {
     enum {
-        value = ( UBLAS_HAS_SSE3  && ( is_numeric<T>::value ) ) ||
+        value = ( UBLAS_HAS_SSE2  && ( is_numeric<T>::value ) ) ||
+        ( UBLAS_HAS_SSE3  && ( is_numeric<T>::value ) ) ||
         ( UBLAS_HAS_SSE4  && ( is_numeric<T>::value ) ) ||
         ( UBLAS_HAS_AVX && ( is_numeric<T>::value ) )
     };
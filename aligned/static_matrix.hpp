@@ -3,15 +3,16 @@
 #define STATIC_MATRIX_H
 
 #include <boost/numeric/ublas/functional.hpp>
+#include <boost/numeric/ublas/detail/fixed_kernels.hpp>
 
 template<class T, std::size_t M, std::size_t N, class L>
-class static_matrix : public matrix_expression< static_matrix<T, M, N, L> > {
+class static_matrix : public matrix_expression< ::static_matrix<T, M, N, L> > {
     
 private:
     typedef T *pointer;
     typedef L layout_type;
     typedef aligned_array<T, M * N> A;
-    typedef static_matrix<T, M, N, L> self_type;
+    typedef ::static_matrix<T, M, N, L> self_type;
     
 public:
     typedef typename A::size_type size_type;
@@ -28,10 +29,16 @@ public:
     typedef const static_matrix& nested_type;
     
     typedef typename L::orientation_category orientation_category;
+
+    enum {
+        RowsAtCompileTime = M,
+        ColsAtCompileTime = N,
+        SizeAtCompileTime = M * N,
+    };
     
-    using matrix_expression< static_matrix<T, M, N, L> >::operator=;
-    using matrix_expression< static_matrix<T, M, N, L> >::operator+=;
-    using matrix_expression< static_matrix<T, M, N, L> >::operator-=;
+    using matrix_expression< ::static_matrix<T, M, N, L> >::operator=;
+    using matrix_expression< ::static_matrix<T, M, N, L> >::operator+=;
+    using matrix_expression< ::static_matrix<T, M, N, L> >::operator-=;
     
     // Construction and destruction
     
@@ -872,6 +879,33 @@ private:
     array_type data_;
 };
 
+namespace boost { namespace numeric { namespace ublas {
+
+    // static_matrix uses the unrolled kernels of fixed_matrix
+    template <typename T, std::size_t M, std::size_t N, typename L>
+    struct fixed_size_traits< ::static_matrix<T, M, N, L> > {
+        typedef T value_type;
+        typedef typename L::orientation_category orientation_category;
+        typedef ::static_matrix<T, N, M, L> transpose_type;
+
+        enum {
+            value = 1,
+            rows = M,
+            cols = N,
+        };
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const ::static_matrix<T, M, N, L> &m) { return &m.data () [0]; }
+        static BOOST_UBLAS_INLINE
+        T *data (::static_matrix<T, M, N, L> &m) { return &m.data () [0]; }
+        static BOOST_UBLAS_INLINE
+        const T *data (const matrix_reference<const ::static_matrix<T, M, N, L> > &m) { return &m.expression ().data () [0]; }
+        static BOOST_UBLAS_INLINE
+        T *data (const matrix_reference< ::static_matrix<T, M, N, L> > &m) { return &m.expression ().data () [0]; }
+    };
+
+}}}
+
 template <class T, std::size_t M>
 using static_vector = static_matrix<T, M, 1>;
 
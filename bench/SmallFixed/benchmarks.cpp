@@ -0,0 +1,101 @@
+/*
+ Small fixed size matrix benchmark for uBlas and GSoC 2014.
+
+ Compares fixed_matrix, whose products, sums, determinants and inverses are fully unrolled,
+ with the generic matrix<double> path for N x N matrices, N = 2 ... 8.
+ Every operation is repeated over a batch of matrices so that one timing covers many calls.
+
+ Output (in MFLOPs, like the other benchmarks, one curve of the plot per file):
+ fixed_product.dat    fixed_matrix product
+ matrix_product.dat   matrix<double> product
+ fixed_sum.dat        fixed_matrix sum
+ matrix_sum.dat       matrix<double> sum
+
+ Determinants and inverses are timed by the fixeddet and fixedinverse kernels of the harness.
+*/
+
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <fstream>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/operation/fixed_size.hpp>
+#include "../GEMV1/utilities.cpp"
+
+using namespace boost::numeric::ublas;
+
+const size_t batch = 1000;
+const size_t steps = 20;
+
+template <typename F>
+double run(const F& kernel) {
+
+    std::vector<double> times;
+    for(size_t i = 0; i < steps; ++i){
+
+        auto start = std::chrono::steady_clock::now();
+        kernel();
+        auto end = std::chrono::steady_clock::now();
+
+        auto diff = end - start;
+        times.push_back(std::chrono::duration<double, std::milli> (diff).count()); //save time in ms for each iteration
+    }
+
+    return *(std::min_element(times.begin(), times.end())) / 1000.0; //convert to seconds
+}
+
+template <typename M>
+void init(M& m) {
+    for(size_t i = 0; i < m.size1(); ++i)
+        for(size_t j = 0; j < m.size2(); ++j)
+            m(i, j) = ndistribution(generator) + (i == j ? 50.0 : 0.0); // diagonally dominant, so invertible
+}
+
+template <size_t N>
+void bench(std::ofstream& fixed, std::ofstream& dynamic, std::ofstream& fixedsum, std::ofstream& dynamicsum) {
+
+    typedef fixed_matrix<value_type, N, N> fixed_type;
+    typedef matrix<value_type> dynamic_type;
+
+    std::vector<fixed_type> fa(batch), fb(batch), fc(batch);
+    std::vector<dynamic_type> da(batch, dynamic_type(N, N)), db(batch, dynamic_type(N, N)), dc(batch, dynamic_type(N, N));
+    for(size_t i = 0; i < batch; ++i){
+        init(fa[i]); init(fb[i]);
+        da[i] = fa[i]; db[i] = fb[i];
+    }
+
+    const double flops = double(batch) * (2.0 * N * N * N - N * N);
+    double t = run([&] { for(size_t i = 0; i < batch; ++i) fc[i] = fa[i] * fb[i]; });
+    fixed << N << " " << flops / (t * 1E6) << std::endl;
+    t = run([&] { for(size_t i = 0; i < batch; ++i) dc[i] = da[i] * db[i]; });
+    dynamic << N << " " << flops / (t * 1E6) << std::endl;
+
+    const double adds = double(batch) * N * N;
+    t = run([&] { for(size_t i = 0; i < batch; ++i) fc[i] = fa[i] + fb[i]; });
+    fixedsum << N << " " << adds / (t * 1E6) << std::endl;
+    t = run([&] { for(size_t i = 0; i < batch; ++i) dc[i] = da[i] + db[i]; });
+    dynamicsum << N << " " << adds / (t * 1E6) << std::endl;
+
+    // keep the results alive
+    if(fc[0](0, 0) == 0 && dc[0](0, 0) == 0)
+        std::cerr << "unexpected zero result" << std::endl;
+}
+
+int main(int argc, char **argv){
+
+    std::ofstream fixed("fixed_product.dat"), dynamic("matrix_product.dat"), fixedsum("fixed_sum.dat"), dynamicsum("matrix_sum.dat");
+
+    bench<2>(fixed, dynamic, fixedsum, dynamicsum);
+    bench<3>(fixed, dynamic, fixedsum, dynamicsum);
+    bench<4>(fixed, dynamic, fixedsum, dynamicsum);
+    bench<5>(fixed, dynamic, fixedsum, dynamicsum);
+    bench<6>(fixed, dynamic, fixedsum, dynamicsum);
+    bench<7>(fixed, dynamic, fixedsum, dynamicsum);
+    bench<8>(fixed, dynamic, fixedsum, dynamicsum);
+
+    return 0;
+}
\ No newline at end of file
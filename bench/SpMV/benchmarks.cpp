@@ -0,0 +1,108 @@
+/*
+ Sparse matrix-vector product scaling benchmark for uBlas and GSoC 2014.
+
+ Times axpy_prod (A, x, y) for compressed_matrix in row major (CSR) and column major (CSC) storage,
+ with 1, 2, 4, 8, 16 and 32 threads, over three sparsity patterns:
+ banded     a band of half width 8 around the diagonal
+ powerlaw   row lengths following a power law, a few rows holding most non zeros
+ random     about 16 non zeros per row at uniformly random columns
+
+ Output (in MFLOPs, one curve of the plot per file): <pattern>_csr.dat and <pattern>_csc.dat,
+ each line "threads MFLOPs", so the plot shows the scaling with the number of threads.
+*/
+
+#define BOOST_UBLAS_USE_THREADS
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <fstream>
+#include <cmath>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include "../GEMV1/utilities.cpp"
+
+using namespace boost::numeric::ublas;
+
+const size_t N = 200000;
+const size_t steps = 10;
+
+// Builds the pattern row by row for CSR and column by column for CSC (the CSC matrix is then the
+// transpose of the CSR one), so that the elements are always appended in storage order
+template <typename L>
+void make_pattern(const std::string& pattern, compressed_matrix<value_type, L>& m) {
+
+    std::uniform_int_distribution<size_t> column(0, N - 1);
+    std::vector<size_t> columns;
+    for(size_t i = 0; i < N; ++i){
+        columns.clear();
+        if(pattern == "banded"){
+            for(size_t j = (i < 8 ? 0 : i - 8); j <= std::min(i + 8, N - 1); ++j)
+                columns.push_back(j);
+        }
+        else if(pattern == "powerlaw"){
+            // row i holds about 4 * N / (i + 1) ^ 0.8 non zeros, capped to the row
+            const size_t length = std::min(N, size_t(4.0 * std::pow(double(N), 0.8) / std::pow(double(i + 1), 0.8)) + 1);
+            for(size_t k = 0; k < length; ++k)
+                columns.push_back(column(generator));
+        }
+        else{
+            for(size_t k = 0; k < 16; ++k)
+                columns.push_back(column(generator));
+        }
+        std::sort(columns.begin(), columns.end());
+        columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+        for(size_t k = 0; k < columns.size(); ++k){
+            if(boost::is_same<L, column_major>::value)
+                m(columns[k], i) = udistribution(generator);
+            else
+                m(i, columns[k]) = udistribution(generator);
+        }
+    }
+}
+
+template <typename L>
+void bench(const std::string& pattern, const std::string& name) {
+
+    compressed_matrix<value_type, L> a(N, N);
+    make_pattern(pattern, a);
+    vector<value_type> x(N), y(N);
+    for(size_t i = 0; i < N; ++i)
+        x(i) = ndistribution(generator);
+
+    std::ofstream outfile((pattern + "_" + name + ".dat").c_str());
+    const double flops = 2.0 * a.nnz();
+    for(size_t threads = 1; threads <= 32; threads *= 2){
+
+        parallel_policy::set_num_threads(threads);
+        std::vector<double> times;
+        for(size_t i = 0; i < steps; ++i){
+
+            auto start = std::chrono::steady_clock::now();
+            axpy_prod(a, x, y, true);
+            auto end = std::chrono::steady_clock::now();
+
+            auto diff = end - start;
+            times.push_back(std::chrono::duration<double, std::milli> (diff).count()); //save time in ms for each iteration
+        }
+
+        const double t = *(std::min_element(times.begin(), times.end())) / 1000.0; //convert to seconds
+        outfile << threads << " " << flops / (t * 1E6) << std::endl;
+    }
+}
+
+int main(int argc, char **argv){
+
+    const std::string patterns[] = { "banded", "powerlaw", "random" };
+    for(size_t p = 0; p < 3; ++p){
+        std::cout << patterns[p] << std::endl;
+        bench<row_major>(patterns[p], "csr");
+        bench<column_major>(patterns[p], "csc");
+    }
+
+    return 0;
+}
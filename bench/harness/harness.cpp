@@ -0,0 +1,264 @@
+/*
+ Benchmark harness for uBlas and GSoC 2014.
+
+ A single driver for all the uBlas kernels of the per kernel benchmarks (kernels/ublas), meant to track
+ performance regressions from one release to the next on the same machine. The per kernel directories remain
+ for the comparisons with the other libraries.
+
+ Build (from bench/harness):
+ g++ -O3 -std=c++11 -DNDEBUG -march=native -I /path/to/boost harness.cpp -o harness
+
+ Usage: ./harness [options]
+ --list                   print the kernels and their size groups, then exit
+ --kernels a,b,...        kernels to run (default: all)
+ --sizes n1,n2,...        sizes to run every kernel at
+ --sweep first:last:step  size sweep, step is a factor ("x2", the default) or an increment ("+100")
+                          (default: a sweep chosen per group, vector, matvec, matmat, sparse, spmv or fixed)
+ --warmup n               untimed calls before timing (default 2)
+ --min-reps n             least number of timed calls (default 10)
+ --max-reps n             most number of timed calls (default 1000)
+ --tolerance t            stop once the 95% confidence interval of the median is within +-t (default 0.01)
+ --max-time s             time budget per kernel and size in seconds (default 2)
+ --flush-mib n            size of the cache flush buffer (default 64)
+ --no-flush               do not flush the caches between timed calls
+ --threads n              number of threads of parallel_policy
+ --format csv|json        output format (default csv)
+ --output file            output file (default: standard output)
+
+ Every result holds the median time, its confidence interval and the fastest time in seconds,
+ and GFLOP/s and GB/s computed from the median with the models of kernels.cpp.
+
+ The streamtriad kernels are the STREAM triad over matrices whose pages are placed by a single thread,
+ first touched by the threads of the pool or interleaved over the memory nodes. On a NUMA machine build
+ with -DBOOST_UBLAS_USE_THREADS -DBOOST_UBLAS_BIND_THREADS -pthread, run them with --threads set to the
+ number of cores and sizes well beyond the last level cache, and compare their GB/s.
+*/
+
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <ctime>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <cmath>
+#include <cstdlib>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/banded.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_sparse.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/operation_sparse.hpp>
+#include <boost/numeric/ublas/operation/fixed_size.hpp>
+#include <boost/numeric/ublas/blas.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/cholesky.hpp>
+#include <boost/numeric/ublas/detail/numa.hpp>
+#include "measure.cpp"
+#include "kernels.cpp"
+
+struct result {
+    std::string kernel;
+    size_t N;
+    measurement m;
+    double gflops;
+    double gbs;
+};
+
+std::vector<std::string> split(const std::string& s, char separator) {
+
+    std::vector<std::string> parts;
+    std::stringstream stream(s);
+    std::string part;
+    while(std::getline(stream, part, separator))
+        if(!part.empty())
+            parts.push_back(part);
+    return parts;
+}
+
+bool parse_sweep(const std::string& s, std::vector<size_t>& sizes) {
+
+    std::vector<std::string> parts = split(s, ':');
+    if(parts.size() < 2 || parts.size() > 3)
+        return false;
+    const size_t first = std::strtoul(parts[0].c_str(), 0, 10), last = std::strtoul(parts[1].c_str(), 0, 10);
+    const std::string step = parts.size() == 3 ? parts[2] : "x2";
+    const size_t by = std::strtoul(step.c_str() + 1, 0, 10);
+    if(first == 0 || last < first || (step[0] != 'x' && step[0] != '+') || (step[0] == 'x' ? by < 2 : by < 1))
+        return false;
+    for(size_t n = first; n <= last; n = step[0] == 'x' ? n * by : n + by)
+        sizes.push_back(n);
+    return true;
+}
+
+void usage() {
+    std::cerr << "usage: harness [--list] [--kernels a,b,...] [--sizes n1,n2,...] [--sweep first:last:step]\n"
+                 "               [--warmup n] [--min-reps n] [--max-reps n] [--tolerance t] [--max-time s]\n"
+                 "               [--flush-mib n] [--no-flush] [--threads n] [--format csv|json] [--output file]\n";
+}
+
+void write_csv(std::ostream& out, const std::vector<result>& results) {
+
+    out << "kernel,N,reps,stable,median_s,ci_low_s,ci_high_s,min_s,gflops,gbs\n";
+    for(size_t i = 0; i < results.size(); ++i){
+        const result& r = results[i];
+        out << r.kernel << "," << r.N << "," << r.m.reps << "," << (r.m.stable ? 1 : 0) << ","
+            << r.m.median << "," << r.m.ci_low << "," << r.m.ci_high << "," << r.m.min << ","
+            << r.gflops << "," << r.gbs << "\n";
+    }
+}
+
+void write_json(std::ostream& out, const std::vector<result>& results, const measure_options& options) {
+
+    char date[32];
+    const std::time_t now = std::time(0);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    out << "{\n"
+        << "  \"date\": \"" << date << "\",\n"
+#ifdef __VERSION__
+        << "  \"compiler\": \"" << __VERSION__ << "\",\n"
+#endif
+        << "  \"threads\": " << boost::numeric::ublas::parallel_policy::num_threads() << ",\n"
+        << "  \"options\": { \"warmup\": " << options.warmup << ", \"min_reps\": " << options.min_reps
+        << ", \"max_reps\": " << options.max_reps << ", \"tolerance\": " << options.tolerance
+        << ", \"max_time\": " << options.max_time << ", \"flush\": " << (options.flush ? "true" : "false")
+        << ", \"flush_bytes\": " << options.flush_bytes << " },\n"
+        << "  \"results\": [";
+    for(size_t i = 0; i < results.size(); ++i){
+        const result& r = results[i];
+        out << (i ? ",\n" : "\n")
+            << "    { \"kernel\": \"" << r.kernel << "\", \"N\": " << r.N << ", \"reps\": " << r.m.reps
+            << ", \"stable\": " << (r.m.stable ? "true" : "false") << ", \"median_s\": " << r.m.median
+            << ", \"ci_low_s\": " << r.m.ci_low << ", \"ci_high_s\": " << r.m.ci_high << ", \"min_s\": " << r.m.min
+            << ", \"gflops\": " << r.gflops << ", \"gbs\": " << r.gbs << " }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+int main(int argc, char **argv){
+
+    measure_options options;
+    std::vector<std::string> selected;
+    std::vector<size_t> sizes;
+    std::string format = "csv", output;
+
+    for(int i = 1; i < argc; ++i){
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if(arg == "--list"){
+            for(size_t k = 0; k < harness::kernel_count; ++k)
+                std::cout << harness::kernels[k].name << " " << harness::kernels[k].group << "\n";
+            return 0;
+        }
+        else if(arg == "--no-flush")
+            options.flush = false;
+        else if(!has_value){
+            usage();
+            return 1;
+        }
+        else if(arg == "--kernels")
+            selected = split(argv[++i], ',');
+        else if(arg == "--sizes"){
+            std::vector<std::string> parts = split(argv[++i], ',');
+            for(size_t k = 0; k < parts.size(); ++k)
+                sizes.push_back(std::strtoul(parts[k].c_str(), 0, 10));
+        }
+        else if(arg == "--sweep"){
+            if(!parse_sweep(argv[++i], sizes)){
+                std::cerr << "invalid sweep '" << argv[i] << "'\n";
+                return 1;
+            }
+        }
+        else if(arg == "--warmup")
+            options.warmup = std::strtoul(argv[++i], 0, 10);
+        else if(arg == "--min-reps")
+            options.min_reps = std::strtoul(argv[++i], 0, 10);
+        else if(arg == "--max-reps")
+            options.max_reps = std::strtoul(argv[++i], 0, 10);
+        else if(arg == "--tolerance")
+            options.tolerance = std::atof(argv[++i]);
+        else if(arg == "--max-time")
+            options.max_time = std::atof(argv[++i]);
+        else if(arg == "--flush-mib")
+            options.flush_bytes = std::strtoul(argv[++i], 0, 10) << 20;
+        else if(arg == "--threads")
+            boost::numeric::ublas::parallel_policy::set_num_threads(std::strtoul(argv[++i], 0, 10));
+        else if(arg == "--format")
+            format = argv[++i];
+        else if(arg == "--output")
+            output = argv[++i];
+        else{
+            usage();
+            return 1;
+        }
+    }
+    if(format != "csv" && format != "json"){
+        usage();
+        return 1;
+    }
+    for(size_t k = 0; k < selected.size(); ++k){
+        size_t j = 0;
+        while(j < harness::kernel_count && selected[k] != harness::kernels[j].name)
+            ++j;
+        if(j == harness::kernel_count){
+            std::cerr << "unknown kernel '" << selected[k] << "', see --list\n";
+            return 1;
+        }
+    }
+
+    cache_flusher flusher(options.flush ? options.flush_bytes : 0);
+    std::vector<result> results;
+    for(size_t k = 0; k < harness::kernel_count; ++k){
+
+        const harness::kernel& kernel = harness::kernels[k];
+        if(!selected.empty() && std::find(selected.begin(), selected.end(), std::string(kernel.name)) == selected.end())
+            continue;
+
+        std::vector<size_t> sweep = sizes;
+        if(sweep.empty()){
+            size_t first, last, factor;
+            harness::default_sweep(kernel.group, first, last, factor);
+            for(size_t n = first; n <= last; n *= factor)
+                sweep.push_back(n);
+        }
+
+        for(size_t s = 0; s < sweep.size(); ++s){
+
+            const size_t N = sweep[s];
+            std::function<void()> run = kernel.setup(N);
+
+            result r;
+            r.kernel = kernel.name;
+            r.N = N;
+            r.m = measure(run, options, flusher);
+            r.gflops = kernel.flops(double(N)) / r.m.median * 1E-9;
+            r.gbs = kernel.bytes(double(N)) / r.m.median * 1E-9;
+            results.push_back(r);
+
+            std::cerr << kernel.name << " N=" << N << " " << r.gflops << " GFLOP/s " << r.gbs << " GB/s"
+                      << " (" << r.m.reps << " reps" << (r.m.stable ? "" : ", not stable") << ")" << std::endl;
+        }
+    }
+
+    std::ofstream file;
+    if(!output.empty()){
+        file.open(output.c_str());
+        if(!file){
+            std::cerr << "cannot open '" << output << "'\n";
+            return 1;
+        }
+    }
+    std::ostream& out = output.empty() ? std::cout : file;
+    if(format == "json")
+        write_json(out, results, options);
+    else
+        write_csv(out, results);
+
+    return 0;
+}
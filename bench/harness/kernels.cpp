@@ -0,0 +1,771 @@
+/*
+ Kernel registry of the benchmark harness
+
+ Every uBlas kernel of kernels/ublas is split into a setup, run once per size, and the timed operation.
+ Each kernel also provides models of its floating point operation count and of its compulsory memory traffic
+ (every operand read once, every result written once) from which GFLOP/s and GB/s are reported.
+ The group selects the default size sweep: the O(N), O(N^2) and O(N^3) kernels, the sparse ones, the
+ sparse matrix-vector products with a fixed number of non zeros per row and the small fixed size kernels,
+ run over a batch of N matrices, are interesting over very different ranges of N.
+*/
+
+namespace harness {
+
+using namespace boost::numeric::ublas;
+
+typedef matrix<value_type, row_major> rmatrix;
+typedef matrix<value_type, column_major> cmatrix;
+typedef vector<value_type> dvector;
+typedef compressed_matrix<value_type> smatrix;
+typedef compressed_vector<value_type> svector;
+
+const double word = sizeof(value_type);
+const double entry = sizeof(value_type) + sizeof(std::size_t); // a sparse element: value and index
+
+inline size_t sparse_size(size_t N, double filling = 0.25) {
+    return size_t(N * filling);
+}
+
+inline size_t rect(size_t N) { // the long side of the N x 1.5N operands
+    return size_t(1.5 * N);
+}
+
+template <typename V>
+void vinit(V& v) {
+    for(size_t i = 0; i < v.size(); ++i)
+        v(i) = udistribution(generator);
+}
+
+template <typename M>
+void minit(M& m) {
+    for(size_t i = 0; i < m.size1(); ++i)
+        for(size_t j = 0; j < m.size2(); ++j)
+            m(i, j) = udistribution(generator);
+}
+
+// Fills the leading filling * N square, like sminit of the per kernel benchmarks
+template <typename M>
+void sminit(M& m, double filling = 0.25) {
+    const size_t n = sparse_size(m.size1(), filling);
+    for(size_t i = 0; i < n; ++i)
+        for(size_t j = 0; j < n; ++j)
+            m(i, j) = udistribution(generator);
+}
+
+// Appends about per_row non zeros per row (column for a column major m) at random positions, in storage order
+template <typename M>
+void spinit(M& m, size_t per_row = 16) {
+    const bool column = boost::is_same<typename M::orientation_category, column_major_tag>::value;
+    const size_t major = column ? m.size2() : m.size1();
+    std::uniform_int_distribution<size_t> index(0, (column ? m.size1() : m.size2()) - 1);
+    std::vector<size_t> minor;
+    for(size_t k = 0; k < major; ++k){
+        minor.clear();
+        for(size_t r = 0; r < per_row; ++r)
+            minor.push_back(index(generator));
+        std::sort(minor.begin(), minor.end());
+        minor.erase(std::unique(minor.begin(), minor.end()), minor.end());
+        for(size_t r = 0; r < minor.size(); ++r){
+            if(column)
+                m.push_back(minor[r], k, udistribution(generator));
+            else
+                m.push_back(k, minor[r], udistribution(generator));
+        }
+    }
+}
+
+struct kernel {
+    const char* name;
+    const char* group;                      // vector, matvec, matmat, sparse, spmv or fixed
+    double (*flops)(double N);
+    double (*bytes)(double N);
+    std::function<void()> (*setup)(size_t N);
+};
+
+// Owns the operands of kernel K for as long as the returned operation is alive
+template <typename K>
+std::function<void()> make(size_t N) {
+    std::shared_ptr<K> k = std::make_shared<K>(N);
+    return [k] { (*k)(); };
+}
+
+// vector kernels
+
+struct daxpy {
+    dvector a, b; value_type c;
+    daxpy(size_t N): a(N), b(N), c(3) { vinit(a); vinit(b); }
+    void operator()() { noalias(a) += b * c; }
+};
+
+struct vecvecadd {
+    dvector a, b, c;
+    vecvecadd(size_t N): a(N), b(N), c(N) { vinit(a); vinit(b); }
+    void operator()() { noalias(c) = a + b; }
+};
+
+struct vecvecmult {
+    dvector a, b; value_type c;
+    vecvecmult(size_t N): a(N), b(N), c(0) { vinit(a); vinit(b); }
+    void operator()() { c = inner_prod(a, b); }
+};
+
+struct vecscalarmult {
+    dvector a, b; value_type c;
+    vecscalarmult(size_t N): a(N), b(N), c(3) { vinit(b); }
+    void operator()() { noalias(a) = b * c; }
+};
+
+struct scale {
+    dvector a; value_type c;
+    scale(size_t N): a(N), c(3) { vinit(a); }
+    void operator()() { a *= c; }
+};
+
+// The vector updates of a conjugate gradient step, one pass each or fused into one
+struct cgupdate {
+    dvector x, p, r, q; value_type a, rr;
+    cgupdate(size_t N): x(N), p(N), r(N), q(N), a(3), rr(0) { vinit(x); vinit(p); vinit(r); vinit(q); }
+    void operator()() { noalias(x) += a * p; noalias(r) -= a * q; rr = inner_prod(r, r); }
+};
+
+struct fusedcgupdate: cgupdate {
+    fusedcgupdate(size_t N): cgupdate(N) {}
+    void operator()() { fused_update(update_plus_assign(x, a * p), update_minus_assign(r, a * q), update_inner_prod(rr, r, r)); }
+};
+
+// dense matrix vector kernels
+
+template <typename M>
+struct dmatvecmult {
+    M A; dvector b, c;
+    dmatvecmult(size_t N): A(N, N), b(N), c(N) { minit(A); vinit(b); }
+    void operator()() { noalias(c) = prod(A, b); }
+};
+
+struct gemv1 {
+    rmatrix A; dvector a, b; value_type c, d;
+    gemv1(size_t N): A(N, N), a(N), b(N), c(3), d(5) { minit(A); vinit(a); vinit(b); }
+    void operator()() { b = c * prod(A, a) + d * b; }
+};
+
+struct gemv2 {
+    rmatrix A; dvector a, b; value_type c, d;
+    gemv2(size_t N): A(N, N), a(N), b(N), c(3), d(5) { minit(A); vinit(a); vinit(b); }
+    void operator()() { b = c * prod(trans(A), a) + d * b; }
+};
+
+struct ger1 {
+    rmatrix A; dvector a, b; value_type c;
+    ger1(size_t N): A(N, N), a(N), b(N), c(3) { minit(A); vinit(a); vinit(b); }
+    void operator()() { A = c * outer_prod(a, b) + A; }
+};
+
+struct syr {
+    rmatrix A; dvector a, b; value_type c;
+    syr(size_t N): A(N, N), a(N), b(N), c(3) { minit(A); vinit(a); vinit(b); }
+    void operator()() { A = c * outer_prod(a, b) + c * outer_prod(b, a) + A; }
+};
+
+struct trmv1 {
+    rmatrix A; dvector a;
+    trmv1(size_t N): A(N, N), a(N) { minit(A); vinit(a); }
+    void operator()() { a = prod(A, a); }
+};
+
+struct trmv2 {
+    rmatrix A; dvector a;
+    trmv2(size_t N): A(N, N), a(N) { minit(A); vinit(a); }
+    void operator()() { a = prod(trans(A), a); }
+};
+
+// The triangular product through blas_2 on a packed lower triangle
+struct packedtrmv {
+    triangular_matrix<value_type, lower> A; dvector a;
+    packedtrmv(size_t N): A(N, N), a(N) {
+        for(size_t i = 0; i < N; ++i)
+            for(size_t j = 0; j <= i; ++j)
+                A(i, j) = udistribution(generator);
+        vinit(a);
+    }
+    void operator()() { blas_2::tmv(a, A); }
+};
+
+struct dmatdmatadd {
+    rmatrix a, b, c;
+    dmatdmatadd(size_t N): a(N, N), b(N, N), c(N, N) { minit(a); minit(b); }
+    void operator()() { noalias(c) = a + b; }
+};
+
+// STREAM triad over matrices whose storage comes from allocator A. The std::allocator matrices are
+// first touched by the thread initialising them, so all their pages end up on the node of that thread.
+template <typename A>
+struct streamtriad {
+    typedef matrix<value_type, row_major, unbounded_array<value_type, A> > stream_matrix;
+    stream_matrix a, b, c; value_type s;
+    streamtriad(size_t N): a(N, N), b(N, N), c(N, N), s(3) { minit(b); minit(c); }
+    void operator()() { noalias(a) = b + c * s; }
+};
+
+struct dmatscalarmult {
+    rmatrix a, b; value_type c;
+    dmatscalarmult(size_t N): a(N, N), b(N, N), c(3) { minit(b); }
+    void operator()() { noalias(a) = b * c; }
+};
+
+// dense matrix matrix kernels
+
+template <typename M>
+struct dmatdmatmult {
+    M A, B, C;
+    dmatdmatmult(size_t N): A(N, N), B(N, N), C(N, N) { minit(A); minit(B); }
+    void operator()() { noalias(C) = prod(A, B); }
+};
+
+struct symm1 {
+    rmatrix A, B, C; value_type c;
+    symm1(size_t N): A(N, N), B(N, N), C(N, N), c(3) { minit(A); minit(B); minit(C); }
+    void operator()() { C = c * prod(A, B) + c * C; }
+};
+
+struct symm1rect {
+    rmatrix A, B, C; value_type c;
+    symm1rect(size_t N): A(N, rect(N)), B(N, rect(N)), C(N, N), c(3) { minit(A); minit(B); minit(C); }
+    void operator()() { C = c * prod(A, trans(B)) + c * C; }
+};
+
+struct symm2 {
+    rmatrix A, B, C; value_type c;
+    symm2(size_t N): A(N, N), B(N, N), C(N, N), c(3) { minit(A); minit(B); minit(C); }
+    void operator()() { C = c * prod(trans(A), B) + c * C; }
+};
+
+struct syr2k {
+    rmatrix A, B, C; value_type c, b;
+    syr2k(size_t N): A(N, N), B(N, N), C(N, N), c(3), b(5) { minit(A); minit(B); minit(C); }
+    void operator()() { C = c * prod(B, trans(A)) + c * prod(A, trans(B)) + b * C; }
+};
+
+struct syr2krect {
+    rmatrix A, B, C; value_type c, b;
+    syr2krect(size_t N): A(N, rect(N)), B(N, rect(N)), C(N, N), c(3), b(5) { minit(A); minit(B); minit(C); }
+    void operator()() {
+        C *= b;
+        C += c * prod(A, trans(B));
+        C += c * prod(B, trans(A));
+    }
+};
+
+struct syrk {
+    rmatrix A, C; value_type c;
+    syrk(size_t N): A(N, N), C(N, N), c(3) { minit(A); }
+    void operator()() { noalias(C) = c * prod(A, trans(A)); }
+};
+
+struct syrkrect {
+    rmatrix A, C;
+    syrkrect(size_t N): A(N, rect(N)), C(N, N) { minit(A); }
+    void operator()() { noalias(C) = prod(A, trans(A)); }
+};
+
+// Triangular solve with N right hand sides through blas_3, made well conditioned by a heavy diagonal,
+// the copy of B into X is part of the timing
+struct packedtrsm {
+    triangular_matrix<value_type, lower> A; rmatrix B, X;
+    packedtrsm(size_t N): A(N, N), B(N, N), X(N, N) {
+        for(size_t i = 0; i < N; ++i)
+            for(size_t j = 0; j <= i; ++j)
+                A(i, j) = i == j ? 10.0 * N : udistribution(generator);
+        minit(B);
+    }
+    void operator()() {
+        X = B;
+        blas_3::tsm(X, value_type(1), A, lower_tag());
+    }
+};
+
+// The same products with a packed symmetric operand or result, through blas_3
+
+typedef symmetric_matrix<value_type> pmatrix;
+
+struct packedsymm {
+    pmatrix S; rmatrix B, C; value_type c;
+    packedsymm(size_t N): S(N, N), B(N, N), C(N, N), c(3) { minit(S); minit(B); minit(C); }
+    void operator()() { blas_3::gmm(C, c, c, S, B); }
+};
+
+struct packedsyrk {
+    pmatrix C; rmatrix A; value_type c;
+    packedsyrk(size_t N): C(N, N), A(N, N), c(3) { minit(A); }
+    void operator()() { blas_3::srk(C, value_type(0), c, A); }
+};
+
+struct packedsyr2k {
+    pmatrix C; rmatrix A, B; value_type c, b;
+    packedsyr2k(size_t N): C(N, N), A(N, N), B(N, N), c(3), b(5) { minit(A); minit(B); minit(C); }
+    void operator()() { blas_3::sr2k(C, b, c, A, B); }
+};
+
+struct nestedprod {
+    rmatrix A, B, C, D, E, F;
+    nestedprod(size_t N): A(N, N), B(N, N), C(N, N), D(N, N), E(N, N), F(N, N) { minit(B); minit(C); minit(D); minit(E); minit(F); }
+    void operator()() { noalias(A) = prod( B, rmatrix( prod( C, rmatrix( prod( D, rmatrix( prod( E, F) ) ) ) ) ) ); }
+};
+
+// LU factorizations, the copy of A into LU is part of the timing
+
+enum lu_variant { unblocked_lu, blocked_lu, parallel_lu };
+
+template <lu_variant Variant>
+struct lufactorize {
+    rmatrix A, LU; permutation_matrix<size_t> pm;
+    lufactorize(size_t N): A(N, N), LU(N, N), pm(N) { minit(A); }
+    void operator()() {
+        LU = A;
+        for(size_t i = 0; i < pm.size(); ++i)
+            pm(i) = i;
+        if(Variant == parallel_lu)
+            parallel_lu_factorize(LU, pm);
+        else if(Variant == blocked_lu)
+            block_lu_factorize(LU, pm);
+        else
+            lu_factorize(LU, pm);
+    }
+};
+
+// Cholesky and L D L^T factorizations of a packed symmetric matrix, made positive definite by diagonal
+// dominance, the copy of A into F is part of the timing
+
+template <bool LDLT>
+struct symfactorize {
+    symmetric_matrix<value_type> A, F;
+    symfactorize(size_t N): A(N, N), F(N, N) {
+        for(size_t i = 0; i < N; ++i)
+            for(size_t j = 0; j <= i; ++j)
+                A(i, j) = i == j ? 10.0 * N : udistribution(generator);
+    }
+    void operator()() {
+        F = A;
+        if(LDLT)
+            ldlt_factorize(F);
+        else
+            cholesky_factorize(F);
+    }
+};
+
+// Products and solves with a banded matrix of L lower and U upper diagonals, diagonally dominant for the solves,
+// the copy of A into F is part of the timing of the solves
+
+template <typename M>
+void binit(M& m) {
+    for(size_t i = 0; i < m.size1(); ++i)
+        for(size_t j = i > m.lower() ? i - m.lower() : 0; j < std::min(m.size2(), i + m.upper() + 1); ++j)
+            m(i, j) = i == j ? 10.0 : udistribution(generator);
+}
+
+template <size_t L, size_t U>
+struct bandedmv {
+    banded_matrix<value_type> A; dvector b, c;
+    bandedmv(size_t N): A(N, N, L, U), b(N), c(N) { binit(A); vinit(b); }
+    void operator()() { axpy_prod(A, b, c, true); }
+};
+
+template <size_t L, size_t U>
+struct bandedsolve {
+    banded_matrix<value_type> A, F; permutation_matrix<size_t> pm; dvector b;
+    bandedsolve(size_t N): A(N, N, L, U), pm(N), b(N) { binit(A); vinit(b); }
+    void operator()() {
+        F = A;
+        for(size_t i = 0; i < pm.size(); ++i)
+            pm(i) = i;
+        lu_factorize(F, pm);
+        lu_substitute(F, pm, b);
+    }
+};
+
+// The tridiagonal solve without pivoting, by the Thomas algorithm
+struct tridiagonalsolve {
+    banded_matrix<value_type> A, F; dvector b;
+    tridiagonalsolve(size_t N): A(N, N, 1, 1), b(N) { binit(A); vinit(b); }
+    void operator()() {
+        F = A;
+        lu_factorize(F);
+        lu_substitute(static_cast<const banded_matrix<value_type>&>(F), b);
+    }
+};
+
+// sparse kernels
+
+struct smatsmatadd {
+    smatrix a, b, c;
+    smatsmatadd(size_t N): a(N, N), b(N, N), c(N, N) { sminit(a); sminit(b); }
+    void operator()() { // a + b of two compressed matrices does not compile yet, the same work in two steps
+        noalias(c) = a;
+        noalias(c) += b;
+    }
+};
+
+struct smatsmatmult {
+    smatrix a, b, c;
+    smatsmatmult(size_t N): a(N, N), b(N, N), c(N, N) { sminit(a); sminit(b); }
+    void operator()() { noalias(c) = prod(a, b); }
+};
+
+struct smatvecmult {
+    smatrix a; dvector b, c;
+    smatvecmult(size_t N): a(N, N), b(N), c(N) { sminit(a); vinit(b); }
+    void operator()() { noalias(c) = prod(a, b); }
+};
+
+struct smatsvecmult {
+    smatrix a; svector b, c;
+    smatsvecmult(size_t N): a(N, N), b(N), c(N) { sminit(a); vinit(b); }
+    void operator()() { noalias(c) = prod(a, b); }
+};
+
+// CSR assembly from the shuffled triplets of the leading square filled by sminit
+struct smatbuild {
+    smatrix a; std::vector<size_t> i, j; std::vector<value_type> t;
+    smatbuild(size_t N): a(N, N) {
+        const size_t n = sparse_size(N);
+        std::vector<size_t> order(n * n);
+        for(size_t k = 0; k < order.size(); ++k)
+            order[k] = k;
+        std::shuffle(order.begin(), order.end(), generator);
+        for(size_t k = 0; k < order.size(); ++k) {
+            i.push_back(order[k] / n);
+            j.push_back(order[k] % n);
+            t.push_back(udistribution(generator));
+        }
+    }
+    void operator()() { build_compressed(a, a.size1(), a.size2(), t.size(), i.begin(), j.begin(), t.begin()); }
+};
+
+// Gustavson SpGEMM of two matrices with about 16 non zeros per row
+struct spgemm {
+    smatrix a, b, c;
+    spgemm(size_t N): a(N, N), b(N, N), c(N, N) { spinit(a); spinit(b); }
+    void operator()() { sparse_prod(a, b, c); }
+};
+
+// The parallel axpy_prod of CSR and CSC matrices with about 16 non zeros per row
+template <typename L>
+struct spmv {
+    compressed_matrix<value_type, L> a; dvector b, c;
+    spmv(size_t N): a(N, N), b(N), c(N) { spinit(a); vinit(b); }
+    void operator()() { axpy_prod(a, b, c, true); }
+};
+
+// A matrix of 3 x 3 blocks, 6 per block row, in BCSR storage or in the CSR storage of the same elements
+template <typename M>
+struct bcsrspmv {
+    M a; dvector b, c;
+    bcsrspmv(size_t N): a(blocks(N)), b(N), c(N) { vinit(b); }
+    void operator()() { axpy_prod(a, b, c, true); }
+
+    static smatrix blocks(size_t N) {
+        smatrix m(N, N);
+        const size_t n = (N + 2) / 3;
+        std::uniform_int_distribution<size_t> index(0, n - 1);
+        std::vector<size_t> columns;
+        for(size_t bi = 0; bi < n; ++bi){
+            columns.assign(1, bi);
+            for(size_t r = 0; r < 5; ++r)
+                columns.push_back(index(generator));
+            std::sort(columns.begin(), columns.end());
+            columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+            for(size_t i = 3 * bi; i < std::min(3 * bi + 3, N); ++i)
+                for(size_t k = 0; k < columns.size(); ++k)
+                    for(size_t j = 3 * columns[k]; j < std::min(3 * columns[k] + 3, N); ++j)
+                        m.push_back(i, j, udistribution(generator));
+        }
+        return m;
+    }
+};
+
+// small fixed size kernels, over a batch of N matrices made invertible by a heavy diagonal
+
+template <typename M>
+void finit(M& m) {
+    for(size_t i = 0; i < m.size1(); ++i)
+        for(size_t j = 0; j < m.size2(); ++j)
+            m(i, j) = udistribution(generator) + (i == j ? 50.0 : 0.0);
+}
+
+template <size_t S>
+struct fixedbatch {
+    typedef fixed_matrix<value_type, S, S> fmatrix;
+    std::vector<fmatrix> a, b, c; value_type d;
+    fixedbatch(size_t N): a(N), b(N), c(N), d(0) {
+        for(size_t k = 0; k < N; ++k){
+            finit(a[k]); finit(b[k]);
+        }
+    }
+};
+
+template <size_t S>
+struct fixedmult: fixedbatch<S> {
+    fixedmult(size_t N): fixedbatch<S>(N) {}
+    void operator()() {
+        for(size_t k = 0; k < this->a.size(); ++k)
+            this->c[k] = this->a[k] * this->b[k];
+    }
+};
+
+template <size_t S>
+struct fixedsum: fixedbatch<S> {
+    fixedsum(size_t N): fixedbatch<S>(N) {}
+    void operator()() {
+        for(size_t k = 0; k < this->a.size(); ++k)
+            this->c[k] = this->a[k] + this->b[k];
+    }
+};
+
+template <size_t S>
+struct fixeddet: fixedbatch<S> {
+    fixeddet(size_t N): fixedbatch<S>(N) {}
+    void operator()() {
+        for(size_t k = 0; k < this->a.size(); ++k)
+            this->d += det(this->a[k]);
+    }
+};
+
+template <size_t S>
+struct fixedinverse: fixedbatch<S> {
+    fixedinverse(size_t N): fixedbatch<S>(N) {}
+    void operator()() {
+        for(size_t k = 0; k < this->a.size(); ++k)
+            invert(this->a[k], this->c[k]);
+    }
+};
+
+inline double fixed(double N, double S) { // the elements of a batch of N S x S matrices
+    return N * S * S;
+}
+
+inline double nnz(double N) { // elements of the leading square filled by sminit
+    const double n = double(sparse_size(size_t(N)));
+    return n * n;
+}
+
+const kernel kernels[] = {
+    { "daxpy", "vector",
+      [](double N) { return 2 * N; },
+      [](double N) { return 3 * N * word; }, make<daxpy> },
+    { "vecvecadd", "vector",
+      [](double N) { return N; },
+      [](double N) { return 3 * N * word; }, make<vecvecadd> },
+    { "vecvecmult", "vector",
+      [](double N) { return 2 * N; },
+      [](double N) { return 2 * N * word; }, make<vecvecmult> },
+    { "dotproduct", "vector",
+      [](double N) { return 2 * N; },
+      [](double N) { return 2 * N * word; }, make<vecvecmult> },
+    { "vecscalarmult", "vector",
+      [](double N) { return N; },
+      [](double N) { return 2 * N * word; }, make<vecscalarmult> },
+    { "scale", "vector",
+      [](double N) { return N; },
+      [](double N) { return 2 * N * word; }, make<scale> },
+    { "cgupdate", "vector",
+      [](double N) { return 6 * N; },
+      [](double N) { return 7 * N * word; }, make<cgupdate> },
+    { "fusedcgupdate", "vector",
+      [](double N) { return 6 * N; },
+      [](double N) { return 6 * N * word; }, make<fusedcgupdate> },
+
+    { "dmatvecmult", "matvec",
+      [](double N) { return 2 * N * N - N; },
+      [](double N) { return (N * N + 2 * N) * word; }, make<dmatvecmult<rmatrix> > },
+    { "rmajordmvmult", "matvec",
+      [](double N) { return 2 * N * N - N; },
+      [](double N) { return (N * N + 2 * N) * word; }, make<dmatvecmult<rmatrix> > },
+    { "cmajordmvmult", "matvec",
+      [](double N) { return 2 * N * N - N; },
+      [](double N) { return (N * N + 2 * N) * word; }, make<dmatvecmult<cmatrix> > },
+    { "gemv1", "matvec",
+      [](double N) { return 2 * N * N + N; },
+      [](double N) { return (N * N + 3 * N) * word; }, make<gemv1> },
+    { "gemv2", "matvec",
+      [](double N) { return 2 * N * N + N; },
+      [](double N) { return (N * N + 3 * N) * word; }, make<gemv2> },
+    { "ger1", "matvec",
+      [](double N) { return 2 * N * N; },
+      [](double N) { return (2 * N * N + 2 * N) * word; }, make<ger1> },
+    { "syr", "matvec",
+      [](double N) { return 3 * N * N; },
+      [](double N) { return (2 * N * N + 2 * N) * word; }, make<syr> },
+    { "trmv1", "matvec",
+      [](double N) { return 2 * N * N - N; },
+      [](double N) { return (N * N + 2 * N) * word; }, make<trmv1> },
+    { "trmv2", "matvec",
+      [](double N) { return 2 * N * N - N; },
+      [](double N) { return (N * N + 2 * N) * word; }, make<trmv2> },
+    { "packedtrmv", "matvec",
+      [](double N) { return N * N; },
+      [](double N) { return (0.5 * N * N + 2 * N) * word; }, make<packedtrmv> },
+    { "dmatdmatadd", "matvec",
+      [](double N) { return N * N; },
+      [](double N) { return 3 * N * N * word; }, make<dmatdmatadd> },
+    { "dmatscalarmult", "matvec",
+      [](double N) { return N * N; },
+      [](double N) { return 2 * N * N * word; }, make<dmatscalarmult> },
+
+    { "streamtriad", "matvec",
+      [](double N) { return 2 * N * N; },
+      [](double N) { return 3 * N * N * word; }, make<streamtriad<std::allocator<value_type> > > },
+    { "firsttouchstreamtriad", "matvec",
+      [](double N) { return 2 * N * N; },
+      [](double N) { return 3 * N * N * word; }, make<streamtriad<numa_allocator<value_type, numa_first_touch_tag> > > },
+    { "interleavedstreamtriad", "matvec",
+      [](double N) { return 2 * N * N; },
+      [](double N) { return 3 * N * N * word; }, make<streamtriad<numa_allocator<value_type, numa_interleave_tag> > > },
+
+    { "dmatdmatmult", "matmat",
+      [](double N) { return 2 * N * N * N - N * N; },
+      [](double N) { return 3 * N * N * word; }, make<dmatdmatmult<rmatrix> > },
+    { "rmajordmdmmult", "matmat",
+      [](double N) { return 2 * N * N * N - N * N; },
+      [](double N) { return 3 * N * N * word; }, make<dmatdmatmult<rmatrix> > },
+    { "cmajordmdmmult", "matmat",
+      [](double N) { return 2 * N * N * N - N * N; },
+      [](double N) { return 3 * N * N * word; }, make<dmatdmatmult<cmatrix> > },
+    { "symm1", "matmat",
+      [](double N) { return 2 * N * N * N + 2 * N * N; },
+      [](double N) { return 4 * N * N * word; }, make<symm1> },
+    { "symm1rect", "matmat",
+      [](double N) { return 2 * N * N * (1.5 * N - 1) + 2 * N * N; },
+      [](double N) { return (3 * N * N + 2 * N * N) * word; }, make<symm1rect> },
+    { "symm2", "matmat",
+      [](double N) { return 2 * N * N * N + 2 * N * N; },
+      [](double N) { return 4 * N * N * word; }, make<symm2> },
+    { "syr2k", "matmat",
+      [](double N) { return 4 * N * N * N + 3 * N * N; },
+      [](double N) { return 4 * N * N * word; }, make<syr2k> },
+    { "syr2krect", "matmat",
+      [](double N) { return 4 * N * N * (1.5 * N - 1) + 2 * N * N; },
+      [](double N) { return (3 * N * N + 2 * N * N) * word; }, make<syr2krect> },
+    { "syrk", "matmat",
+      [](double N) { return 2 * N * N * N; },
+      [](double N) { return 2 * N * N * word; }, make<syrk> },
+    { "syrkrect", "matmat",
+      [](double N) { return 2 * N * N * (1.5 * N - 1) + N * N; },
+      [](double N) { return (1.5 * N * N + N * N) * word; }, make<syrkrect> },
+    { "packedtrsm", "matmat",
+      [](double N) { return N * N * N; },
+      [](double N) { return 2.5 * N * N * word; }, make<packedtrsm> },
+    { "packedsymm", "matmat",
+      [](double N) { return 2 * N * N * N + 2 * N * N; },
+      [](double N) { return 3.5 * N * N * word; }, make<packedsymm> },
+    { "packedsyrk", "matmat",
+      [](double N) { return N * N * (N + 1); },
+      [](double N) { return 1.5 * N * N * word; }, make<packedsyrk> },
+    { "packedsyr2k", "matmat",
+      [](double N) { return 2 * N * N * (N + 1) + 1.5 * N * N; },
+      [](double N) { return 3 * N * N * word; }, make<packedsyr2k> },
+    { "nestedprod", "matmat",
+      [](double N) { return 4 * (2 * N * N * N - N * N); },
+      [](double N) { return 6 * N * N * word; }, make<nestedprod> },
+    { "lufactorize", "matmat",
+      [](double N) { return 2 * N * N * N / 3; },
+      [](double N) { return 2 * N * N * word; }, make<lufactorize<unblocked_lu> > },
+    { "blocklufactorize", "matmat",
+      [](double N) { return 2 * N * N * N / 3; },
+      [](double N) { return 2 * N * N * word; }, make<lufactorize<blocked_lu> > },
+    { "parallellufactorize", "matmat",
+      [](double N) { return 2 * N * N * N / 3; },
+      [](double N) { return 2 * N * N * word; }, make<lufactorize<parallel_lu> > },
+    { "choleskyfactorize", "matmat",
+      [](double N) { return N * N * N / 3; },
+      [](double N) { return N * N * word; }, make<symfactorize<false> > },
+    { "ldltfactorize", "matmat",
+      [](double N) { return N * N * N / 3; },
+      [](double N) { return N * N * word; }, make<symfactorize<true> > },
+
+    { "bandedmv", "vector",
+      [](double N) { return 2 * 5 * N; },
+      [](double N) { return 7 * N * word; }, make<bandedmv<2, 2> > },
+    { "bandedsolve", "vector",
+      [](double N) { return 31 * N; },
+      [](double N) { return 14 * N * word; }, make<bandedsolve<2, 2> > },
+    { "tridiagonalsolve", "vector",
+      [](double N) { return 8 * N; },
+      [](double N) { return 8 * N * word; }, make<tridiagonalsolve> },
+
+    { "smatsmatadd", "sparse",
+      [](double N) { return nnz(N); },
+      [](double N) { return 3 * nnz(N) * entry; }, make<smatsmatadd> },
+    { "smatsmatmult", "sparse",
+      [](double N) { return 2 * nnz(N) * double(sparse_size(size_t(N))); },
+      [](double N) { return 3 * nnz(N) * entry; }, make<smatsmatmult> },
+    { "smatvecmult", "sparse",
+      [](double N) { return 2 * nnz(N); },
+      [](double N) { return nnz(N) * entry + 2 * N * word; }, make<smatvecmult> },
+    { "smatsvecmult", "sparse",
+      [](double N) { return 2 * nnz(N); },
+      [](double N) { return nnz(N) * entry + (N + double(sparse_size(size_t(N)))) * entry; }, make<smatsvecmult> },
+    { "smatbuild", "sparse",
+      [](double N) { return nnz(N); },
+      [](double N) { return nnz(N) * (entry + sizeof(size_t)) + nnz(N) * entry; }, make<smatbuild> },
+    { "spgemm", "sparse",
+      [](double N) { return 2 * 16 * 16 * N; },
+      [](double N) { return (2 * 16 * N + std::min(16 * 16.0, N) * N) * entry; }, make<spgemm> },
+
+    { "csrspmv", "spmv",
+      [](double N) { return 2 * 16 * N; },
+      [](double N) { return 16 * N * entry + 2 * N * word; }, make<spmv<row_major> > },
+    { "cscspmv", "spmv",
+      [](double N) { return 2 * 16 * N; },
+      [](double N) { return 16 * N * entry + 2 * N * word; }, make<spmv<column_major> > },
+    { "bcsrspmv", "spmv",
+      [](double N) { return 2 * 18 * N; },
+      [](double N) { return 18 * N * word + 2 * N * sizeof(size_t) + 2 * N * word; }, make<bcsrspmv<block_compressed_matrix<value_type, 3, 3> > > },
+    { "bcsrcsrspmv", "spmv",
+      [](double N) { return 2 * 18 * N; },
+      [](double N) { return 18 * N * entry + 2 * N * word; }, make<bcsrspmv<smatrix> > },
+
+    { "fixedmult3", "fixed",
+      [](double N) { return N * (2 * 27 - 9); },
+      [](double N) { return 3 * fixed(N, 3) * word; }, make<fixedmult<3> > },
+    { "fixedmult4", "fixed",
+      [](double N) { return N * (2 * 64 - 16); },
+      [](double N) { return 3 * fixed(N, 4) * word; }, make<fixedmult<4> > },
+    { "fixedmult6", "fixed",
+      [](double N) { return N * (2 * 216 - 36); },
+      [](double N) { return 3 * fixed(N, 6) * word; }, make<fixedmult<6> > },
+    { "fixedsum4", "fixed",
+      [](double N) { return fixed(N, 4); },
+      [](double N) { return 3 * fixed(N, 4) * word; }, make<fixedsum<4> > },
+    { "fixeddet", "fixed",
+      [](double N) { return 45 * N; },
+      [](double N) { return fixed(N, 4) * word; }, make<fixeddet<4> > },
+    { "fixedinverse", "fixed",
+      [](double N) { return 144 * N; },
+      [](double N) { return 2 * fixed(N, 4) * word; }, make<fixedinverse<4> > },
+};
+
+const size_t kernel_count = sizeof(kernels) / sizeof(kernels[0]);
+
+// Default size sweep of a group: first, last and geometric factor
+inline void default_sweep(const std::string& group, size_t& first, size_t& last, size_t& factor) {
+    factor = 2;
+    if(group == "vector"){
+        first = 1000; last = 4096000; factor = 4;
+    }
+    else if(group == "matvec"){
+        first = 64; last = 4096;
+    }
+    else if(group == "matmat"){
+        first = 32; last = 1024;
+    }
+    else if(group == "spmv"){
+        first = 1000; last = 1024000; factor = 4;
+    }
+    else if(group == "fixed"){
+        first = 1000; last = 256000; factor = 4;
+    }
+    else{
+        first = 128; last = 2048;
+    }
+}
+
+}
@@ -0,0 +1,119 @@
+/*
+ Measurement utilities of the benchmark harness
+
+ A kernel is timed by calling it repeatedly until the median of the samples is known precisely enough:
+ 1. a few untimed warm-up calls (page faults, lazy allocations, branch predictors),
+ 2. before every timed call the caches are flushed by streaming through a buffer larger than the last level cache,
+ 3. after at least min_reps samples the run stops as soon as the 95% confidence interval of the median,
+    taken from the order statistics of the samples, is within +-tolerance of the median,
+    or when max_reps samples or max_time seconds are reached.
+*/
+
+typedef double value_type;
+
+// define a random generator for randomly initializing matrices and vectors
+std::mt19937 generator( std::chrono::system_clock::now().time_since_epoch().count() );
+std::normal_distribution<double> ndistribution(0.0, 10.0);
+std::uniform_real_distribution<double> udistribution(0.0, 10.0);
+
+struct measure_options {
+    size_t warmup;
+    size_t min_reps;
+    size_t max_reps;
+    double tolerance;   // relative half width of the confidence interval of the median
+    double max_time;    // seconds spent timing one kernel at one size
+    bool flush;
+    size_t flush_bytes;
+
+    measure_options():
+        warmup(2), min_reps(10), max_reps(1000), tolerance(0.01), max_time(2.0), flush(true), flush_bytes(64 << 20) {}
+};
+
+struct measurement {
+    size_t reps;
+    double median;      // all in seconds
+    double ci_low;
+    double ci_high;
+    double min;
+    bool stable;        // whether the confidence interval reached the tolerance
+};
+
+// Evicts the data of the previous call from the caches by writing a buffer larger than the last level cache
+class cache_flusher {
+public:
+    explicit cache_flusher(size_t bytes): buffer_(bytes, 0), sink_(0) {}
+
+    void operator()() {
+        for(size_t i = 0; i < buffer_.size(); i += 64){ // one touch per cache line
+            buffer_[i] += 1;
+            sink_ += buffer_[i];
+        }
+    }
+
+private:
+    std::vector<unsigned char> buffer_;
+    volatile unsigned sink_; // volatile, so that the flush cannot be optimized away
+};
+
+// Ranks (0 based) of the order statistics bounding the 95% confidence interval of the median of n samples,
+// from the normal approximation of the binomial distribution
+inline void median_interval(size_t n, size_t& low, size_t& high) {
+
+    const double z = 1.96;
+    const double half = z * std::sqrt(double(n)) / 2.0;
+    const double lo = std::floor(n / 2.0 - half);       // 1 based rank
+    const double hi = std::ceil(1.0 + n / 2.0 + half);  // 1 based rank
+    low = lo < 1.0 ? 0 : size_t(lo) - 1;
+    high = hi > double(n) ? n - 1 : size_t(hi) - 1;
+}
+
+inline double median(const std::vector<double>& sorted) {
+
+    const size_t n = sorted.size();
+    return n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+}
+
+template <typename F>
+measurement measure(F& kernel, const measure_options& options, cache_flusher& flusher) {
+
+    for(size_t i = 0; i < options.warmup; ++i)
+        kernel();
+
+    std::vector<double> times, sorted;
+    measurement m;
+    m.stable = false;
+    double elapsed = 0;
+    while(true){
+
+        if(options.flush)
+            flusher();
+
+        auto start = std::chrono::steady_clock::now();
+        kernel();
+        auto end = std::chrono::steady_clock::now();
+
+        const double t = std::chrono::duration<double> (end - start).count();
+        times.push_back(t);
+        elapsed += t;
+
+        sorted = times;
+        std::sort(sorted.begin(), sorted.end());
+        size_t low, high;
+        median_interval(sorted.size(), low, high);
+        m.reps = sorted.size();
+        m.median = median(sorted);
+        m.ci_low = sorted[low];
+        m.ci_high = sorted[high];
+        m.min = sorted.front();
+
+        if(m.reps >= options.min_reps && m.ci_high - m.ci_low <= 2.0 * options.tolerance * m.median){
+            m.stable = true;
+            break;
+        }
+        // slow kernels: stop on the time budget, but never with fewer than 3 samples
+        if(m.reps >= options.max_reps || (m.reps >= 3 && elapsed >= options.max_time))
+            break;
+    }
+
+    return m;
+}
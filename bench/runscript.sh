@@ -16,6 +16,7 @@ opt="O0"
 flags=" -"$opt$defaultflags
 
 for d in */ ; do
+	if [ ! -f "$d/benchmarks.cpp" ]; then continue; fi # harness/ is built below
 	echo "$d"
 	cd "$d"
 	if [ ! -d "$opt" ]; then
@@ -32,6 +33,7 @@ opt="O1"
 flags=" -"$opt$defaultflags
 
 for d in */ ; do
+	if [ ! -f "$d/benchmarks.cpp" ]; then continue; fi # harness/ is built below
         echo "$d"
         cd "$d"
         if [ ! -d "$opt" ]; then
@@ -48,6 +50,7 @@ opt="O2"
 flags=" -"$opt$defaultflags
 
 for d in */ ; do
+	if [ ! -f "$d/benchmarks.cpp" ]; then continue; fi # harness/ is built below
         echo "$d"
         cd "$d"
         if [ ! -d "$opt" ]; then
@@ -64,6 +67,7 @@ opt="O3"
 flags=" -"$opt$defaultflags
 
 for d in */ ; do
+	if [ ! -f "$d/benchmarks.cpp" ]; then continue; fi # harness/ is built below
         echo "$d"
         cd "$d"
         if [ ! -d "$opt" ]; then
@@ -76,6 +80,14 @@ for d in */ ; do
         cd ..
 done
 
+# The unified harness times every uBlas kernel over a size sweep (see harness/harness.cpp) and saves
+# the results as JSON, to compare uBlas releases with each other on the same machine.
+cd harness
+g++ -O3$defaultflags -I $boostpath harness.cpp -o harness
+./harness --format json --output harness.json
+rm harness
+cd ..
+
 # Done with the benchmark runs. Now we plot the results with gnuplot.
 # First make sure when have an empty directory named results to place all the plots in.
 if [ ! -d "results" ]; then
@@ -86,12 +98,32 @@ fi
 
 # Now make the plots
 for d in */ ; do
+if [ ! -f "$d/benchmarks.cpp" ]; then continue; fi # harness/ writes JSON, not plots
 cd "$d"
 directories=( "O0" "O1" "O2" "O3" )
 for sd in "${directories[@]}" ; do
 if [ -d "$sd" ]; then
 cd "$sd"
 output="${d%?}$sd"
+# Every .dat file is one curve: those of the other libraries keep their usual titles and styles, the others,
+# written by the uBlas only benchmarks (SmallFixed, SpMV), are titled after their file names.
+series=""
+for f in *.dat ; do
+case "$f" in
+ublas.dat) title="uBlas"; style="ls 3" ;;
+blaze.dat) title="Blaze"; style="ls 4" ;;
+eigen.dat) title="Eigen"; style="ls 5" ;;
+mtl.dat) title="MTL"; style="ls 6" ;;
+clike.dat) title="Clike"; style="ls 2" ;;
+*) title="${f%.dat}"; title="${title//_/ }"; style="lw 3" ;;
+esac
+series="$series${series:+, }\"$f\" title \"$title\" w l $style"
+done
+# SpMV measures the scaling with the number of threads
+xlabel="N"
+if [ "$d" == "SpMV/" ]; then
+xlabel="threads"
+fi
 if [ -f "plot.txt" ];
 then
 rm plot.txt
@@ -116,9 +148,9 @@ set ylabel "MFLOPS"  font "Helvetica,22" offset 0.5
 set format y "%g"
 set origin 0,0.3
 set logscale x
-set xlabel "N" font "Helvetica,22"
+set xlabel "$xlabel" font "Helvetica,22"
 set xtics nomirror
-plot "ublas.dat" title "uBlas" w l ls 3, "blaze.dat" title "Blaze" w l ls 4, "eigen.dat" title "Eigen" w l ls 5, "mtl.dat" title "MTL" w l ls 6, "clike.dat" title "Clike" w l ls 2
+plot $series
 _EOF_
 gnuplot plot.txt
 rm plot.txt
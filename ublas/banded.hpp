@@ -107,6 +107,7 @@ public:
 #ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
         using matrix_container<self_type>::operator ();
 #endif
+        typedef const banded_matrix& nested_type;
         typedef typename A::size_type size_type;
         typedef typename A::difference_type difference_type;
         typedef T value_type;
@@ -1165,6 +1166,7 @@ public:
 #ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
         using matrix_expression<self_type>::operator ();
 #endif
+        typedef const banded_adaptor nested_type;
         typedef const M const_matrix_type;
         typedef M matrix_type;
         typedef typename M::size_type size_type;
@@ -11,6 +11,8 @@
 #define _BOOST_UBLAS_BLAS_
 
 #include <boost/numeric/ublas/traits.hpp>
+#include <boost/numeric/ublas/detail/symm.hpp>
+#include <boost/numeric/ublas/detail/trmm.hpp>
 
 namespace boost { namespace numeric { namespace ublas {
     
@@ -187,6 +189,30 @@ namespace boost { namespace numeric { namespace ublas {
             return v = prod (m, v);
         }
 
+        /** \brief multiply vector \c v with a packed triangular matrix \c m, in place
+     *
+     * Only the stored triangle of \c m is read, block row by block row.
+         */
+        template<class V, class T, class TRI, class L, class A>
+        V & tmv (V &v, const triangular_matrix<T, TRI, L, A> &m)
+    {
+            detail::trmm_column<V> b (v);
+            detail::triangular_multiply<TRI> (m, b);
+            return v;
+        }
+
+        /** \brief multiply vector \c v with a triangular adaptor \c m, in place
+     *
+     * Only the adapted triangle of the underlying matrix is read, block row by block row.
+         */
+        template<class V, class M, class TRI>
+        V & tmv (V &v, const triangular_adaptor<M, TRI> &m)
+    {
+            detail::trmm_column<V> b (v);
+            detail::triangular_multiply<TRI> (m, b);
+            return v;
+        }
+
         /** \brief solve \f$m.x = v\f$ in place, where \c m is a triangular matrix
      *
      * \param v a vector
@@ -204,6 +230,41 @@ namespace boost { namespace numeric { namespace ublas {
             return v = solve (m, v, C ());
         }
 
+        // Block substitution through the stored triangle of m
+        template<class TRI, class V, class M, class C>
+        V & tsv (V &v, const M &m, C, boost::mpl::true_)
+    {
+            detail::trmm_column<V> b (v);
+            detail::triangular_solve<C, TRI> (m, b);
+            return v;
+        }
+        // The other triangle, of which m only stores the diagonal
+        template<class TRI, class V, class M, class C>
+        V & tsv (V &v, const M &m, C, boost::mpl::false_)
+    {
+            return v = solve (m, v, C ());
+        }
+
+        /** \brief solve \f$m.x = v\f$ in place by block substitution, where \c m is a packed triangular matrix
+     *
+     * Unit tags ignore its diagonal. When \c C names the triangle \c m does not store, the generic solve is used.
+         */
+        template<class V, class T, class TRI, class L, class A, class C>
+        V & tsv (V &v, const triangular_matrix<T, TRI, L, A> &m, C)
+    {
+            return tsv<TRI> (v, m, C (), detail::triangular_solve_stored<C, TRI> ());
+        }
+
+        /** \brief solve \f$m.x = v\f$ in place by block substitution, where \c m is a triangular adaptor
+     *
+     * Unit tags ignore its diagonal. When \c C names the triangle \c m does not store, the generic solve is used.
+         */
+        template<class V, class M, class TRI, class C>
+        V & tsv (V &v, const triangular_adaptor<M, TRI> &m, C)
+    {
+            return tsv<TRI> (v, m, C (), detail::triangular_solve_stored<C, TRI> ());
+        }
+
         /** \brief compute \f$ v_1 = t_1.v_1 + t_2.(m.v_2)\f$, a general matrix-vector product
      *
      * \param v1 a vector
@@ -365,6 +426,38 @@ namespace boost { namespace numeric { namespace ublas {
             return m1 = t * prod (m2, m3);
         }
 
+        /** \brief triangular matrix multiplication \f$m_1=t.m_2.m_3\f$ where \f$m_2\f$ is a packed triangular matrix
+     *
+     * \c m3 is copied into \c m1, which is then multiplied in place block row by block row,
+     * the off diagonal blocks through the packed GEMM kernel.
+         */
+        template<class M1, class T, class T2, class TRI, class L, class A, class M3>
+        M1 & tmm (M1 &m1, const T &t, const triangular_matrix<T2, TRI, L, A> &m2, const M3 &m3)
+    {
+            if (static_cast<const void *> (&m1) != static_cast<const void *> (&m3))
+                m1 = m3;
+            detail::triangular_multiply<TRI> (m2, m1);
+            if (t != T (1))
+                m1 *= t;
+            return m1;
+        }
+
+        /** \brief triangular matrix multiplication \f$m_1=t.m_2.m_3\f$ where \f$m_2\f$ is a triangular adaptor
+     *
+     * \c m3 is copied into \c m1, which is then multiplied in place block row by block row,
+     * the off diagonal blocks through the packed GEMM kernel.
+         */
+        template<class M1, class T, class M, class TRI, class M3>
+        M1 & tmm (M1 &m1, const T &t, const triangular_adaptor<M, TRI> &m2, const M3 &m3)
+    {
+            if (static_cast<const void *> (&m1) != static_cast<const void *> (&m3))
+                m1 = m3;
+            detail::triangular_multiply<TRI> (m2, m1);
+            if (t != T (1))
+                m1 *= t;
+            return m1;
+        }
+
         /** \brief triangular solve \f$ m_2.x = t.m_1\f$ in place, \f$m_2\f$ is a triangular matrix
      *
      * \param m1 a matrix
@@ -384,6 +477,44 @@ namespace boost { namespace numeric { namespace ublas {
             return m1 = solve (m2, t * m1, C ());
         }
 
+        // Block substitution through the stored triangle of m2
+        template<class TRI, class M1, class T, class M2, class C>
+        M1 & tsm (M1 &m1, const T &t, const M2 &m2, C, boost::mpl::true_)
+    {
+            if (t != T (1))
+                m1 *= t;
+            detail::triangular_solve<C, TRI> (m2, m1);
+            return m1;
+        }
+        // The other triangle, of which m2 only stores the diagonal
+        template<class TRI, class M1, class T, class M2, class C>
+        M1 & tsm (M1 &m1, const T &t, const M2 &m2, C, boost::mpl::false_)
+    {
+            return m1 = solve (m2, t * m1, C ());
+        }
+
+        /** \brief triangular solve \f$ m_2.x = t.m_1\f$ in place by block substitution, \f$m_2\f$ is a packed triangular matrix
+     *
+     * All the columns of \c m1 are solved together, the off diagonal blocks through the packed GEMM kernel.
+     * Unit tags ignore its diagonal. When \c C names the triangle \c m2 does not store, the generic solve is used.
+         */
+        template<class M1, class T, class T2, class TRI, class L, class A, class C>
+        M1 & tsm (M1 &m1, const T &t, const triangular_matrix<T2, TRI, L, A> &m2, C)
+    {
+            return tsm<TRI> (m1, t, m2, C (), detail::triangular_solve_stored<C, TRI> ());
+        }
+
+        /** \brief triangular solve \f$ m_2.x = t.m_1\f$ in place by block substitution, \f$m_2\f$ is a triangular adaptor
+     *
+     * All the columns of \c m1 are solved together, the off diagonal blocks through the packed GEMM kernel.
+     * Unit tags ignore its diagonal. When \c C names the triangle \c m2 does not store, the generic solve is used.
+         */
+        template<class M1, class T, class M, class TRI, class C>
+        M1 & tsm (M1 &m1, const T &t, const triangular_adaptor<M, TRI> &m2, C)
+    {
+            return tsm<TRI> (m1, t, m2, C (), detail::triangular_solve_stored<C, TRI> ());
+        }
+
         /** \brief general matrix multiplication \f$m_1=t_1.m_1 + t_2.m_2.m_3\f$
      *
      * \param m1 first matrix
@@ -405,6 +536,28 @@ namespace boost { namespace numeric { namespace ublas {
             return m1 = t1 * m1 + t2 * prod (m2, m3);
         }
 
+        /** \brief symmetric matrix multiplication \f$m_1=t_1.m_1 + t_2.m_2.m_3\f$ where \f$m_2\f$ is a packed symmetric matrix
+     *
+     * The packed triangle of \c m2 is read directly by the packed GEMM kernel. \c m1 must provide element references.
+         */
+        template<class M1, class T1, class T2, class T, class TRI, class L, class A, class M3>
+        M1 & gmm (M1 &m1, const T1 &t1, const T2 &t2, const symmetric_matrix<T, TRI, L, A> &m2, const M3 &m3)
+    {
+            detail::symmetric_product (m1, m2, m3, T (t2), T (t1));
+            return m1;
+        }
+
+        /** \brief hermitian matrix multiplication \f$m_1=t_1.m_1 + t_2.m_2.m_3\f$ where \f$m_2\f$ is a packed hermitian matrix
+     *
+     * The packed triangle of \c m2 is read directly by the packed GEMM kernel. \c m1 must provide element references.
+         */
+        template<class M1, class T1, class T2, class T, class TRI, class L, class A, class M3>
+        M1 & gmm (M1 &m1, const T1 &t1, const T2 &t2, const hermitian_matrix<T, TRI, L, A> &m2, const M3 &m3)
+    {
+            detail::symmetric_product (m1, m2, m3, T (t2), T (t1));
+            return m1;
+        }
+
         /** \brief symmetric rank \a k update: \f$m_1=t.m_1+t_2.(m_2.m_2^T)\f$
      *
      * \param m1 first matrix
@@ -425,6 +578,17 @@ namespace boost { namespace numeric { namespace ublas {
             return m1 = t1 * m1 + t2 * prod (m2, trans (m2));
         }
 
+        /** \brief symmetric rank \a k update of a packed symmetric matrix: \f$m_1=t.m_1+t_2.(m_2.m_2^T)\f$
+     *
+     * Only the stored triangle of \c m1 is computed, block by block on its packed storage.
+         */
+        template<class T, class TRI, class L, class A, class T1, class T2, class M2>
+        symmetric_matrix<T, TRI, L, A> & srk (symmetric_matrix<T, TRI, L, A> &m1, const T1 &t1, const T2 &t2, const M2 &m2)
+    {
+            detail::symmetric_rank_update (m1, m2, T (t2), T (t1));
+            return m1;
+        }
+
         /** \brief hermitian rank \a k update: \f$m_1=t.m_1+t_2.(m_2.m2^H)\f$
      *
      * \param m1 first matrix
@@ -445,6 +609,18 @@ namespace boost { namespace numeric { namespace ublas {
             return m1 = t1 * m1 + t2 * prod (m2, herm (m2));
         }
 
+        /** \brief hermitian rank \a k update of a packed hermitian matrix: \f$m_1=t.m_1+t_2.(m_2.m_2^H)\f$
+     *
+     * Only the stored triangle of \c m1 is computed, block by block on its packed storage.
+     * \c t1 and \c t2 are expected to be real for the result to stay hermitian.
+         */
+        template<class T, class TRI, class L, class A, class T1, class T2, class M2>
+        hermitian_matrix<T, TRI, L, A> & hrk (hermitian_matrix<T, TRI, L, A> &m1, const T1 &t1, const T2 &t2, const M2 &m2)
+    {
+            detail::symmetric_rank_update (m1, m2, T (t2), T (t1));
+            return m1;
+        }
+
         /** \brief generalized symmetric rank \a k update: \f$m_1=t_1.m_1+t_2.(m_2.m3^T)+t_2.(m_3.m2^T)\f$
      *
      * \param m1 first matrix
@@ -467,6 +643,17 @@ namespace boost { namespace numeric { namespace ublas {
             return m1 = t1 * m1 + t2 * (prod (m2, trans (m3)) + prod (m3, trans (m2)));
         }
 
+        /** \brief generalized symmetric rank \a k update of a packed symmetric matrix: \f$m_1=t_1.m_1+t_2.(m_2.m3^T)+t_2.(m_3.m2^T)\f$
+     *
+     * Both products are accumulated in one pass over the stored triangle of \c m1.
+         */
+        template<class T, class TRI, class L, class A, class T1, class T2, class M2, class M3>
+        symmetric_matrix<T, TRI, L, A> & sr2k (symmetric_matrix<T, TRI, L, A> &m1, const T1 &t1, const T2 &t2, const M2 &m2, const M3 &m3)
+    {
+            detail::symmetric_rank_2k_update (m1, m2, m3, T (t2), T (t1));
+            return m1;
+        }
+
         /** \brief generalized hermitian rank \a k update: * \f$m_1=t_1.m_1+t_2.(m_2.m_3^H)+(m_3.(t_2.m_2)^H)\f$
      *
      * \param m1 first matrix
@@ -492,6 +679,17 @@ namespace boost { namespace numeric { namespace ublas {
             + type_traits<T2>::conj (t2) * prod (m3, herm (m2));
         }
 
+        /** \brief generalized hermitian rank \a k update of a packed hermitian matrix: \f$m_1=t_1.m_1+t_2.(m_2.m_3^H)+(m_3.(t_2.m_2)^H)\f$
+     *
+     * Both products are accumulated in one pass over the stored triangle of \c m1.
+         */
+        template<class T, class TRI, class L, class A, class T1, class T2, class M2, class M3>
+        hermitian_matrix<T, TRI, L, A> & hr2k (hermitian_matrix<T, TRI, L, A> &m1, const T1 &t1, const T2 &t2, const M2 &m2, const M3 &m3)
+    {
+            detail::symmetric_rank_2k_update (m1, m2, m3, T (t2), T (t1));
+            return m1;
+        }
+
     }
 
 }}}
@@ -0,0 +1,622 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_CHOLESKY_
+#define _BOOST_UBLAS_CHOLESKY_
+
+#include <algorithm>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/hermitian.hpp>
+#include <boost/numeric/ublas/banded.hpp>
+#include <boost/numeric/ublas/detail/gemm.hpp>
+#include <boost/numeric/ublas/detail/parallel.hpp>
+#include <boost/numeric/ublas/detail/band.hpp>
+
+// Cholesky (L L^T) and L D L^T factorizations of symmetric and hermitian matrices, in the spirit of LAPACK.
+// Both factor the lower triangle; the result replaces the stored triangle of the matrix, so that
+// m (i, j), i >= j, reads the factor L afterwards whichever triangle is stored.
+// For hermitian matrices the factorizations are L L^H and L D L^H.
+// Banded matrices are factored within their lower diagonals, in O (n * lower ^ 2) operations.
+
+// Width of the column panels of the blocked factorizations, and width below which a panel is factored unblocked.
+#ifndef BOOST_UBLAS_CHOLESKY_BLOCK_SIZE
+#define BOOST_UBLAS_CHOLESKY_BLOCK_SIZE 128
+#endif
+#ifndef BOOST_UBLAS_CHOLESKY_LEAF
+#define BOOST_UBLAS_CHOLESKY_LEAF 16
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+
+    namespace detail {
+
+        // Whether the factorizations of M use the conjugate transpose
+        template<class M>
+        struct cholesky_conjugate {
+            static const bool value = false;
+        };
+        template<class T, class TRI, class L, class A>
+        struct cholesky_conjugate<hermitian_matrix<T, TRI, L, A> > {
+            static const bool value = true;
+        };
+        template<class M, class TRI>
+        struct cholesky_conjugate<hermitian_adaptor<M, TRI> > {
+            static const bool value = true;
+        };
+
+        template<bool Conj, class T>
+        BOOST_UBLAS_INLINE
+        T cholesky_conj (const T &t) {
+            return Conj ? type_traits<T>::conj (t) : t;
+        }
+
+        // Element (i, j) of the (conjugate) transpose of the block of m starting at (i0, j0), as an operand of gemm
+        template<class M, bool Conj>
+        class cholesky_transpose {
+        public:
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+
+            cholesky_transpose (const M &m, size_type i0, size_type j0):
+                m_ (m), i0_ (i0), j0_ (j0) {}
+
+            BOOST_UBLAS_INLINE
+            value_type operator () (size_type i, size_type j) const {
+                return cholesky_conj<Conj> (m_ (i0_ + j, j0_ + i));
+            }
+
+        private:
+            const M &m_;
+            size_type i0_, j0_;
+        };
+
+        // c [i0, i1) x [j0, j1) -= a [i0, i1) x [k0, k1) * b [j0, j1) x [k0, k1) ^ T (^ H)
+        template<bool Conj, class M>
+        void cholesky_update (M &c, const M &a, const M &b,
+                              typename M::size_type i0, typename M::size_type i1,
+                              typename M::size_type j0, typename M::size_type j1,
+                              typename M::size_type k0, typename M::size_type k1) {
+            typedef typename M::value_type value_type;
+
+            if (i0 >= i1 || j0 >= j1 || k0 >= k1)
+                return;
+            matrix_range<M> cr (c, range (i0, i1), range (j0, j1));
+            const matrix_range<const M> ar (a, range (i0, i1), range (k0, k1));
+            const cholesky_transpose<M, Conj> bt (b, j0, k0);
+            gemm<value_type> (cr, ar, bt, i1 - i0, j1 - j0, k1 - k0, value_type (-1), value_type (1));
+        }
+
+        // Whether s can be the square of a diagonal element of the Cholesky factor
+        template<bool Conj, class T>
+        BOOST_UBLAS_INLINE
+        bool cholesky_positive (const T &s) {
+            typedef typename type_traits<T>::real_type real_type;
+            // complex symmetric matrices have no definiteness, only a zero pivot stops them
+            if (! Conj && ! boost::is_same<real_type, T>::value)
+                return s != T/*zero*/();
+            return type_traits<T>::real (s) > real_type/*zero*/();
+        }
+
+        // Left-looking Cholesky of the diagonal block [k0, k1), the columns left of k0 being already
+        // subtracted. Returns 0, or the index + 1 of the first pivot that is not positive.
+        template<bool Conj, class M>
+        typename M::size_type cholesky_block (M &w, typename M::size_type k0, typename M::size_type k1) {
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+
+            for (size_type j = k0; j < k1; ++ j) {
+                value_type s = w (j, j);
+                for (size_type p = k0; p < j; ++ p)
+                    s -= w (j, p) * cholesky_conj<Conj> (w (j, p));
+                if (! cholesky_positive<Conj> (s))
+                    return j + 1;
+                const value_type d = type_traits<value_type>::type_sqrt (s);
+                w (j, j) = d;
+                for (size_type i = j + 1; i < k1; ++ i) {
+                    value_type t = w (i, j);
+                    for (size_type p = k0; p < j; ++ p)
+                        t -= w (i, p) * cholesky_conj<Conj> (w (j, p));
+                    w (i, j) = t / d;
+                }
+            }
+            return 0;
+        }
+
+        // Left-looking L D L^T of the diagonal block [k0, k1), D on the diagonal of w.
+        // Returns 0, or the index + 1 of the first zero pivot.
+        template<bool Conj, class M>
+        typename M::size_type ldlt_block (M &w, typename M::size_type k0, typename M::size_type k1) {
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+
+            for (size_type j = k0; j < k1; ++ j) {
+                value_type d = w (j, j);
+                for (size_type p = k0; p < j; ++ p)
+                    d -= w (j, p) * w (p, p) * cholesky_conj<Conj> (w (j, p));
+                if (d == value_type/*zero*/())
+                    return j + 1;
+                w (j, j) = d;
+                for (size_type i = j + 1; i < k1; ++ i) {
+                    value_type t = w (i, j);
+                    for (size_type p = k0; p < j; ++ p)
+                        t -= w (i, p) * w (p, p) * cholesky_conj<Conj> (w (j, p));
+                    w (i, j) = t / d;
+                }
+            }
+            return 0;
+        }
+
+        // Rows [r0, r1) of w, columns [k0, k1): X = A L^-T (L^-H), L the lower triangle of w [k0, k1) x [k0, k1),
+        // with a unit diagonal if Unit. Halving the columns recursively leaves all but the small diagonal solves to GEMM.
+        template<bool Conj, bool Unit, class M>
+        void cholesky_solve_right (M &w, typename M::size_type r0, typename M::size_type r1,
+                                   typename M::size_type k0, typename M::size_type k1) {
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+
+            if (r0 >= r1)
+                return;
+            if (k1 - k0 > BOOST_UBLAS_CHOLESKY_LEAF) {
+                size_type km = k0 + (k1 - k0) / 2;
+                cholesky_solve_right<Conj, Unit> (w, r0, r1, k0, km);
+                cholesky_update<Conj> (w, w, w, r0, r1, km, k1, k0, km);
+                cholesky_solve_right<Conj, Unit> (w, r0, r1, km, k1);
+                return;
+            }
+            for (size_type i = r0; i < r1; ++ i)
+                for (size_type j = k0; j < k1; ++ j) {
+                    value_type t = w (i, j);
+                    for (size_type p = k0; p < j; ++ p)
+                        t -= w (i, p) * cholesky_conj<Conj> (w (j, p));
+                    w (i, j) = Unit ? t : t / cholesky_conj<Conj> (w (j, j));
+                }
+        }
+
+        // Rows [r0, r1) of the panel [k0, k1) below its diagonal block, in chunks of rows run in parallel
+        template<class F>
+        void cholesky_rows (std::size_t r0, std::size_t r1, std::size_t columns, const F &f) {
+            if (parallel_policy::enabled ((r1 - r0) * columns))
+                parallel_for (r0, r1, 16, f);
+            else if (r0 < r1)
+                f (r0, r1);
+        }
+
+        // Trailing update of the lower triangle of w [k1, n) x [k1, n) -= a [k1, n) x [k0, k1) * b [k1, n) x [k0, k1) ^ T (^ H),
+        // one GEMM per column block of the trailing matrix, the column blocks being run in parallel.
+        template<bool Conj, class M>
+        void cholesky_trailing_update (M &w, const M &a, const M &b, typename M::size_type k0, typename M::size_type k1) {
+            typedef typename M::size_type size_type;
+
+            const size_type n = w.size1 ();
+            const size_type nb = BOOST_UBLAS_CHOLESKY_BLOCK_SIZE;
+            const size_type blocks = (n - k1 + nb - 1) / nb;
+            // the column blocks hold fewer rows to the right, interleave them so every chunk gets some of each
+            const auto task = [&w, &a, &b, k0, k1, n, nb, blocks] (size_type begin, size_type end) {
+                for (size_type t = begin; t < end; ++ t) {
+                    const size_type c = t % 2 ? blocks - 1 - t / 2 : t / 2;
+                    const size_type j0 = k1 + c * nb;
+                    cholesky_update<Conj> (w, a, b, j0, n, j0, (std::min) (j0 + nb, n), k0, k1);
+                }
+            };
+            if (parallel_policy::enabled ((n - k1) * (n - k1)))
+                parallel_for (0, blocks, 1, task);
+            else
+                task (0, blocks);
+        }
+
+        // Blocked right-looking Cholesky of the lower triangle of the dense matrix w
+        template<bool Conj, class M>
+        typename M::size_type cholesky_dense (M &w) {
+            typedef typename M::size_type size_type;
+
+            const size_type n = w.size1 ();
+            const size_type nb = BOOST_UBLAS_CHOLESKY_BLOCK_SIZE;
+            for (size_type k0 = 0; k0 < n; k0 += nb) {
+                const size_type k1 = (std::min) (k0 + nb, n);
+                size_type info = cholesky_block<Conj> (w, k0, k1);
+                if (info != 0)
+                    return info;
+                cholesky_rows (k1, n, k1 - k0, [&w, k0, k1] (size_type begin, size_type end) {
+                    cholesky_solve_right<Conj, false> (w, begin, end, k0, k1);
+                });
+                cholesky_trailing_update<Conj> (w, w, w, k0, k1);
+            }
+            return 0;
+        }
+
+        // Blocked right-looking L D L^T of the lower triangle of the dense matrix w.
+        // The panel is first solved against the unit L of its diagonal block, which gives L D,
+        // kept aside for the trailing update, then scaled by D^-1.
+        template<bool Conj, class M>
+        typename M::size_type ldlt_dense (M &w) {
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+
+            const size_type n = w.size1 ();
+            const size_type nb = BOOST_UBLAS_CHOLESKY_BLOCK_SIZE;
+            M ld (n, (std::min) (nb, n));
+            for (size_type k0 = 0; k0 < n; k0 += nb) {
+                const size_type k1 = (std::min) (k0 + nb, n);
+                size_type info = ldlt_block<Conj> (w, k0, k1);
+                if (info != 0)
+                    return info;
+                cholesky_rows (k1, n, k1 - k0, [&w, &ld, k0, k1] (size_type begin, size_type end) {
+                    cholesky_solve_right<Conj, true> (w, begin, end, k0, k1);
+                    for (size_type i = begin; i < end; ++ i)
+                        for (size_type j = k0; j < k1; ++ j) {
+                            // ld is indexed like w, shifted left by k0
+                            ld (i, j - k0) = w (i, j);
+                            w (i, j) /= w (j, j);
+                        }
+                });
+                // w [k1, n) x [k1, n) -= (L D) L^T, ld holding L D in its columns [0, k1 - k0)
+                const size_type blocks = (n - k1 + nb - 1) / nb;
+                const auto task = [&w, &ld, k0, k1, n, nb, blocks] (size_type begin, size_type end) {
+                    for (size_type t = begin; t < end; ++ t) {
+                        const size_type c = t % 2 ? blocks - 1 - t / 2 : t / 2;
+                        const size_type j0 = k1 + c * nb;
+                        const size_type j1 = (std::min) (j0 + nb, n);
+                        matrix_range<M> cr (w, range (j0, n), range (j0, j1));
+                        const matrix_range<const M> ar (ld, range (j0, n), range (0, k1 - k0));
+                        const cholesky_transpose<M, Conj> bt (w, j0, k0);
+                        gemm<value_type> (cr, ar, bt, n - j0, j1 - j0, k1 - k0, value_type (-1), value_type (1));
+                    }
+                };
+                if (parallel_policy::enabled ((n - k1) * (n - k1)))
+                    parallel_for (0, blocks, 1, task);
+                else
+                    task (0, blocks);
+            }
+            return 0;
+        }
+
+        // Copies the lower triangle of the symmetric or hermitian m into the dense w
+        template<class M, class W>
+        void cholesky_load (const M &m, W &w) {
+            typedef typename M::size_type size_type;
+
+            const size_type n = m.size1 ();
+            for (size_type i = 0; i < n; ++ i)
+                for (size_type j = 0; j <= i; ++ j)
+                    w (i, j) = m (i, j);
+        }
+
+        // Writes the lower triangle of w back into the stored triangle of m
+        template<bool Conj, class TRI, class M, class W>
+        void cholesky_store (const W &w, M &m) {
+            typedef typename M::size_type size_type;
+
+            const size_type n = m.size1 ();
+            for (size_type i = 0; i < n; ++ i)
+                for (size_type j = 0; j <= i; ++ j) {
+                    if (TRI::other (i, j))
+                        m (i, j) = w (i, j);
+                    else
+                        m (j, i) = cholesky_conj<Conj> (w (i, j));
+                }
+        }
+
+        template<bool Conj, class TRI, class M>
+        typename M::size_type cholesky_factorize (M &m) {
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+
+            BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+            matrix<value_type> w (m.size1 (), m.size2 ());
+            cholesky_load (m, w);
+            size_type info = cholesky_dense<Conj> (w);
+            cholesky_store<Conj, TRI> (w, m);
+            return info;
+        }
+
+        template<bool Conj, class TRI, class M>
+        typename M::size_type ldlt_factorize (M &m) {
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+
+            BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+            matrix<value_type> w (m.size1 (), m.size2 ());
+            cholesky_load (m, w);
+            size_type info = ldlt_dense<Conj> (w);
+            cholesky_store<Conj, TRI> (w, m);
+            return info;
+        }
+
+        // e = L^-1 e, with a unit diagonal if Unit
+        template<bool Unit, class M, class E>
+        void cholesky_forward (const M &m, E &e, vector_tag) {
+            typedef typename M::size_type size_type;
+            typedef typename E::value_type value_type;
+
+            const size_type n = e.size ();
+            for (size_type i = 0; i < n; ++ i) {
+                value_type t = e (i);
+                for (size_type j = 0; j < i; ++ j)
+                    t -= m (i, j) * e (j);
+                e (i) = Unit ? t : t / m (i, i);
+            }
+        }
+        template<bool Unit, class M, class E>
+        void cholesky_forward (const M &m, E &e, matrix_tag) {
+            typedef typename M::size_type size_type;
+            typedef typename E::value_type value_type;
+
+            const size_type n = e.size1 ();
+            const size_type nrhs = e.size2 ();
+            for (size_type i = 0; i < n; ++ i) {
+                for (size_type j = 0; j < i; ++ j) {
+                    const value_type l = m (i, j);
+                    if (l != value_type/*zero*/())
+                        for (size_type c = 0; c < nrhs; ++ c)
+                            e (i, c) -= l * e (j, c);
+                }
+                if (! Unit) {
+                    const value_type d = m (i, i);
+                    for (size_type c = 0; c < nrhs; ++ c)
+                        e (i, c) /= d;
+                }
+            }
+        }
+
+        // e = L^-T e (L^-H e), with a unit diagonal if Unit
+        template<bool Conj, bool Unit, class M, class E>
+        void cholesky_backward (const M &m, E &e, vector_tag) {
+            typedef typename M::size_type size_type;
+            typedef typename E::value_type value_type;
+
+            const size_type n = e.size ();
+            for (size_type i = n; i -- > 0; ) {
+                if (! Unit)
+                    e (i) /= cholesky_conj<Conj> (m (i, i));
+                const value_type t = e (i);
+                for (size_type j = 0; j < i; ++ j)
+                    e (j) -= cholesky_conj<Conj> (m (i, j)) * t;
+            }
+        }
+        template<bool Conj, bool Unit, class M, class E>
+        void cholesky_backward (const M &m, E &e, matrix_tag) {
+            typedef typename M::size_type size_type;
+            typedef typename E::value_type value_type;
+
+            const size_type n = e.size1 ();
+            const size_type nrhs = e.size2 ();
+            for (size_type i = n; i -- > 0; ) {
+                if (! Unit) {
+                    const value_type d = cholesky_conj<Conj> (m (i, i));
+                    for (size_type c = 0; c < nrhs; ++ c)
+                        e (i, c) /= d;
+                }
+                for (size_type j = 0; j < i; ++ j) {
+                    const value_type l = cholesky_conj<Conj> (m (i, j));
+                    if (l != value_type/*zero*/())
+                        for (size_type c = 0; c < nrhs; ++ c)
+                            e (j, c) -= l * e (i, c);
+                }
+            }
+        }
+
+        // e = D^-1 e
+        template<class M, class E>
+        void ldlt_diagonal (const M &m, E &e, vector_tag) {
+            typedef typename M::size_type size_type;
+
+            for (size_type i = 0; i < e.size (); ++ i)
+                e (i) /= m (i, i);
+        }
+        template<class M, class E>
+        void ldlt_diagonal (const M &m, E &e, matrix_tag) {
+            typedef typename M::size_type size_type;
+
+            for (size_type i = 0; i < e.size1 (); ++ i)
+                for (size_type c = 0; c < e.size2 (); ++ c)
+                    e (i, c) /= m (i, i);
+        }
+
+
+        // Cholesky factorization of the lower diagonals of a symmetric band, along the rows as Cholesky-Banachiewicz,
+        // so that the dot products run along contiguous rows. Returns 0, or the index + 1 of the first pivot that is not positive.
+        template<class A>
+        std::size_t banded_cholesky_factorize (const A &a, std::size_t size, std::size_t lower, row_major_tag) {
+            typedef typename A::value_type value_type;
+
+            for (std::size_t i = 0; i < size; ++ i) {
+                const std::size_t p0 = i > lower ? i - lower : 0;
+                for (std::size_t k = p0; k < i; ++ k) {
+                    value_type t = a (i, k);
+                    for (std::size_t p = p0; p < k; ++ p)
+                        t -= a (i, p) * a (k, p);
+                    a (i, k) = t / a (k, k);
+                }
+                value_type s = a (i, i);
+                for (std::size_t p = p0; p < i; ++ p)
+                    s -= a (i, p) * a (i, p);
+                if (! cholesky_positive<false> (s))
+                    return i + 1;
+                a (i, i) = type_traits<value_type>::type_sqrt (s);
+            }
+            return 0;
+        }
+        // the same right looking along the columns, so that the updates run along contiguous columns
+        template<class A>
+        std::size_t banded_cholesky_factorize (const A &a, std::size_t size, std::size_t lower, column_major_tag) {
+            typedef typename A::value_type value_type;
+
+            for (std::size_t j = 0; j < size; ++ j) {
+                const value_type s = a (j, j);
+                if (! cholesky_positive<false> (s))
+                    return j + 1;
+                const value_type d = type_traits<value_type>::type_sqrt (s);
+                a (j, j) = d;
+                const std::size_t i1 = (std::min) (j + lower + 1, size);
+                for (std::size_t i = j + 1; i < i1; ++ i)
+                    a (i, j) /= d;
+                for (std::size_t k = j + 1; k < i1; ++ k) {
+                    const value_type t = a (k, j);
+                    for (std::size_t i = k; i < i1; ++ i)
+                        a (i, k) -= a (i, j) * t;
+                }
+            }
+            return 0;
+        }
+
+        // e = L^-T L^-1 e for the band factor L of banded_cholesky_factorize, reading L by rows
+        template<class A, class E>
+        void banded_cholesky_substitute (const A &a, std::size_t size, std::size_t lower, E &e, vector_tag) {
+            typedef typename E::value_type value_type;
+
+            for (std::size_t i = 0; i < size; ++ i) {
+                value_type t = e (i);
+                for (std::size_t p = i > lower ? i - lower : 0; p < i; ++ p)
+                    t -= a (i, p) * e (p);
+                e (i) = t / a (i, i);
+            }
+            for (std::size_t i = size; i -- > 0; ) {
+                e (i) /= a (i, i);
+                const value_type t = e (i);
+                for (std::size_t p = i > lower ? i - lower : 0; p < i; ++ p)
+                    e (p) -= a (i, p) * t;
+            }
+        }
+        template<class A, class E>
+        void banded_cholesky_substitute (const A &a, std::size_t size, std::size_t lower, E &e, matrix_tag) {
+            typedef typename E::value_type value_type;
+
+            const std::size_t nrhs = e.size2 ();
+            for (std::size_t i = 0; i < size; ++ i) {
+                for (std::size_t p = i > lower ? i - lower : 0; p < i; ++ p) {
+                    const value_type l = a (i, p);
+                    if (l != value_type/*zero*/())
+                        for (std::size_t c = 0; c < nrhs; ++ c)
+                            e (i, c) -= l * e (p, c);
+                }
+                const value_type d = a (i, i);
+                for (std::size_t c = 0; c < nrhs; ++ c)
+                    e (i, c) /= d;
+            }
+            for (std::size_t i = size; i -- > 0; ) {
+                const value_type d = a (i, i);
+                for (std::size_t c = 0; c < nrhs; ++ c)
+                    e (i, c) /= d;
+                for (std::size_t p = i > lower ? i - lower : 0; p < i; ++ p) {
+                    const value_type l = a (i, p);
+                    if (l != value_type/*zero*/())
+                        for (std::size_t c = 0; c < nrhs; ++ c)
+                            e (p, c) -= l * e (i, c);
+                }
+            }
+        }
+    }
+
+    // Cholesky factorization m = L L^T (L L^H for hermitian matrices) of a positive definite matrix.
+    // Returns 0, or the index + 1 of the first pivot that is not positive, in which case m is left partially factored.
+    template<class T, class TRI, class L, class A>
+    typename symmetric_matrix<T, TRI, L, A>::size_type cholesky_factorize (symmetric_matrix<T, TRI, L, A> &m) {
+        return detail::cholesky_factorize<false, TRI> (m);
+    }
+    template<class M, class TRI>
+    typename symmetric_adaptor<M, TRI>::size_type cholesky_factorize (symmetric_adaptor<M, TRI> &m) {
+        return detail::cholesky_factorize<false, TRI> (m);
+    }
+    template<class T, class TRI, class L, class A>
+    typename hermitian_matrix<T, TRI, L, A>::size_type cholesky_factorize (hermitian_matrix<T, TRI, L, A> &m) {
+        return detail::cholesky_factorize<true, TRI> (m);
+    }
+    template<class M, class TRI>
+    typename hermitian_adaptor<M, TRI>::size_type cholesky_factorize (hermitian_adaptor<M, TRI> &m) {
+        return detail::cholesky_factorize<true, TRI> (m);
+    }
+
+    // Cholesky factorization m = L L^T of a symmetric positive definite banded matrix, in place within its lower
+    // diagonals, in O (n * lower ^ 2) operations. The upper diagonals are not referenced.
+    // Returns 0, or the index + 1 of the first pivot that is not positive, in which case m is left partially factored.
+    template<class T, class L, class A>
+    typename banded_matrix<T, L, A>::size_type cholesky_factorize (banded_matrix<T, L, A> &m) {
+        typedef banded_matrix<T, L, A> matrix_type;
+        typedef detail::band_storage<matrix_type> storage_type;
+        typedef typename L::orientation_category orientation_category;
+
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        const typename storage_type::type a (storage_type::view (m));
+        return detail::banded_cholesky_factorize (a, m.size1 (), m.lower (), orientation_category ());
+    }
+
+    // Cholesky substitution: solves m x = e in place, m being factored by cholesky_factorize
+    template<class M, class E>
+    void cholesky_substitute (const M &m, vector_expression<E> &e) {
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size (), bad_size ());
+        detail::cholesky_forward<false> (m, e (), vector_tag ());
+        detail::cholesky_backward<detail::cholesky_conjugate<M>::value, false> (m, e (), vector_tag ());
+    }
+    template<class M, class E>
+    void cholesky_substitute (const M &m, matrix_expression<E> &e) {
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size1 (), bad_size ());
+        detail::cholesky_forward<false> (m, e (), matrix_tag ());
+        detail::cholesky_backward<detail::cholesky_conjugate<M>::value, false> (m, e (), matrix_tag ());
+    }
+
+    template<class T, class L, class A, class E>
+    void cholesky_substitute (const banded_matrix<T, L, A> &m, vector_expression<E> &e) {
+        typedef detail::band_storage<const banded_matrix<T, L, A> > storage_type;
+
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size (), bad_size ());
+        const typename storage_type::type a (storage_type::view (m));
+        detail::banded_cholesky_substitute (a, m.size1 (), m.lower (), e (), vector_tag ());
+    }
+    template<class T, class L, class A, class E>
+    void cholesky_substitute (const banded_matrix<T, L, A> &m, matrix_expression<E> &e) {
+        typedef detail::band_storage<const banded_matrix<T, L, A> > storage_type;
+
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size1 (), bad_size ());
+        const typename storage_type::type a (storage_type::view (m));
+        detail::banded_cholesky_substitute (a, m.size1 (), m.lower (), e (), matrix_tag ());
+    }
+
+    // L D L^T factorization (L D L^H for hermitian matrices) without pivoting, L unit lower and D diagonal,
+    // D replacing the diagonal of m. For symmetric matrices whose leading minors are all non zero,
+    // such as quasi-definite ones. Returns 0, or the index + 1 of the first zero pivot, in which case m is
+    // left partially factored.
+    template<class T, class TRI, class L, class A>
+    typename symmetric_matrix<T, TRI, L, A>::size_type ldlt_factorize (symmetric_matrix<T, TRI, L, A> &m) {
+        return detail::ldlt_factorize<false, TRI> (m);
+    }
+    template<class M, class TRI>
+    typename symmetric_adaptor<M, TRI>::size_type ldlt_factorize (symmetric_adaptor<M, TRI> &m) {
+        return detail::ldlt_factorize<false, TRI> (m);
+    }
+    template<class T, class TRI, class L, class A>
+    typename hermitian_matrix<T, TRI, L, A>::size_type ldlt_factorize (hermitian_matrix<T, TRI, L, A> &m) {
+        return detail::ldlt_factorize<true, TRI> (m);
+    }
+    template<class M, class TRI>
+    typename hermitian_adaptor<M, TRI>::size_type ldlt_factorize (hermitian_adaptor<M, TRI> &m) {
+        return detail::ldlt_factorize<true, TRI> (m);
+    }
+
+    // L D L^T substitution: solves m x = e in place, m being factored by ldlt_factorize
+    template<class M, class E>
+    void ldlt_substitute (const M &m, vector_expression<E> &e) {
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size (), bad_size ());
+        detail::cholesky_forward<true> (m, e (), vector_tag ());
+        detail::ldlt_diagonal (m, e (), vector_tag ());
+        detail::cholesky_backward<detail::cholesky_conjugate<M>::value, true> (m, e (), vector_tag ());
+    }
+    template<class M, class E>
+    void ldlt_substitute (const M &m, matrix_expression<E> &e) {
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size1 (), bad_size ());
+        detail::cholesky_forward<true> (m, e (), matrix_tag ());
+        detail::ldlt_diagonal (m, e (), matrix_tag ());
+        detail::cholesky_backward<detail::cholesky_conjugate<M>::value, true> (m, e (), matrix_tag ());
+    }
+
+}}}
+
+#endif
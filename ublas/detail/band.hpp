@@ -0,0 +1,267 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_BAND_
+#define _BOOST_UBLAS_BAND_
+
+#include <algorithm>
+#include <vector>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_const.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/numeric/ublas/fwd.hpp>
+#include <boost/numeric/ublas/detail/config.hpp>
+
+namespace boost { namespace numeric { namespace ublas { namespace detail {
+
+    /*
+        Kernels over the storage of banded_matrix.
+
+        In the netlib layout, the default one, element (i, j) of a band with l lower and u upper diagonals is
+        data [i * (l + u) + l + j] for row major matrices and data [j * (l + u) + u + i] for column major ones,
+        so a row (row major) or a column (column major) of the band is contiguous. The kernels walk the band
+        through band_view, which reduces to this arithmetic, and pick their loop order from the orientation
+        so that the innermost loop runs along contiguous elements. With BOOST_UBLAS_OWN_BANDED or
+        BOOST_UBLAS_LEGACY_BANDED the same kernels go through the element accessors instead.
+
+        All kernels only touch elements inside the band.
+    */
+
+    // Element (i, j) inside the band of a banded_matrix stored in the netlib layout, T being const for reading
+    template<class T, class O>
+    class band_view {};
+
+    template<class T>
+    class band_view<T, row_major_tag> {
+    public:
+        typedef typename boost::remove_const<T>::type value_type;
+        typedef T &reference;
+
+        band_view (T *data, std::size_t lower, std::size_t upper):
+            data_ (data ? data + lower : data), stride_ (lower + upper) {}
+
+        BOOST_UBLAS_INLINE
+        reference operator () (std::size_t i, std::size_t j) const {
+            return data_ [i * stride_ + j];
+        }
+
+    private:
+        T *data_;
+        std::size_t stride_;
+    };
+
+    template<class T>
+    class band_view<T, column_major_tag> {
+    public:
+        typedef typename boost::remove_const<T>::type value_type;
+        typedef T &reference;
+
+        band_view (T *data, std::size_t lower, std::size_t upper):
+            data_ (data ? data + upper : data), stride_ (lower + upper) {}
+
+        BOOST_UBLAS_INLINE
+        reference operator () (std::size_t i, std::size_t j) const {
+            return data_ [i + j * stride_];
+        }
+
+    private:
+        T *data_;
+        std::size_t stride_;
+    };
+
+    // Element (i, j) inside the band through the accessors of the matrix, for the other storage layouts
+    template<class M>
+    class band_element_view {
+    public:
+        typedef typename M::value_type value_type;
+        typedef typename M::reference reference;
+
+        band_element_view (M &m):
+            m_ (m) {}
+
+        BOOST_UBLAS_INLINE
+        reference operator () (std::size_t i, std::size_t j) const {
+            return m_.at_element (i, j);
+        }
+
+    private:
+        M &m_;
+    };
+
+    template<class M>
+    class band_element_view<const M> {
+    public:
+        typedef typename M::value_type value_type;
+        typedef typename M::const_reference reference;
+
+        band_element_view (const M &m):
+            m_ (m) {}
+
+        BOOST_UBLAS_INLINE
+        reference operator () (std::size_t i, std::size_t j) const {
+            return m_ (i, j);
+        }
+
+    private:
+        const M &m_;
+    };
+
+    // The view of the band of the banded_matrix M, const qualified for reading
+    template<class M>
+    struct band_storage {
+#if defined (BOOST_UBLAS_OWN_BANDED) || (BOOST_UBLAS_LEGACY_BANDED)
+        typedef band_element_view<M> type;
+
+        static type view (M &m) {
+            return type (m);
+        }
+#else
+        typedef typename boost::mpl::if_c<boost::is_const<M>::value,
+                                          const typename M::value_type,
+                                          typename M::value_type>::type value_type;
+        typedef band_view<value_type, typename M::orientation_category> type;
+
+        static type view (M &m) {
+            return type (m.data ().size () ? &m.data () [0] : 0, m.lower (), m.upper ());
+        }
+#endif
+    };
+
+    // v (i) += row i of a times x for the rows [first, last), as dot products along the rows.
+    // With init v (i) = row i of a times x, v being written without being read; so are the other kernels.
+    template<class A, class T, class V>
+    void banded_axpy_rows (const A &a, std::size_t lower, std::size_t upper, std::size_t size2,
+                           const T *x, V &v, std::size_t first, std::size_t last, bool init, row_major_tag) {
+        for (std::size_t i = first; i < last; ++ i) {
+            const std::size_t j0 = i > lower ? i - lower : 0;
+            const std::size_t j1 = (std::min) (i + upper + 1, size2);
+            T t0 = T (), t1 = T (), t2 = T (), t3 = T ();
+            std::size_t j = j0;
+            for (; j + 4 <= j1; j += 4) {
+                t0 += a (i, j) * x [j];
+                t1 += a (i, j + 1) * x [j + 1];
+                t2 += a (i, j + 2) * x [j + 2];
+                t3 += a (i, j + 3) * x [j + 3];
+            }
+            for (; j < j1; ++ j)
+                t0 += a (i, j) * x [j];
+            if (init)
+                v (i) = (t0 + t1) + (t2 + t3);
+            else
+                v (i) += (t0 + t1) + (t2 + t3);
+        }
+    }
+
+    // v (i) += row i of a times x for the rows [first, last), as axpys along the columns crossing these rows.
+    // The rows of narrow bands span a cache line or two, and are cheaper to walk as dot products.
+    template<class A, class T, class V>
+    void banded_axpy_rows (const A &a, std::size_t lower, std::size_t upper, std::size_t size2,
+                           const T *x, V &v, std::size_t first, std::size_t last, bool init, column_major_tag) {
+        if (lower + upper < 8) {
+            banded_axpy_rows (a, lower, upper, size2, x, v, first, last, init, row_major_tag ());
+            return;
+        }
+        if (first >= last)
+            return;
+        std::vector<T> y (last - first);
+        const std::size_t j0 = first > lower ? first - lower : 0;
+        const std::size_t j1 = (std::min) (last + upper, size2);
+        for (std::size_t j = j0; j < j1; ++ j) {
+            const T t = x [j];
+            if (t == T/*zero*/())
+                continue;
+            const std::size_t i0 = (std::max) (first, j > upper ? j - upper : 0);
+            const std::size_t i1 = (std::min) (last, j + lower + 1);
+            T *yi = &y [i0 - first];
+            std::size_t i = i0;
+            for (; i + 4 <= i1; i += 4, yi += 4) {
+                yi [0] += a (i, j) * t;
+                yi [1] += a (i + 1, j) * t;
+                yi [2] += a (i + 2, j) * t;
+                yi [3] += a (i + 3, j) * t;
+            }
+            for (; i < i1; ++ i, ++ yi)
+                *yi += a (i, j) * t;
+        }
+        if (init) {
+            for (std::size_t i = first; i < last; ++ i)
+                v (i) = y [i - first];
+        }
+        else {
+            for (std::size_t i = first; i < last; ++ i)
+                v (i) += y [i - first];
+        }
+    }
+
+    // Task of the parallel banded matrix vector product: the rows [first, last), disjoint between tasks
+    template<class A, class T, class V, class O>
+    struct banded_axpy_row_task {
+        banded_axpy_row_task (const A &a, std::size_t lower, std::size_t upper, std::size_t size2, const T *x, V &v, bool init):
+            a (a), lower (lower), upper (upper), size2 (size2), x (x), v (v), init (init) {}
+
+        void operator () (std::size_t first, std::size_t last) const {
+            banded_axpy_rows (a, lower, upper, size2, x, v, first, last, init, O ());
+        }
+
+        const A &a;
+        std::size_t lower, upper, size2;
+        const T *x;
+        V &v;
+        bool init;
+    };
+
+    // m (i, .) += row i of a times b for the rows [first, last), b being row major with n columns.
+    // Every row of the band scales contiguous rows of b into a row buffer, whatever the orientation of a.
+    template<class A, class T, class M>
+    void banded_axpy_block_rows (const A &a, std::size_t lower, std::size_t upper, std::size_t size2,
+                                 const T *b, std::size_t n, M &m, std::size_t first, std::size_t last, bool init) {
+        std::vector<T> r (n);
+        for (std::size_t i = first; i < last; ++ i) {
+            std::fill (r.begin (), r.end (), T/*zero*/());
+            const std::size_t j0 = i > lower ? i - lower : 0;
+            const std::size_t j1 = (std::min) (i + upper + 1, size2);
+            for (std::size_t j = j0; j < j1; ++ j) {
+                const T t = a (i, j);
+                const T *bj = b + j * n;
+                for (std::size_t c = 0; c < n; ++ c)
+                    r [c] += t * bj [c];
+            }
+            if (init) {
+                for (std::size_t c = 0; c < n; ++ c)
+                    m (i, c) = r [c];
+            }
+            else {
+                for (std::size_t c = 0; c < n; ++ c)
+                    m (i, c) += r [c];
+            }
+        }
+    }
+
+    // Task of the parallel banded matrix product: the rows [first, last), disjoint between tasks
+    template<class A, class T, class M>
+    struct banded_axpy_block_row_task {
+        banded_axpy_block_row_task (const A &a, std::size_t lower, std::size_t upper, std::size_t size2,
+                                    const T *b, std::size_t n, M &m, bool init):
+            a (a), lower (lower), upper (upper), size2 (size2), b (b), n (n), m (m), init (init) {}
+
+        void operator () (std::size_t first, std::size_t last) const {
+            banded_axpy_block_rows (a, lower, upper, size2, b, n, m, first, last, init);
+        }
+
+        const A &a;
+        std::size_t lower, upper, size2;
+        const T *b;
+        std::size_t n;
+        M &m;
+        bool init;
+    };
+
+}}}}
+
+#endif
@@ -0,0 +1,154 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_CHAIN_ORDER_
+#define _BOOST_UBLAS_CHAIN_ORDER_
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/numeric/ublas/detail/config.hpp>
+
+namespace boost { namespace numeric { namespace ublas { namespace detail {
+
+    /*
+        Optimal association of a chain of matrix products A0 * A1 * ... * An-1 where Ai is dims[i] x dims[i + 1].
+
+        The classic dynamic program over sub chains: cost (i, j) is the cheapest way to compute Ai * ... * Aj
+        and split (i, j) the k such that it is computed as (Ai * ... * Ak) * (Ak+1 * ... * Aj).
+        A product of a m x k by a k x n matrix is charged m * n * k multiply-adds of the given cost.
+    */
+    class matrix_chain_order {
+    public:
+        BOOST_UBLAS_INLINE
+        matrix_chain_order (const std::vector<std::size_t> &dims, double multiply_add_cost = 1.):
+            dims_ (dims), size_ (dims.size () > 0 ? dims.size () - 1 : 0),
+            cost_ (size_ * size_, 0.), split_ (size_ * size_, 0) {
+            for (std::size_t length = 2; length <= size_; ++ length) {
+                for (std::size_t i = 0; i + length <= size_; ++ i) {
+                    const std::size_t j = i + length - 1;
+                    double best = -1.;
+                    for (std::size_t k = i; k < j; ++ k) {
+                        const double c = cost (i, k) + cost (k + 1, j)
+                            + multiply_add_cost * double (dims_ [i]) * double (dims_ [k + 1]) * double (dims_ [j + 1]);
+                        if (best < 0. || c < best) {
+                            best = c;
+                            split_ [i * size_ + j] = k;
+                        }
+                    }
+                    cost_ [i * size_ + j] = best;
+                }
+            }
+        }
+
+        // Number of operands of the chain
+        BOOST_UBLAS_INLINE
+        std::size_t size () const { return size_; }
+
+        BOOST_UBLAS_INLINE
+        std::size_t rows (std::size_t i) const { return dims_ [i]; }
+        BOOST_UBLAS_INLINE
+        std::size_t columns (std::size_t j) const { return dims_ [j + 1]; }
+
+        BOOST_UBLAS_INLINE
+        std::size_t split (std::size_t i, std::size_t j) const { return split_ [i * size_ + j]; }
+
+        // Cost of the optimal evaluation of Ai * ... * Aj, and of the whole chain
+        BOOST_UBLAS_INLINE
+        double cost (std::size_t i, std::size_t j) const { return cost_ [i * size_ + j]; }
+        BOOST_UBLAS_INLINE
+        double cost () const { return size_ > 0 ? cost (0, size_ - 1) : 0.; }
+
+        // Elements read and written by the chosen evaluation of Ai * ... * Aj,
+        // every product reading both of its operands once and writing its result once
+        BOOST_UBLAS_INLINE
+        double elements (std::size_t i, std::size_t j) const {
+            if (i == j)
+                return 0.;
+            const std::size_t k = split (i, j);
+            return elements (i, k) + elements (k + 1, j)
+                + double (dims_ [i]) * double (dims_ [k + 1]) + double (dims_ [k + 1]) * double (dims_ [j + 1])
+                + double (dims_ [i]) * double (dims_ [j + 1]);
+        }
+
+        // Cost of the evaluation from left to right, as written without parentheses
+        BOOST_UBLAS_INLINE
+        double sequential_cost (double multiply_add_cost = 1.) const {
+            double c = 0.;
+            for (std::size_t k = 1; k < size_; ++ k)
+                c += multiply_add_cost * double (dims_ [0]) * double (dims_ [k]) * double (dims_ [k + 1]);
+            return c;
+        }
+
+        // Parenthesized form of the chosen association of Ai * ... * Aj using the given operand names
+        BOOST_UBLAS_INLINE
+        std::string to_string (const std::vector<std::string> &names, std::size_t i, std::size_t j) const {
+            if (i == j)
+                return names [i];
+            const std::size_t k = split (i, j);
+            return "(" + to_string (names, i, k) + " * " + to_string (names, k + 1, j) + ")";
+        }
+        BOOST_UBLAS_INLINE
+        std::string to_string (const std::vector<std::string> &names) const {
+            return size_ > 0 ? to_string (names, 0, size_ - 1) : std::string ();
+        }
+        BOOST_UBLAS_INLINE
+        std::string to_string () const {
+            std::vector<std::string> names (size_);
+            for (std::size_t i = 0; i < size_; ++ i) {
+                std::ostringstream s;
+                s << 'A' << i;
+                names [i] = s.str ();
+            }
+            return to_string (names);
+        }
+
+    private:
+        std::vector<std::size_t> dims_;
+        std::size_t size_;
+        std::vector<double> cost_;
+        std::vector<std::size_t> split_;
+    };
+
+    // Read only view of dense storage with arbitrary strides, used for the operands
+    // and the intermediate results of a product chain.
+    template <typename T>
+    class strided_view {
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+
+        BOOST_UBLAS_INLINE
+        strided_view (): data_ (0), size1_ (0), size2_ (0), stride1_ (0), stride2_ (0) {}
+        BOOST_UBLAS_INLINE
+        strided_view (const T *data, size_type size1, size_type size2, std::ptrdiff_t stride1, std::ptrdiff_t stride2):
+            data_ (data), size1_ (size1), size2_ (size2), stride1_ (stride1), stride2_ (stride2) {}
+
+        BOOST_UBLAS_INLINE
+        size_type size1 () const { return size1_; }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const { return size2_; }
+
+        BOOST_UBLAS_INLINE
+        const T &operator () (size_type i, size_type j) const {
+            return data_ [std::ptrdiff_t (i) * stride1_ + std::ptrdiff_t (j) * stride2_];
+        }
+
+    private:
+        const T *data_;
+        size_type size1_;
+        size_type size2_;
+        std::ptrdiff_t stride1_;
+        std::ptrdiff_t stride2_;
+    };
+
+}}}}
+
+#endif
@@ -43,6 +43,15 @@
 
 #endif
 
+// Elements about to be destroyed are moved rather than copied where the language allows it
+#ifdef BOOST_UBLAS_CPP_GE_2011
+#include <utility>
+#include <type_traits>
+#define BOOST_UBLAS_MOVE_ELEMENT(x) std::move (x)
+#else
+#define BOOST_UBLAS_MOVE_ELEMENT(x) (x)
+#endif
+
 // Microsoft Visual C++
 #if defined (BOOST_MSVC) && ! defined (BOOST_STRICT_CONFIG)
 
@@ -271,6 +280,13 @@ bool disable_type_check<Dummy>::value = false;
 #endif
 // #define BOOST_UBLAS_ITERATOR_THRESHOLD 0
 
+// Evaluate large dense assignments on a pool of threads (needs C++11 threads).
+// Below BOOST_UBLAS_PARALLEL_THRESHOLD destination elements the assignment stays serial.
+// #define BOOST_UBLAS_USE_THREADS
+#ifndef BOOST_UBLAS_PARALLEL_THRESHOLD
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 65536
+#endif
+
 // Use indexed iterators - unsupported implementation experiment
 // #define BOOST_UBLAS_USE_INDEXED_ITERATOR
 
@@ -0,0 +1,515 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_FIXED_KERNELS_
+#define _BOOST_UBLAS_FIXED_KERNELS_
+
+#include <algorithm>
+#include <cmath>
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/numeric/ublas/fwd.hpp>
+#include <boost/numeric/ublas/detail/packet.hpp>
+
+// Largest extent for which operations on fixed size matrices are fully unrolled.
+// Bigger matrices go through the generic kernels.
+#ifndef BOOST_UBLAS_FIXED_UNROLL_LIMIT
+#define BOOST_UBLAS_FIXED_UNROLL_LIMIT 8
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+
+    /*
+        Dense matrices whose extents are template arguments.
+        value tells whether E is one of them; rows, cols, value_type and orientation_category describe it
+        and data (e) gives the address of its first element in storage order.
+    */
+    template <typename E>
+    struct fixed_size_traits {
+        typedef void value_type;
+        typedef unknown_orientation_tag orientation_category;
+
+        enum {
+            value = 0,
+            rows = 0,
+            cols = 0,
+        };
+    };
+
+#ifdef BOOST_UBLAS_CPP_GE_2011
+    template <typename T, std::size_t M, std::size_t N, typename L, typename A>
+    struct fixed_size_traits< fixed_matrix<T, M, N, L, A> > {
+        typedef fixed_matrix<T, N, M, L, A> transpose_type;
+        typedef T value_type;
+        typedef typename L::orientation_category orientation_category;
+
+        enum {
+            value = 1,
+            rows = M,
+            cols = N,
+        };
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const fixed_matrix<T, M, N, L, A> &m) { return &m.data () [0]; }
+        static BOOST_UBLAS_INLINE
+        T *data (fixed_matrix<T, M, N, L, A> &m) { return &m.data () [0]; }
+        static BOOST_UBLAS_INLINE
+        const T *data (const matrix_reference<const fixed_matrix<T, M, N, L, A> > &m) { return &m.expression ().data () [0]; }
+        static BOOST_UBLAS_INLINE
+        T *data (const matrix_reference<fixed_matrix<T, M, N, L, A> > &m) { return &m.expression ().data () [0]; }
+    };
+#endif
+
+    template <typename E>
+    struct fixed_size_traits< matrix_reference<E> >:
+        fixed_size_traits<typename boost::remove_const<E>::type> {};
+
+    // Whether E1 and E2 are small fixed size matrices sharing element type and storage order,
+    // so that the unrolled kernels apply to their storage directly
+    template <typename E1, typename E2>
+    struct fixed_size_compatible {
+        typedef fixed_size_traits<E1> traits1;
+        typedef fixed_size_traits<E2> traits2;
+
+        enum {
+            value = traits1::value && traits2::value
+                && boost::is_same<typename traits1::value_type, typename traits2::value_type>::value
+                && boost::is_same<typename traits1::orientation_category, typename traits2::orientation_category>::value
+                && ! boost::is_same<typename traits1::orientation_category, unknown_orientation_tag>::value
+                && int (traits1::rows) <= BOOST_UBLAS_FIXED_UNROLL_LIMIT && int (traits1::cols) <= BOOST_UBLAS_FIXED_UNROLL_LIMIT
+                && int (traits2::rows) <= BOOST_UBLAS_FIXED_UNROLL_LIMIT && int (traits2::cols) <= BOOST_UBLAS_FIXED_UNROLL_LIMIT,
+        };
+    };
+
+namespace detail {
+
+    /*
+        Fully unrolled kernels on the row major storage of small fixed size matrices.
+
+        Loops are expanded by template recursion, so every index is a compile time constant and the
+        compiler keeps the operands in registers. When a row is a whole number of SIMD packets the
+        product works on packets of the right hand side. Column major matrices use the same kernels:
+        their storage is the row major storage of the transpose.
+    */
+
+    // c (M x N) = a (M x K) * b (K x N), scalar version
+    template <typename T, std::size_t M, std::size_t K, std::size_t N,
+              bool Packed = packet_traits<T>::vectorized && N % packet_traits<T>::size == 0>
+    struct fixed_product_kernel {
+        template <std::size_t I, std::size_t J, std::size_t P>
+        struct dot {
+            static BOOST_UBLAS_INLINE
+            T apply (const T *a, const T *b) {
+                return dot<I, J, P - 1>::apply (a, b) + a [I * K + P - 1] * b [(P - 1) * N + J];
+            }
+        };
+        template <std::size_t I, std::size_t J>
+        struct dot<I, J, 1> {
+            static BOOST_UBLAS_INLINE
+            T apply (const T *a, const T *b) {
+                return a [I * K] * b [J];
+            }
+        };
+
+        // element E = I * N + J of c
+        template <std::size_t E, std::size_t Size = M * N>
+        struct element {
+            static BOOST_UBLAS_INLINE
+            void apply (const T *a, const T *b, T *c) {
+                c [E] = dot<E / N, E % N, K>::apply (a, b);
+                element<E + 1, Size>::apply (a, b, c);
+            }
+        };
+        template <std::size_t Size>
+        struct element<Size, Size> {
+            static BOOST_UBLAS_INLINE
+            void apply (const T *, const T *, T *) {}
+        };
+
+        static BOOST_UBLAS_INLINE
+        void apply (const T *a, const T *b, T *c) {
+            element<0>::apply (a, b, c);
+        }
+    };
+
+    // c (M x N) = a (M x K) * b (K x N), every row of c is N / size packets
+    template <typename T, std::size_t M, std::size_t K, std::size_t N>
+    struct fixed_product_kernel<T, M, K, N, true> {
+        typedef packet_traits<T> traits;
+        typedef typename traits::type packet_type;
+
+        enum {
+            packets = N / traits::size,
+        };
+
+        // packet Q of row I of c accumulated over the columns [0, P) of a
+        template <std::size_t I, std::size_t Q, std::size_t P>
+        struct dot {
+            static BOOST_UBLAS_INLINE
+            packet_type apply (const T *a, const T *b) {
+                return traits::madd (traits::set1 (a [I * K + P - 1]), traits::loadu (b + (P - 1) * N + Q * traits::size),
+                                     dot<I, Q, P - 1>::apply (a, b));
+            }
+        };
+        template <std::size_t I, std::size_t Q>
+        struct dot<I, Q, 1> {
+            static BOOST_UBLAS_INLINE
+            packet_type apply (const T *a, const T *b) {
+                return traits::mul (traits::set1 (a [I * K]), traits::loadu (b + Q * traits::size));
+            }
+        };
+
+        // packet E = I * packets + Q of c
+        template <std::size_t E, std::size_t Size = M * packets>
+        struct element {
+            static BOOST_UBLAS_INLINE
+            void apply (const T *a, const T *b, T *c) {
+                traits::storeu (c + E * traits::size, dot<E / packets, E % packets, K>::apply (a, b));
+                element<E + 1, Size>::apply (a, b, c);
+            }
+        };
+        template <std::size_t Size>
+        struct element<Size, Size> {
+            static BOOST_UBLAS_INLINE
+            void apply (const T *, const T *, T *) {}
+        };
+
+        static BOOST_UBLAS_INLINE
+        void apply (const T *a, const T *b, T *c) {
+            element<0>::apply (a, b, c);
+        }
+    };
+
+    // c [i] = op (a [i], b [i]) for the S elements of two matrices, packets first then the remaining elements
+    template <typename T, std::size_t S, typename Op>
+    struct fixed_elementwise_kernel {
+        typedef packet_traits<T> traits;
+
+        enum {
+            packed = traits::vectorized ? S / traits::size * traits::size : 0,
+        };
+
+        // Step 0 handles a packet, 1 a single element and 2 ends the recursion
+        template <std::size_t I, int Step = (I < std::size_t (packed) ? 0 : I < S ? 1 : 2)>
+        struct step {
+            static BOOST_UBLAS_INLINE
+            void apply (const T *a, const T *b, T *c) {
+                traits::storeu (c + I, Op::template apply<traits> (traits::loadu (a + I), traits::loadu (b + I)));
+                step<I + traits::size>::apply (a, b, c);
+            }
+        };
+        template <std::size_t I>
+        struct step<I, 1> {
+            static BOOST_UBLAS_INLINE
+            void apply (const T *a, const T *b, T *c) {
+                c [I] = Op::template apply< scalar_packet_traits<T> > (a [I], b [I]);
+                step<I + 1>::apply (a, b, c);
+            }
+        };
+        template <std::size_t I>
+        struct step<I, 2> {
+            static BOOST_UBLAS_INLINE
+            void apply (const T *, const T *, T *) {}
+        };
+
+        static BOOST_UBLAS_INLINE
+        void apply (const T *a, const T *b, T *c) {
+            step<0>::apply (a, b, c);
+        }
+    };
+
+    // Element operations of fixed_elementwise_kernel on packets or on scalars
+    struct fixed_plus {
+        template <typename PacketTraits>
+        static BOOST_UBLAS_INLINE
+        typename PacketTraits::type apply (const typename PacketTraits::type &a, const typename PacketTraits::type &b) {
+            return PacketTraits::add (a, b);
+        }
+    };
+
+    struct fixed_minus {
+        template <typename PacketTraits>
+        static BOOST_UBLAS_INLINE
+        typename PacketTraits::type apply (const typename PacketTraits::type &a, const typename PacketTraits::type &b) {
+            return PacketTraits::sub (a, b);
+        }
+    };
+
+    // b (N x M) = transpose of a (M x N)
+    template <typename T, std::size_t M, std::size_t N, std::size_t E = 0, bool End = (E == M * N)>
+    struct fixed_transpose_kernel {
+        static BOOST_UBLAS_INLINE
+        void apply (const T *a, T *b) {
+            b [(E % N) * M + E / N] = a [E];
+            fixed_transpose_kernel<T, M, N, E + 1>::apply (a, b);
+        }
+    };
+    template <typename T, std::size_t M, std::size_t N, std::size_t E>
+    struct fixed_transpose_kernel<T, M, N, E, true> {
+        static BOOST_UBLAS_INLINE
+        void apply (const T *, T *) {}
+    };
+
+    // c = a * b on the storage of M x K and K x N matrices of the given orientation
+    template <typename T, std::size_t M, std::size_t K, std::size_t N>
+    BOOST_UBLAS_INLINE
+    void fixed_product (const T *a, const T *b, T *c, row_major_tag) {
+        fixed_product_kernel<T, M, K, N>::apply (a, b, c);
+    }
+    template <typename T, std::size_t M, std::size_t K, std::size_t N>
+    BOOST_UBLAS_INLINE
+    void fixed_product (const T *a, const T *b, T *c, column_major_tag) {
+        fixed_product_kernel<T, N, K, M>::apply (b, a, c);
+    }
+
+    // b = trans (a) on the storage of a M x N matrix of the given orientation
+    template <typename T, std::size_t M, std::size_t N>
+    BOOST_UBLAS_INLINE
+    void fixed_transpose (const T *a, T *b, row_major_tag) {
+        fixed_transpose_kernel<T, M, N>::apply (a, b);
+    }
+    template <typename T, std::size_t M, std::size_t N>
+    BOOST_UBLAS_INLINE
+    void fixed_transpose (const T *a, T *b, column_major_tag) {
+        fixed_transpose_kernel<T, N, M>::apply (a, b);
+    }
+
+    // Closed form determinants of the small cases, usable in constant expressions
+    template <typename T>
+    BOOST_UBLAS_INLINE BOOST_CONSTEXPR
+    T det2 (const T &a00, const T &a01, const T &a10, const T &a11) {
+        return a00 * a11 - a01 * a10;
+    }
+
+    template <typename T>
+    BOOST_UBLAS_INLINE BOOST_CONSTEXPR
+    T det3 (const T &a00, const T &a01, const T &a02,
+            const T &a10, const T &a11, const T &a12,
+            const T &a20, const T &a21, const T &a22) {
+        return a00 * det2 (a11, a12, a21, a22) - a01 * det2 (a10, a12, a20, a22) + a02 * det2 (a10, a11, a20, a21);
+    }
+
+    // Determinant of the N x N matrix a
+    template <typename T, std::size_t N>
+    struct fixed_determinant_kernel {
+        // Gaussian elimination with partial pivoting on a copy, the loops have compile time bounds
+        static BOOST_UBLAS_INLINE
+        T apply (const T *a) {
+            T m [N * N];
+            for (std::size_t i = 0; i < N * N; ++ i)
+                m [i] = a [i];
+            T det (1);
+            for (std::size_t k = 0; k < N; ++ k) {
+                std::size_t p = k;
+                for (std::size_t i = k + 1; i < N; ++ i)
+                    if (std::abs (m [i * N + k]) > std::abs (m [p * N + k]))
+                        p = i;
+                if (m [p * N + k] == T (0))
+                    return T (0);
+                if (p != k) {
+                    for (std::size_t j = 0; j < N; ++ j)
+                        std::swap (m [k * N + j], m [p * N + j]);
+                    det = -det;
+                }
+                det *= m [k * N + k];
+                for (std::size_t i = k + 1; i < N; ++ i) {
+                    const T f = m [i * N + k] / m [k * N + k];
+                    for (std::size_t j = k + 1; j < N; ++ j)
+                        m [i * N + j] -= f * m [k * N + j];
+                }
+            }
+            return det;
+        }
+    };
+
+    template <typename T>
+    struct fixed_determinant_kernel<T, 1> {
+        static BOOST_UBLAS_INLINE
+        T apply (const T *a) { return a [0]; }
+    };
+
+    template <typename T>
+    struct fixed_determinant_kernel<T, 2> {
+        static BOOST_UBLAS_INLINE
+        T apply (const T *a) { return det2 (a [0], a [1], a [2], a [3]); }
+    };
+
+    template <typename T>
+    struct fixed_determinant_kernel<T, 3> {
+        static BOOST_UBLAS_INLINE
+        T apply (const T *a) { return det3 (a [0], a [1], a [2], a [3], a [4], a [5], a [6], a [7], a [8]); }
+    };
+
+    template <typename T>
+    struct fixed_determinant_kernel<T, 4> {
+        // Laplace expansion along the first row with shared 2 x 2 minors of the last two rows
+        static BOOST_UBLAS_INLINE
+        T apply (const T *a) {
+            const T s0 = det2 (a [8], a [9], a [12], a [13]);
+            const T s1 = det2 (a [8], a [10], a [12], a [14]);
+            const T s2 = det2 (a [8], a [11], a [12], a [15]);
+            const T s3 = det2 (a [9], a [10], a [13], a [14]);
+            const T s4 = det2 (a [9], a [11], a [13], a [15]);
+            const T s5 = det2 (a [10], a [11], a [14], a [15]);
+            return a [0] * (a [5] * s5 - a [6] * s4 + a [7] * s3)
+                 - a [1] * (a [4] * s5 - a [6] * s2 + a [7] * s1)
+                 + a [2] * (a [4] * s4 - a [5] * s2 + a [7] * s0)
+                 - a [3] * (a [4] * s3 - a [5] * s1 + a [6] * s0);
+        }
+    };
+
+    // b = inverse of the N x N matrix a, returns false and leaves b unspecified when a is singular
+    template <typename T, std::size_t N>
+    struct fixed_inverse_kernel {
+        // Gauss-Jordan elimination with partial pivoting, the loops have compile time bounds
+        static BOOST_UBLAS_INLINE
+        bool apply (const T *a, T *b) {
+            T m [N * N];
+            for (std::size_t i = 0; i < N * N; ++ i) {
+                m [i] = a [i];
+                b [i] = i % (N + 1) == 0 ? T (1) : T (0);
+            }
+            for (std::size_t k = 0; k < N; ++ k) {
+                std::size_t p = k;
+                for (std::size_t i = k + 1; i < N; ++ i)
+                    if (std::abs (m [i * N + k]) > std::abs (m [p * N + k]))
+                        p = i;
+                if (m [p * N + k] == T (0))
+                    return false;
+                if (p != k) {
+                    for (std::size_t j = 0; j < N; ++ j) {
+                        std::swap (m [k * N + j], m [p * N + j]);
+                        std::swap (b [k * N + j], b [p * N + j]);
+                    }
+                }
+                const T d = T (1) / m [k * N + k];
+                for (std::size_t j = 0; j < N; ++ j) {
+                    m [k * N + j] *= d;
+                    b [k * N + j] *= d;
+                }
+                for (std::size_t i = 0; i < N; ++ i) {
+                    if (i == k)
+                        continue;
+                    const T f = m [i * N + k];
+                    for (std::size_t j = 0; j < N; ++ j) {
+                        m [i * N + j] -= f * m [k * N + j];
+                        b [i * N + j] -= f * b [k * N + j];
+                    }
+                }
+            }
+            return true;
+        }
+    };
+
+    template <typename T>
+    struct fixed_inverse_kernel<T, 1> {
+        static BOOST_UBLAS_INLINE
+        bool apply (const T *a, T *b) {
+            if (a [0] == T (0))
+                return false;
+            b [0] = T (1) / a [0];
+            return true;
+        }
+    };
+
+    template <typename T>
+    struct fixed_inverse_kernel<T, 2> {
+        static BOOST_UBLAS_INLINE
+        bool apply (const T *a, T *b) {
+            const T det = det2 (a [0], a [1], a [2], a [3]);
+            if (det == T (0))
+                return false;
+            const T r = T (1) / det;
+            const T a0 = a [0];
+            b [0] = a [3] * r;
+            b [1] = - a [1] * r;
+            b [2] = - a [2] * r;
+            b [3] = a0 * r;
+            return true;
+        }
+    };
+
+    template <typename T>
+    struct fixed_inverse_kernel<T, 3> {
+        // adjugate over determinant
+        static BOOST_UBLAS_INLINE
+        bool apply (const T *a, T *b) {
+            const T c00 = det2 (a [4], a [5], a [7], a [8]);
+            const T c01 = - det2 (a [3], a [5], a [6], a [8]);
+            const T c02 = det2 (a [3], a [4], a [6], a [7]);
+            const T det = a [0] * c00 + a [1] * c01 + a [2] * c02;
+            if (det == T (0))
+                return false;
+            const T r = T (1) / det;
+            T t [9];
+            t [0] = c00 * r;
+            t [3] = c01 * r;
+            t [6] = c02 * r;
+            t [1] = - det2 (a [1], a [2], a [7], a [8]) * r;
+            t [4] = det2 (a [0], a [2], a [6], a [8]) * r;
+            t [7] = - det2 (a [0], a [1], a [6], a [7]) * r;
+            t [2] = det2 (a [1], a [2], a [4], a [5]) * r;
+            t [5] = - det2 (a [0], a [2], a [3], a [5]) * r;
+            t [8] = det2 (a [0], a [1], a [3], a [4]) * r;
+            for (std::size_t i = 0; i < 9; ++ i)
+                b [i] = t [i];
+            return true;
+        }
+    };
+
+    template <typename T>
+    struct fixed_inverse_kernel<T, 4> {
+        // adjugate over determinant, with the 2 x 2 minors of the top and bottom row pairs shared
+        static BOOST_UBLAS_INLINE
+        bool apply (const T *a, T *b) {
+            const T s0 = det2 (a [0], a [1], a [4], a [5]);
+            const T s1 = det2 (a [0], a [2], a [4], a [6]);
+            const T s2 = det2 (a [0], a [3], a [4], a [7]);
+            const T s3 = det2 (a [1], a [2], a [5], a [6]);
+            const T s4 = det2 (a [1], a [3], a [5], a [7]);
+            const T s5 = det2 (a [2], a [3], a [6], a [7]);
+            const T c5 = det2 (a [10], a [11], a [14], a [15]);
+            const T c4 = det2 (a [9], a [11], a [13], a [15]);
+            const T c3 = det2 (a [9], a [10], a [13], a [14]);
+            const T c2 = det2 (a [8], a [11], a [12], a [15]);
+            const T c1 = det2 (a [8], a [10], a [12], a [14]);
+            const T c0 = det2 (a [8], a [9], a [12], a [13]);
+            const T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            if (det == T (0))
+                return false;
+            const T r = T (1) / det;
+            T t [16];
+            t [0] = ( a [5] * c5 - a [6] * c4 + a [7] * c3) * r;
+            t [1] = (-a [1] * c5 + a [2] * c4 - a [3] * c3) * r;
+            t [2] = ( a [13] * s5 - a [14] * s4 + a [15] * s3) * r;
+            t [3] = (-a [9] * s5 + a [10] * s4 - a [11] * s3) * r;
+            t [4] = (-a [4] * c5 + a [6] * c2 - a [7] * c1) * r;
+            t [5] = ( a [0] * c5 - a [2] * c2 + a [3] * c1) * r;
+            t [6] = (-a [12] * s5 + a [14] * s2 - a [15] * s1) * r;
+            t [7] = ( a [8] * s5 - a [10] * s2 + a [11] * s1) * r;
+            t [8] = ( a [4] * c4 - a [5] * c2 + a [7] * c0) * r;
+            t [9] = (-a [0] * c4 + a [1] * c2 - a [3] * c0) * r;
+            t [10] = ( a [12] * s4 - a [13] * s2 + a [15] * s0) * r;
+            t [11] = (-a [8] * s4 + a [9] * s2 - a [11] * s0) * r;
+            t [12] = (-a [4] * c3 + a [5] * c1 - a [6] * c0) * r;
+            t [13] = ( a [0] * c3 - a [1] * c1 + a [2] * c0) * r;
+            t [14] = (-a [12] * s3 + a [13] * s1 - a [14] * s0) * r;
+            t [15] = ( a [8] * s3 - a [9] * s1 + a [10] * s0) * r;
+            for (std::size_t i = 0; i < 16; ++ i)
+                b [i] = t [i];
+            return true;
+        }
+    };
+
+}
+
+}}}
+
+#endif
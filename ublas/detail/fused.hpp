@@ -0,0 +1,274 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_FUSED_
+#define _BOOST_UBLAS_FUSED_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <boost/static_assert.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/numeric/ublas/vector_expression.hpp>
+#include <boost/numeric/ublas/detail/parallel.hpp>
+#include <boost/numeric/ublas/detail/reduce.hpp>
+
+// Elements each operation of a fused loop processes before handing over to the next one
+#ifndef BOOST_UBLAS_FUSED_BLOCK_SIZE
+#define BOOST_UBLAS_FUSED_BLOCK_SIZE 512
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    /*
+        Fused vector operations.
+
+        A conjugate gradient step x += a p; r -= a q; rr = inner_prod (r, r) makes three passes over
+        memory, each one streaming its vectors from memory again. fused_update runs such a list of
+        assignments and inner products over the same index range in a single pass: the range is cut
+        into blocks of BOOST_UBLAS_FUSED_BLOCK_SIZE elements, and every operation runs in order on a
+        block while it is still in L1. An operation thus sees the elements the previous ones wrote,
+        as if the list were run one operation after the other, provided that the expressions are
+        element wise, as with noalias: element i of an operand only depends on element i of its
+        operands.
+
+        Ranges of at least the threshold of parallel_policy are split into one part per thread, the
+        inner products combining the partial results of the parts in order.
+    */
+
+    // v F= e
+    template<template <class T1, class T2> class F, class V, class E>
+    class fused_assignment {
+    public:
+        typedef typename V::size_type size_type;
+        typedef F<typename V::reference, typename E::value_type> functor_type;
+
+        BOOST_STATIC_ASSERT ((boost::is_same<typename V::storage_category, dense_tag>::value ||
+                              boost::is_same<typename V::storage_category, dense_proxy_tag>::value));
+
+        BOOST_UBLAS_INLINE
+        fused_assignment (V &v, const E &e):
+            v_ (v), e_ (e) {}
+
+        BOOST_UBLAS_INLINE
+        size_type size () const {
+            BOOST_UBLAS_CHECK (v_.size () == e_.size (), bad_size ());
+            return v_.size ();
+        }
+
+        BOOST_UBLAS_INLINE
+        void apply (size_type first, size_type last) {
+            for (size_type i = first; i < last; ++ i)
+                functor_type::apply (v_ (i), e_ (i));
+        }
+        BOOST_UBLAS_INLINE
+        void combine (const fused_assignment &) {}
+        BOOST_UBLAS_INLINE
+        void store () const {}
+
+    private:
+        typename V::closure_type v_;
+        typename E::const_closure_type e_;
+    };
+
+    // t = inner_prod (e1, e2)
+    template<class T, class E1, class E2>
+    class fused_inner_prod {
+    public:
+        typedef typename E1::size_type size_type;
+        typedef typename promote_traits<typename E1::value_type, typename E2::value_type>::promote_type value_type;
+        typedef typename E1::const_closure_type expression1_closure_type;
+        typedef typename E2::const_closure_type expression2_closure_type;
+
+        BOOST_UBLAS_INLINE
+        fused_inner_prod (T &t, const E1 &e1, const E2 &e2):
+            t_ (t), e1_ (e1), e2_ (e2), s_ () {}
+
+        BOOST_UBLAS_INLINE
+        size_type size () const {
+            BOOST_UBLAS_CHECK (e1_.size () == e2_.size (), bad_size ());
+            return e1_.size ();
+        }
+
+        BOOST_UBLAS_INLINE
+        void apply (size_type first, size_type last) {
+            apply (first, last, boost::mpl::bool_<vector_storage<expression1_closure_type>::value && vector_storage<expression2_closure_type>::value> ());
+        }
+        // Dense storage case, through the kernels of reduce.hpp
+        BOOST_UBLAS_INLINE
+        void apply (size_type first, size_type last, boost::mpl::true_) {
+            typedef typename vector_storage<expression1_closure_type>::value_type value1_type;
+            typedef typename vector_storage<expression2_closure_type>::value_type value2_type;
+            typedef boost::mpl::bool_<packet_reduction<value1_type, value_type>::value && boost::is_same<value1_type, value2_type>::value> packets;
+            s_ += dot_serial<value_type> (vector_storage<expression1_closure_type>::view (e1_).part (first, last),
+                                          vector_storage<expression2_closure_type>::view (e2_).part (first, last), packets ());
+        }
+        // Four accumulators, as the reductions of reduce.hpp
+        BOOST_UBLAS_INLINE
+        void apply (size_type first, size_type last, boost::mpl::false_) {
+            value_type s0 = value_type (), s1 = value_type (), s2 = value_type (), s3 = value_type ();
+            size_type i = first;
+            for (; i + 4 <= last; i += 4) {
+                s0 += e1_ (i) * e2_ (i);
+                s1 += e1_ (i + 1) * e2_ (i + 1);
+                s2 += e1_ (i + 2) * e2_ (i + 2);
+                s3 += e1_ (i + 3) * e2_ (i + 3);
+            }
+            for (; i < last; ++ i)
+                s0 += e1_ (i) * e2_ (i);
+            s_ += (s0 + s1) + (s2 + s3);
+        }
+        BOOST_UBLAS_INLINE
+        void combine (const fused_inner_prod &p) {
+            s_ += p.s_;
+        }
+        BOOST_UBLAS_INLINE
+        void store () const {
+            t_ = s_;
+        }
+
+    private:
+        T &t_;
+        expression1_closure_type e1_;
+        expression2_closure_type e2_;
+        value_type s_;
+    };
+
+    // The operations of a fused loop, run in order on each block
+    struct fused_nil {
+        BOOST_UBLAS_INLINE
+        void apply (std::size_t, std::size_t) {}
+        BOOST_UBLAS_INLINE
+        void combine (const fused_nil &) {}
+        BOOST_UBLAS_INLINE
+        void store () const {}
+        BOOST_UBLAS_INLINE
+        void check (std::size_t) const {}
+    };
+
+    template<class O, class L>
+    struct fused_list {
+        BOOST_UBLAS_INLINE
+        fused_list (const O &o, const L &l):
+            op (o), rest (l) {}
+
+        BOOST_UBLAS_INLINE
+        void apply (std::size_t first, std::size_t last) {
+            op.apply (first, last);
+            rest.apply (first, last);
+        }
+        BOOST_UBLAS_INLINE
+        void combine (const fused_list &l) {
+            op.combine (l.op);
+            rest.combine (l.rest);
+        }
+        BOOST_UBLAS_INLINE
+        void store () const {
+            op.store ();
+            rest.store ();
+        }
+        BOOST_UBLAS_INLINE
+        void check (std::size_t size) const {
+            BOOST_UBLAS_CHECK (std::size_t (op.size ()) == size, bad_size ());
+            rest.check (size);
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t size () const {
+            return op.size ();
+        }
+
+        O op;
+        L rest;
+    };
+
+    template<class... Os>
+    struct fused_list_type {
+        typedef fused_nil type;
+    };
+    template<class O, class... Os>
+    struct fused_list_type<O, Os...> {
+        typedef fused_list<O, typename fused_list_type<Os...>::type> type;
+    };
+
+    BOOST_UBLAS_INLINE
+    fused_nil make_fused_list () {
+        return fused_nil ();
+    }
+    template<class O, class... Os>
+    BOOST_UBLAS_INLINE
+    typename fused_list_type<O, Os...>::type make_fused_list (const O &o, const Os &... os) {
+        return typename fused_list_type<O, Os...>::type (o, make_fused_list (os...));
+    }
+
+    template<class L>
+    void fused_blocks (L &l, std::size_t first, std::size_t last) {
+        for (std::size_t b = first; b < last; b += BOOST_UBLAS_FUSED_BLOCK_SIZE)
+            l.apply (b, (std::min) (b + BOOST_UBLAS_FUSED_BLOCK_SIZE, last));
+    }
+
+    template<class L>
+    void fused_run (L l) {
+        const std::size_t size = l.size ();
+        l.check (size);
+        const std::size_t parts = parallel_policy::enabled (size) ? (std::min) (parallel_policy::num_threads (), size / BOOST_UBLAS_FUSED_BLOCK_SIZE) : 1;
+        if (parts <= 1) {
+            fused_blocks (l, 0, size);
+            l.store ();
+            return;
+        }
+
+        std::vector<L> partial (parts, l);
+        parallel_for (0, parts, 1, [&] (std::size_t first, std::size_t last) {
+            for (std::size_t p = first; p < last; ++ p)
+                fused_blocks (partial [p], reduction_bound (size, p, parts), reduction_bound (size, p + 1, parts));
+        });
+        for (std::size_t p = 1; p < parts; ++ p)
+            partial [0].combine (partial [p]);
+        partial [0].store ();
+    }
+
+}
+
+    // Deferred operations of fused_update
+    template<class V, class E>
+    BOOST_UBLAS_INLINE
+    detail::fused_assignment<scalar_assign, V, E> update_assign (V &v, const vector_expression<E> &e) {
+        return detail::fused_assignment<scalar_assign, V, E> (v, e ());
+    }
+    template<class V, class E>
+    BOOST_UBLAS_INLINE
+    detail::fused_assignment<scalar_plus_assign, V, E> update_plus_assign (V &v, const vector_expression<E> &e) {
+        return detail::fused_assignment<scalar_plus_assign, V, E> (v, e ());
+    }
+    template<class V, class E>
+    BOOST_UBLAS_INLINE
+    detail::fused_assignment<scalar_minus_assign, V, E> update_minus_assign (V &v, const vector_expression<E> &e) {
+        return detail::fused_assignment<scalar_minus_assign, V, E> (v, e ());
+    }
+    template<class T, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    detail::fused_inner_prod<T, E1, E2> update_inner_prod (T &t, const vector_expression<E1> &e1, const vector_expression<E2> &e2) {
+        return detail::fused_inner_prod<T, E1, E2> (t, e1 (), e2 ());
+    }
+
+    // Runs the operations in order in a single pass over their dense vectors:
+    // fused_update (update_plus_assign (x, a * p), update_minus_assign (r, a * q), update_inner_prod (rr, r, r));
+    // Expressions must be element wise and must not alias the other vectors but through the same element.
+    template<class... Os>
+    BOOST_UBLAS_INLINE
+    void fused_update (const Os &... os) {
+        detail::fused_run (detail::make_fused_list (os...));
+    }
+
+}}}
+
+#endif
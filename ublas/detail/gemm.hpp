@@ -0,0 +1,231 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_GEMM_
+#define _BOOST_UBLAS_GEMM_
+
+#include <algorithm>
+#include <boost/numeric/ublas/storage.hpp>
+#include <boost/numeric/ublas/detail/packet.hpp>
+#include <boost/numeric/ublas/detail/scratch.hpp>
+
+// Cache sizes in bytes used to derive the blocking of the packed GEMM kernel.
+// They can be overridden on the command line to match the target machine.
+#ifndef BOOST_UBLAS_L1_CACHE_SIZE
+#define BOOST_UBLAS_L1_CACHE_SIZE 32768
+#endif
+#ifndef BOOST_UBLAS_L2_CACHE_SIZE
+#define BOOST_UBLAS_L2_CACHE_SIZE 262144
+#endif
+#ifndef BOOST_UBLAS_L3_CACHE_SIZE
+#define BOOST_UBLAS_L3_CACHE_SIZE 8388608
+#endif
+
+namespace boost { namespace numeric { namespace ublas { namespace detail {
+
+    /*
+        Packed GEMM kernel computing C = beta * C + alpha * A * B.
+
+        The operands are split the usual way: a KC x NC panel of B is packed once and stays in L3,
+        an MC x KC block of A is packed into L2, and the micro kernel multiplies one MR x KC sliver of A
+        with one KC x NR sliver of B held in L1, accumulating an MR x NR tile in registers.
+        Packing pads partial slivers with zeros so the micro kernel never sees an edge case.
+    */
+
+    // Blocking parameters for a given register tile MR x NR.
+    template <typename T, std::size_t MR, std::size_t NR>
+    struct gemm_blocking_base {
+        static const std::size_t mr = MR;
+        static const std::size_t nr = NR;
+        // half of L1 for the current sliver of B, the other half for A and C
+        static const std::size_t kc_raw = BOOST_UBLAS_L1_CACHE_SIZE / (2 * NR * sizeof(T));
+        static const std::size_t kc = kc_raw > 0 ? kc_raw : 1;
+        // half of L2 for the packed block of A
+        static const std::size_t mc_raw = BOOST_UBLAS_L2_CACHE_SIZE / (2 * kc * sizeof(T)) / MR * MR;
+        static const std::size_t mc = mc_raw > MR ? mc_raw : MR;
+        // half of L3 for the packed panel of B
+        static const std::size_t nc_raw = BOOST_UBLAS_L3_CACHE_SIZE / (2 * kc * sizeof(T)) / NR * NR;
+        static const std::size_t nc = nc_raw > NR ? nc_raw : NR;
+    };
+
+    template <typename T>
+    struct gemm_blocking : gemm_blocking_base<T, 4, 4> {};
+
+    template <>
+    struct gemm_blocking<double> : gemm_blocking_base<double, 4, 8> {};
+
+    template <>
+    struct gemm_blocking<float> : gemm_blocking_base<float, 8, 8> {};
+
+    // Pack the mc x kc block of a starting at (i0, k0) into slivers of MR rows.
+    // Each sliver is stored column after column: pa[(ir / MR) * MR * kc + p * MR + i].
+    template <std::size_t MR, typename T, typename E>
+    BOOST_UBLAS_INLINE
+    void gemm_pack_a (const E &a, std::size_t i0, std::size_t mc, std::size_t k0, std::size_t kc, T *pa) {
+        for (std::size_t ir = 0; ir < mc; ir += MR) {
+            const std::size_t m = (std::min) (MR, mc - ir);
+            for (std::size_t p = 0; p < kc; ++p) {
+                std::size_t i = 0;
+                for (; i < m; ++i)
+                    *pa++ = a (i0 + ir + i, k0 + p);
+                for (; i < MR; ++i)
+                    *pa++ = T (0);
+            }
+        }
+    }
+
+    // Pack the kc x nc panel of b starting at (k0, j0) into slivers of NR columns.
+    // Each sliver is stored row after row: pb[(jr / NR) * NR * kc + p * NR + j].
+    template <std::size_t NR, typename T, typename E>
+    BOOST_UBLAS_INLINE
+    void gemm_pack_b (const E &b, std::size_t k0, std::size_t kc, std::size_t j0, std::size_t nc, T *pb) {
+        for (std::size_t jr = 0; jr < nc; jr += NR) {
+            const std::size_t n = (std::min) (NR, nc - jr);
+            for (std::size_t p = 0; p < kc; ++p) {
+                std::size_t j = 0;
+                for (; j < n; ++j)
+                    *pb++ = b (k0 + p, j0 + jr + j);
+                for (; j < NR; ++j)
+                    *pb++ = T (0);
+            }
+        }
+    }
+
+    // Register blocked micro kernel: ab = pa * pb for one MR x kc sliver of A and one kc x NR sliver of B.
+    // The accumulator tile has compile time extent so that the compiler keeps it in registers.
+    template <typename T, std::size_t MR, std::size_t NR,
+              bool Packed = packet_traits<T>::vectorized && NR % packet_traits<T>::size == 0>
+    struct gemm_micro_kernel {
+        static BOOST_UBLAS_INLINE
+        void apply (std::size_t kc, const T *pa, const T *pb, T *ab) {
+            T acc [MR * NR];
+            for (std::size_t i = 0; i < MR * NR; ++i)
+                acc [i] = T (0);
+            for (std::size_t p = 0; p < kc; ++p) {
+                for (std::size_t i = 0; i < MR; ++i) {
+                    const T ai = pa [i];
+                    for (std::size_t j = 0; j < NR; ++j)
+                        acc [i * NR + j] += ai * pb [j];
+                }
+                pa += MR;
+                pb += NR;
+            }
+            for (std::size_t i = 0; i < MR * NR; ++i)
+                ab [i] = acc [i];
+        }
+    };
+
+    // Same kernel on packets: each row of the tile is NR / size packets, a(i) is broadcast
+    // and multiplied into them, so the row of pb is loaded once per k for all MR rows.
+    template <typename T, std::size_t MR, std::size_t NR>
+    struct gemm_micro_kernel<T, MR, NR, true> {
+        static BOOST_UBLAS_INLINE
+        void apply (std::size_t kc, const T *pa, const T *pb, T *ab) {
+            typedef packet_traits<T> traits;
+            typedef typename traits::type packet_type;
+            enum { np = NR / traits::size };
+            packet_type acc [MR * np];
+            for (std::size_t i = 0; i < MR * np; ++i)
+                acc [i] = traits::set1 (T (0));
+            for (std::size_t p = 0; p < kc; ++p) {
+                packet_type b [np];
+                for (std::size_t j = 0; j < np; ++j)
+                    b [j] = traits::load (pb + j * traits::size);
+                for (std::size_t i = 0; i < MR; ++i) {
+                    const packet_type ai = traits::set1 (pa [i]);
+                    for (std::size_t j = 0; j < np; ++j)
+                        acc [i * np + j] = traits::madd (ai, b [j], acc [i * np + j]);
+                }
+                pa += MR;
+                pb += NR;
+            }
+            for (std::size_t i = 0; i < MR * np; ++i)
+                traits::storeu (ab + i * traits::size, acc [i]);
+        }
+    };
+
+    // Write an m x n corner of the MR x NR tile ab back into c at (i0, j0).
+    // On the first pass over k, c is scaled by beta; beta == 0 overwrites c without reading it.
+    template <std::size_t NR, typename M, typename T>
+    BOOST_UBLAS_INLINE
+    void gemm_update_tile (M &c, std::size_t i0, std::size_t j0, std::size_t m, std::size_t n,
+                           const T *ab, const T &alpha, const T &beta, bool first) {
+        if (! first || beta == T (1)) {
+            for (std::size_t i = 0; i < m; ++i)
+                for (std::size_t j = 0; j < n; ++j)
+                    c (i0 + i, j0 + j) += alpha * ab [i * NR + j];
+        }
+        else if (beta == T (0)) {
+            for (std::size_t i = 0; i < m; ++i)
+                for (std::size_t j = 0; j < n; ++j)
+                    c (i0 + i, j0 + j) = alpha * ab [i * NR + j];
+        }
+        else {
+            for (std::size_t i = 0; i < m; ++i)
+                for (std::size_t j = 0; j < n; ++j)
+                    c (i0 + i, j0 + j) = beta * c (i0 + i, j0 + j) + alpha * ab [i * NR + j];
+        }
+    }
+
+    // c = beta * c + alpha * a * b where c is m x n, a is m x k and b is k x n.
+    // a and b only need element access through operator () (i, j), c must return references.
+    template <typename T, typename M, typename E1, typename E2>
+    void gemm (M &c, const E1 &a, const E2 &b, std::size_t m, std::size_t n, std::size_t k,
+               const T &alpha, const T &beta) {
+        typedef gemm_blocking<T> blocking;
+        const std::size_t MR = blocking::mr;
+        const std::size_t NR = blocking::nr;
+        const std::size_t KC = blocking::kc;
+        const std::size_t MC = blocking::mc;
+        const std::size_t NC = blocking::nc;
+
+        if (m == 0 || n == 0)
+            return;
+
+        if (k == 0 || alpha == T (0)) {
+            for (std::size_t i = 0; i < m; ++i)
+                for (std::size_t j = 0; j < n; ++j)
+                    c (i, j) = beta == T (0) ? T (0) : beta * c (i, j);
+            return;
+        }
+
+        const std::size_t mc_max = ((std::min) (m, MC) + MR - 1) / MR * MR;
+        const std::size_t nc_max = ((std::min) (n, NC) + NR - 1) / NR * NR;
+        const std::size_t kc_max = (std::min) (k, KC);
+
+        // Packing buffers from the scratch arena, aligned on BOOST_UBLAS_SCRATCH_ALIGNMENT
+        typedef unbounded_array<T, scratch_allocator<T> > buffer_type;
+        buffer_type pa (mc_max * kc_max, no_init_tag ());
+        buffer_type pb (kc_max * nc_max, no_init_tag ());
+        T ab [MR * NR];
+
+        for (std::size_t jc = 0; jc < n; jc += NC) {
+            const std::size_t nc = (std::min) (NC, n - jc);
+            for (std::size_t pc = 0; pc < k; pc += KC) {
+                const std::size_t kc = (std::min) (KC, k - pc);
+                gemm_pack_b<NR> (b, pc, kc, jc, nc, &pb [0]);
+                for (std::size_t ic = 0; ic < m; ic += MC) {
+                    const std::size_t mc = (std::min) (MC, m - ic);
+                    gemm_pack_a<MR> (a, ic, mc, pc, kc, &pa [0]);
+                    for (std::size_t jr = 0; jr < nc; jr += NR) {
+                        const std::size_t nr = (std::min) (NR, nc - jr);
+                        for (std::size_t ir = 0; ir < mc; ir += MR) {
+                            const std::size_t mr = (std::min) (MR, mc - ir);
+                            gemm_micro_kernel<T, MR, NR>::apply (kc, &pa [ir * kc], &pb [jr * kc], ab);
+                            gemm_update_tile<NR> (c, ic + ir, jc + jr, mr, nr, ab, alpha, beta, pc == 0);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+}}}}
+
+#endif
@@ -0,0 +1,513 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_GEMV_
+#define _BOOST_UBLAS_GEMV_
+
+#include <algorithm>
+#include <cstddef>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/numeric/ublas/storage.hpp>
+#include <boost/numeric/ublas/vector_expression.hpp>
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/numeric/ublas/detail/gemm.hpp>
+#include <boost/numeric/ublas/detail/packet.hpp>
+#include <boost/numeric/ublas/detail/parallel.hpp>
+#include <boost/numeric/ublas/detail/reduce.hpp>
+#include <boost/numeric/ublas/detail/scratch.hpp>
+
+namespace boost { namespace numeric { namespace ublas { namespace detail {
+
+    /*
+        Dense matrix vector product y += A x.
+
+        A row with contiguous elements is a dot product with x: the rows kernel takes four rows at once,
+        each x packet being loaded once for the four of them, and sweeps x in blocks that stay in L1 while
+        every row crosses them. A column with contiguous elements is an axpy into y: the columns kernel
+        takes four columns at once, each y packet being loaded and stored once for the four of them, and
+        sweeps y in blocks that stay in L1 while every column crosses them. The transpose of a row major
+        matrix has contiguous columns and goes through the columns kernel, and conversely.
+
+        x is first copied to a contiguous scratch buffer, scaled by alpha, so that any vector expression
+        may be multiplied and that x can not alias the result. Rows of y are split across threads
+        when parallel_policy allows it, each thread owning the rows it writes.
+    */
+
+    // size1 x size2 elements, (i, j) being data [i * stride1 + j * stride2]
+    template<class T>
+    struct strided_matrix_view {
+        strided_matrix_view (const T *data, std::size_t size1, std::size_t size2, std::ptrdiff_t stride1, std::ptrdiff_t stride2):
+            data (data), size1 (size1), size2 (size2), stride1 (stride1), stride2 (stride2) {}
+
+        const T *data;
+        std::size_t size1, size2;
+        std::ptrdiff_t stride1, stride2;
+    };
+
+    // The transpose of a dense matrix is read from its storage with the strides swapped
+    template<class E, class T>
+    struct matrix_storage<matrix_unary2<E, scalar_identity<T> > > {
+        typedef typename matrix_unary2<E, scalar_identity<T> >::expression_closure_type closure_type;
+        static const bool value = matrix_storage<closure_type>::value;
+        typedef typename matrix_storage<closure_type>::value_type value_type;
+
+        static const value_type *data (const matrix_unary2<E, scalar_identity<T> > &m) {
+            return matrix_storage<closure_type>::data (m.expression ());
+        }
+        static std::ptrdiff_t stride1 (const matrix_unary2<E, scalar_identity<T> > &m) {
+            return matrix_storage<closure_type>::stride2 (m.expression ());
+        }
+        static std::ptrdiff_t stride2 (const matrix_unary2<E, scalar_identity<T> > &m) {
+            return matrix_storage<closure_type>::stride1 (m.expression ());
+        }
+    };
+
+    template<class M>
+    strided_matrix_view<typename matrix_storage<M>::value_type> matrix_view (const M &m) {
+        return strided_matrix_view<typename matrix_storage<M>::value_type> (matrix_storage<M>::data (m), m.size1 (), m.size2 (),
+                                                                             matrix_storage<M>::stride1 (m), matrix_storage<M>::stride2 (m));
+    }
+
+    // The transposed view, for the products x A = trans (A) x
+    template<class T>
+    strided_matrix_view<T> transposed (const strided_matrix_view<T> &a) {
+        return strided_matrix_view<T> (a.data, a.size2, a.size1, a.stride2, a.stride1);
+    }
+
+    // Whether the product of TA elements with a TX vector runs on packets
+    template<class TA, class TX>
+    struct packet_gemv {
+        static const bool value = packet_reduction<TA, TX>::value;
+    };
+
+    template<class T>
+    BOOST_UBLAS_INLINE
+    void gemv_store (T &y, const T &t, bool init) {
+        if (init)
+            y = t;
+        else
+            y += t;
+    }
+
+    // y (i) (+)= row i of a times x for the rows [first, last), with any strides
+    template<class TA, class T>
+    void gemv_rows (const strided_matrix_view<TA> &a, const T *x, T *y, std::size_t first, std::size_t last, bool init, boost::mpl::false_) {
+        const std::ptrdiff_t s2 = a.stride2;
+        for (std::size_t i = first; i < last; ++ i) {
+            const TA *ai = a.data + std::ptrdiff_t (i) * a.stride1;
+            T t0 = T (), t1 = T (), t2 = T (), t3 = T ();
+            std::size_t j = 0;
+            for (; j + 4 <= a.size2; j += 4, ai += 4 * s2) {
+                t0 += ai [0] * x [j];
+                t1 += ai [s2] * x [j + 1];
+                t2 += ai [2 * s2] * x [j + 2];
+                t3 += ai [3 * s2] * x [j + 3];
+            }
+            for (; j < a.size2; ++ j, ai += s2)
+                t0 += *ai * x [j];
+            gemv_store (y [i], (t0 + t1) + (t2 + t3), init);
+        }
+    }
+
+    // y (i) (+)= row i of a times x for the rows [first, last), a having contiguous rows
+    template<class T>
+    void gemv_rows (const strided_matrix_view<T> &a, const T *x, T *y, std::size_t first, std::size_t last, bool init, boost::mpl::true_) {
+        typedef packet_traits<T> packet_type;
+        typedef typename packet_type::type packet;
+        const std::size_t ps = packet_type::size;
+        const std::size_t block = (std::max) (std::size_t (BOOST_UBLAS_L1_CACHE_SIZE / (2 * sizeof (T))) / ps * ps, ps);
+        const std::ptrdiff_t s1 = a.stride1;
+        const packet zero = packet_type::set1 (T ());
+
+        if (a.size2 == 0) {
+            for (std::size_t i = first; i < last; ++ i)
+                gemv_store (y [i], T (), init);
+            return;
+        }
+        for (std::size_t j0 = 0; j0 < a.size2; j0 += block) {
+            const std::size_t j1 = (std::min) (j0 + block, a.size2);
+            const bool first_block = init && j0 == 0;
+            std::size_t i = first;
+            for (; i + 4 <= last; i += 4) {
+                const T *a0 = a.data + std::ptrdiff_t (i) * s1, *a1 = a0 + s1, *a2 = a1 + s1, *a3 = a2 + s1;
+                packet r0 = zero, r1 = zero, r2 = zero, r3 = zero;
+                std::size_t j = j0;
+                for (; j + ps <= j1; j += ps) {
+                    const packet xj = packet_type::loadu (x + j);
+                    r0 = packet_type::madd (packet_type::loadu (a0 + j), xj, r0);
+                    r1 = packet_type::madd (packet_type::loadu (a1 + j), xj, r1);
+                    r2 = packet_type::madd (packet_type::loadu (a2 + j), xj, r2);
+                    r3 = packet_type::madd (packet_type::loadu (a3 + j), xj, r3);
+                }
+                T t0 = packet_type::sum (r0), t1 = packet_type::sum (r1), t2 = packet_type::sum (r2), t3 = packet_type::sum (r3);
+                for (; j < j1; ++ j) {
+                    t0 += a0 [j] * x [j];
+                    t1 += a1 [j] * x [j];
+                    t2 += a2 [j] * x [j];
+                    t3 += a3 [j] * x [j];
+                }
+                gemv_store (y [i], t0, first_block);
+                gemv_store (y [i + 1], t1, first_block);
+                gemv_store (y [i + 2], t2, first_block);
+                gemv_store (y [i + 3], t3, first_block);
+            }
+            for (; i < last; ++ i) {
+                const T *ai = a.data + std::ptrdiff_t (i) * s1;
+                packet r0 = zero;
+                std::size_t j = j0;
+                for (; j + ps <= j1; j += ps)
+                    r0 = packet_type::madd (packet_type::loadu (ai + j), packet_type::loadu (x + j), r0);
+                T t0 = packet_type::sum (r0);
+                for (; j < j1; ++ j)
+                    t0 += ai [j] * x [j];
+                gemv_store (y [i], t0, first_block);
+            }
+        }
+    }
+
+    // y (i) (+)= row i of a times x for the rows [first, last), a having contiguous columns
+    template<class T>
+    void gemv_columns (const strided_matrix_view<T> &a, const T *x, T *y, std::size_t first, std::size_t last, bool init) {
+        typedef packet_traits<T> packet_type;
+        typedef typename packet_type::type packet;
+        const std::size_t ps = packet_type::size;
+        const std::size_t block = (std::max) (std::size_t (BOOST_UBLAS_L1_CACHE_SIZE / (2 * sizeof (T))) / ps * ps, ps);
+        const std::ptrdiff_t s2 = a.stride2;
+
+        for (std::size_t i0 = first; i0 < last; i0 += block) {
+            const std::size_t i1 = (std::min) (i0 + block, last);
+            if (init)
+                std::fill (y + i0, y + i1, T ());
+            std::size_t j = 0;
+            for (; j + 4 <= a.size2; j += 4) {
+                const T *c0 = a.data + std::ptrdiff_t (j) * s2, *c1 = c0 + s2, *c2 = c1 + s2, *c3 = c2 + s2;
+                const packet x0 = packet_type::set1 (x [j]), x1 = packet_type::set1 (x [j + 1]);
+                const packet x2 = packet_type::set1 (x [j + 2]), x3 = packet_type::set1 (x [j + 3]);
+                std::size_t i = i0;
+                for (; i + ps <= i1; i += ps) {
+                    packet yi = packet_type::loadu (y + i);
+                    yi = packet_type::madd (packet_type::loadu (c0 + i), x0, yi);
+                    yi = packet_type::madd (packet_type::loadu (c1 + i), x1, yi);
+                    yi = packet_type::madd (packet_type::loadu (c2 + i), x2, yi);
+                    yi = packet_type::madd (packet_type::loadu (c3 + i), x3, yi);
+                    packet_type::storeu (y + i, yi);
+                }
+                for (; i < i1; ++ i)
+                    y [i] += ((c0 [i] * x [j] + c1 [i] * x [j + 1]) + (c2 [i] * x [j + 2] + c3 [i] * x [j + 3]));
+            }
+            for (; j < a.size2; ++ j) {
+                const T *c0 = a.data + std::ptrdiff_t (j) * s2;
+                const packet x0 = packet_type::set1 (x [j]);
+                std::size_t i = i0;
+                for (; i + ps <= i1; i += ps)
+                    packet_type::storeu (y + i, packet_type::madd (packet_type::loadu (c0 + i), x0, packet_type::loadu (y + i)));
+                for (; i < i1; ++ i)
+                    y [i] += c0 [i] * x [j];
+            }
+        }
+    }
+
+    template<class TA, class T>
+    void gemv_kernel (const strided_matrix_view<TA> &a, const T *x, T *y, std::size_t first, std::size_t last, bool init, boost::mpl::false_) {
+        gemv_rows (a, x, y, first, last, init, boost::mpl::false_ ());
+    }
+
+    template<class T>
+    void gemv_kernel (const strided_matrix_view<T> &a, const T *x, T *y, std::size_t first, std::size_t last, bool init, boost::mpl::true_) {
+        if (a.stride2 == 1)
+            gemv_rows (a, x, y, first, last, init, boost::mpl::true_ ());
+        else if (a.stride1 == 1)
+            gemv_columns (a, x, y, first, last, init);
+        else
+            gemv_rows (a, x, y, first, last, init, boost::mpl::false_ ());
+    }
+
+    // y (+)= a x, x and y being contiguous
+    template<class TA, class T>
+    void gemv (const strided_matrix_view<TA> &a, const T *x, T *y, bool init) {
+        typedef boost::mpl::bool_<packet_gemv<TA, T>::value> packets;
+        if (parallel_policy::enabled (a.size1 * a.size2)) {
+            const std::size_t grain = (std::max) (std::size_t (64 / sizeof (T)), std::size_t (4));
+            parallel_for (0, a.size1, grain, [&] (std::size_t first, std::size_t last) {
+                gemv_kernel (a, x, y, first, last, init, packets ());
+            });
+        }
+        else
+            gemv_kernel (a, x, y, 0, a.size1, init, packets ());
+    }
+
+    template<class T, class V>
+    void gemv_vector (const strided_matrix_view<T> &a, const T *x, V &v, bool init, boost::mpl::true_) {
+        const strided_vector_view<T> y (vector_storage<V>::view (v));
+        if (y.stride == 1) {
+            // The view is read only, the storage behind it is that of v
+            gemv (a, x, const_cast<T *> (y.data), init);
+            return;
+        }
+        gemv_vector (a, x, v, init, boost::mpl::false_ ());
+    }
+
+    template<class TA, class T, class V>
+    void gemv_vector (const strided_matrix_view<TA> &a, const T *x, V &v, bool init, boost::mpl::false_) {
+        unbounded_array<T, scratch_allocator<T> > y (a.size1, no_init_tag ());
+        gemv (a, x, a.size1 ? &y [0] : static_cast<T *> (0), true);
+        for (std::size_t i = 0; i < a.size1; ++ i) {
+            if (init)
+                v (i) = y [i];
+            else
+                v (i) += y [i];
+        }
+    }
+
+    // v (+)= a x, x being contiguous and v any dense vector
+    template<class TA, class T, class V>
+    void gemv_vector (const strided_matrix_view<TA> &a, const T *x, V &v, bool init) {
+        BOOST_UBLAS_CHECK (a.size1 == v.size (), bad_size ());
+        gemv_vector (a, x, v, init, boost::mpl::bool_<boost::is_same<TA, T>::value && boost::is_same<typename vector_storage<V>::value_type, T>::value> ());
+    }
+
+    // Copies alpha x to a contiguous buffer
+    template<class T, class E, class A>
+    void gemv_scale (const vector_expression<E> &x, const T &alpha, unbounded_array<T, A> &xs) {
+        const std::size_t size = x ().size ();
+        xs.resize (size);
+        for (std::size_t j = 0; j < size; ++ j)
+            xs [j] = alpha * x () (j);
+    }
+
+    // v (+)= alpha a x, for any vector expression x and any dense vector v
+    template<class TA, class T, class E, class V>
+    void gemv_axpy (const strided_matrix_view<TA> &a, const vector_expression<E> &x, const T &alpha, V &v, bool init) {
+        BOOST_UBLAS_CHECK (a.size2 == x ().size (), bad_size ());
+        scratch_scope scope;
+        unbounded_array<T, scratch_allocator<T> > xs;
+        gemv_scale (x, alpha, xs);
+        gemv_vector (a, a.size2 ? &xs [0] : static_cast<const T *> (0), v, init);
+    }
+
+    // Terms alpha A x of a vector expression, A having dense storage:
+    // prod (A, x), prod (x, A) and their multiples by a scalar
+    template<class E>
+    struct gemv_term {
+        static const bool value = false;
+    };
+
+    template<class E>
+    struct gemv_term<const E>:
+        gemv_term<E> {};
+
+    // The products, resolved only when their matrix has dense storage
+    template<class E, bool STORAGE>
+    struct gemv_product_term {
+        static const bool value = false;
+    };
+
+    template<class E1, class E2, class M1, class M2, class TV>
+    struct gemv_product_term<matrix_vector_binary1<E1, E2, matrix_vector_prod1<M1, M2, TV> >, true> {
+        typedef matrix_vector_binary1<E1, E2, matrix_vector_prod1<M1, M2, TV> > expression_type;
+        typedef typename E1::const_closure_type matrix_closure_type;
+        typedef typename E2::const_closure_type vector_closure_type;
+        static const bool value = true;
+        typedef TV value_type;
+        typedef typename matrix_storage<matrix_closure_type>::value_type matrix_value_type;
+
+        static strided_matrix_view<matrix_value_type> matrix (const expression_type &e) {
+            return matrix_view (e.expression1 ());
+        }
+        static const vector_closure_type &vector (const expression_type &e) {
+            return e.expression2 ();
+        }
+        static value_type alpha (const expression_type &) {
+            return value_type (1);
+        }
+    };
+
+    template<class E1, class E2, class M1, class M2, class TV>
+    struct gemv_product_term<matrix_vector_binary2<E1, E2, matrix_vector_prod2<M1, M2, TV> >, true> {
+        typedef matrix_vector_binary2<E1, E2, matrix_vector_prod2<M1, M2, TV> > expression_type;
+        typedef typename E2::const_closure_type matrix_closure_type;
+        typedef typename E1::const_closure_type vector_closure_type;
+        static const bool value = true;
+        typedef TV value_type;
+        typedef typename matrix_storage<matrix_closure_type>::value_type matrix_value_type;
+
+        static strided_matrix_view<matrix_value_type> matrix (const expression_type &e) {
+            return transposed (matrix_view (e.expression2 ()));
+        }
+        static const vector_closure_type &vector (const expression_type &e) {
+            return e.expression1 ();
+        }
+        static value_type alpha (const expression_type &) {
+            return value_type (1);
+        }
+    };
+
+    template<class E1, class E2, class M1, class M2, class TV>
+    struct gemv_term<matrix_vector_binary1<E1, E2, matrix_vector_prod1<M1, M2, TV> > >:
+        gemv_product_term<matrix_vector_binary1<E1, E2, matrix_vector_prod1<M1, M2, TV> >,
+                          matrix_storage<typename E1::const_closure_type>::value> {};
+
+    template<class E1, class E2, class M1, class M2, class TV>
+    struct gemv_term<matrix_vector_binary2<E1, E2, matrix_vector_prod2<M1, M2, TV> > >:
+        gemv_product_term<matrix_vector_binary2<E1, E2, matrix_vector_prod2<M1, M2, TV> >,
+                          matrix_storage<typename E2::const_closure_type>::value> {};
+
+    // The multiples of a term, resolved only when their vector expression is one
+    template<class E, bool TERM>
+    struct gemv_multiple_term {
+        static const bool value = false;
+    };
+
+    template<class T1, class E2, class T, class U>
+    struct gemv_multiple_term<vector_binary_scalar1<T1, E2, scalar_multiplies<T, U> >, true> {
+        typedef vector_binary_scalar1<T1, E2, scalar_multiplies<T, U> > expression_type;
+        typedef gemv_term<E2> term_type;
+        typedef typename term_type::vector_closure_type vector_closure_type;
+        static const bool value = term_type::value;
+        typedef typename term_type::value_type value_type;
+        typedef typename term_type::matrix_value_type matrix_value_type;
+
+        static strided_matrix_view<matrix_value_type> matrix (const expression_type &e) {
+            return term_type::matrix (e.expression2 ());
+        }
+        static const vector_closure_type &vector (const expression_type &e) {
+            return term_type::vector (e.expression2 ());
+        }
+        static value_type alpha (const expression_type &e) {
+            return value_type (e.expression1 ()) * term_type::alpha (e.expression2 ());
+        }
+    };
+
+    template<class E1, class T2, class T, class U>
+    struct gemv_multiple_term<vector_binary_scalar2<E1, T2, scalar_multiplies<T, U> >, true> {
+        typedef vector_binary_scalar2<E1, T2, scalar_multiplies<T, U> > expression_type;
+        typedef gemv_term<E1> term_type;
+        typedef typename term_type::vector_closure_type vector_closure_type;
+        static const bool value = term_type::value;
+        typedef typename term_type::value_type value_type;
+        typedef typename term_type::matrix_value_type matrix_value_type;
+
+        static strided_matrix_view<matrix_value_type> matrix (const expression_type &e) {
+            return term_type::matrix (e.expression1 ());
+        }
+        static const vector_closure_type &vector (const expression_type &e) {
+            return term_type::vector (e.expression1 ());
+        }
+        static value_type alpha (const expression_type &e) {
+            return term_type::alpha (e.expression1 ()) * value_type (e.expression2 ());
+        }
+    };
+
+    template<class T1, class E2, class T, class U>
+    struct gemv_term<vector_binary_scalar1<T1, E2, scalar_multiplies<T, U> > >:
+        gemv_multiple_term<vector_binary_scalar1<T1, E2, scalar_multiplies<T, U> >, gemv_term<E2>::value> {};
+
+    template<class E1, class T2, class T, class U>
+    struct gemv_term<vector_binary_scalar2<E1, T2, scalar_multiplies<T, U> > >:
+        gemv_multiple_term<vector_binary_scalar2<E1, T2, scalar_multiplies<T, U> >, gemv_term<E1>::value> {};
+
+    // Vector expressions evaluated as alpha A x + y, the rest y being assigned element by element:
+    // a term, or the sum of a term and any expression, or the difference of any expression and a term
+    template<class E>
+    struct gemv_expression {
+        static const bool value = gemv_term<E>::value;
+        static const bool negate = false;
+        typedef E term_type;
+        typedef void rest_type;
+
+        static const E &term (const E &e) {
+            return e;
+        }
+    };
+
+    template<class E1, class E2, class F, bool TERM1 = gemv_term<E1>::value, bool TERM2 = gemv_term<E2>::value>
+    struct gemv_binary_expression {
+        static const bool value = false;
+    };
+
+    template<class E1, class E2, class T1, class T2, bool TERM2>
+    struct gemv_binary_expression<E1, E2, scalar_plus<T1, T2>, true, TERM2> {
+        static const bool value = true;
+        static const bool negate = false;
+        typedef E1 term_type;
+        typedef E2 rest_type;
+
+        static const typename E1::const_closure_type &term (const vector_binary<E1, E2, scalar_plus<T1, T2> > &e) {
+            return e.expression1 ();
+        }
+        static const typename E2::const_closure_type &rest (const vector_binary<E1, E2, scalar_plus<T1, T2> > &e) {
+            return e.expression2 ();
+        }
+    };
+
+    template<class E1, class E2, class T1, class T2>
+    struct gemv_binary_expression<E1, E2, scalar_plus<T1, T2>, false, true> {
+        static const bool value = true;
+        static const bool negate = false;
+        typedef E2 term_type;
+        typedef E1 rest_type;
+
+        static const typename E2::const_closure_type &term (const vector_binary<E1, E2, scalar_plus<T1, T2> > &e) {
+            return e.expression2 ();
+        }
+        static const typename E1::const_closure_type &rest (const vector_binary<E1, E2, scalar_plus<T1, T2> > &e) {
+            return e.expression1 ();
+        }
+    };
+
+    template<class E1, class E2, class T1, class T2, bool TERM1>
+    struct gemv_binary_expression<E1, E2, scalar_minus<T1, T2>, TERM1, true> {
+        static const bool value = true;
+        static const bool negate = true;
+        typedef E2 term_type;
+        typedef E1 rest_type;
+
+        static const typename E2::const_closure_type &term (const vector_binary<E1, E2, scalar_minus<T1, T2> > &e) {
+            return e.expression2 ();
+        }
+        static const typename E1::const_closure_type &rest (const vector_binary<E1, E2, scalar_minus<T1, T2> > &e) {
+            return e.expression1 ();
+        }
+    };
+
+    template<class E1, class E2, class F>
+    struct gemv_expression<vector_binary<E1, E2, F> >:
+        gemv_binary_expression<E1, E2, F> {};
+
+    // The assignments done with a product: v = y + alpha A x, v += y + alpha A x and v -= y + alpha A x
+    template<class F>
+    struct gemv_assignment {
+        static const bool value = false;
+    };
+
+    template<class R, class T>
+    struct gemv_assignment<scalar_assign<R, T> > {
+        static const bool value = true;
+        static const bool negate = false;
+        static const bool init = true;
+    };
+
+    template<class R, class T>
+    struct gemv_assignment<scalar_plus_assign<R, T> > {
+        static const bool value = true;
+        static const bool negate = false;
+        static const bool init = false;
+    };
+
+    template<class R, class T>
+    struct gemv_assignment<scalar_minus_assign<R, T> > {
+        static const bool value = true;
+        static const bool negate = true;
+        static const bool init = false;
+    };
+
+}}}}
+
+#endif
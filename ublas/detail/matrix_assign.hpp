@@ -14,6 +14,7 @@
 #define _BOOST_UBLAS_MATRIX_ASSIGN_
 
 #include <boost/numeric/ublas/traits.hpp>
+#include <boost/numeric/ublas/detail/parallel.hpp>
 // Required for make_conformant storage
 #include <vector>
 
@@ -612,12 +613,48 @@ namespace detail {
         }
     }
 
+#ifdef BOOST_UBLAS_USE_THREADS
+    // Explicitly indexing row major, blocks of whole rows evaluated on the thread pool
+    template<template <class T1, class T2> class F, class M, class E>
+    void parallel_matrix_assign (M &m, const matrix_expression<E> &e, row_major_tag) {
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        typedef typename M::size_type size_type;
+        size_type size1 (BOOST_UBLAS_SAME (m.size1 (), e ().size1 ()));
+        size_type size2 (BOOST_UBLAS_SAME (m.size2 (), e ().size2 ()));
+        detail::parallel_for (0, size1, 1, [&] (std::size_t first, std::size_t last) {
+            for (size_type i = first; i < last; ++ i)
+                for (size_type j = 0; j < size2; ++ j)
+                    functor_type::apply (m (i, j), e () (i, j));
+        });
+    }
+    // Explicitly indexing column major, blocks of whole columns evaluated on the thread pool
+    template<template <class T1, class T2> class F, class M, class E>
+    void parallel_matrix_assign (M &m, const matrix_expression<E> &e, column_major_tag) {
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        typedef typename M::size_type size_type;
+        size_type size2 (BOOST_UBLAS_SAME (m.size2 (), e ().size2 ()));
+        size_type size1 (BOOST_UBLAS_SAME (m.size1 (), e ().size1 ()));
+        detail::parallel_for (0, size2, 1, [&] (std::size_t first, std::size_t last) {
+            for (size_type j = first; j < last; ++ j)
+                for (size_type i = 0; i < size1; ++ i)
+                    functor_type::apply (m (i, j), e () (i, j));
+        });
+    }
+#endif
+
     // Dense (proxy) case
     template<template <class T1, class T2> class F, class R, class M, class E, class C>
     // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
     void matrix_assign (M &m, const matrix_expression<E> &e, dense_proxy_tag, C) {
         // R unnecessary, make_conformant not required
         typedef C orientation_category;
+#ifdef BOOST_UBLAS_USE_THREADS
+        // Elements are independent, so the blocks give the same results as the serial loops
+        if (parallel_policy::enabled (m.size1 () * m.size2 ())) {
+            parallel_matrix_assign<F> (m, e, orientation_category ());
+            return;
+        }
+#endif
 #ifdef BOOST_UBLAS_USE_INDEXING
         indexing_matrix_assign<F> (m, e, orientation_category ());
 #elif BOOST_UBLAS_USE_ITERATING
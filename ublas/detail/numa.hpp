@@ -0,0 +1,212 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_NUMA_
+#define _BOOST_UBLAS_NUMA_
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <boost/align/aligned_alloc.hpp>
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/detail/parallel.hpp>
+
+// Large blocks are mapped from the system page by page and placed with mbind, through libnuma
+// with BOOST_UBLAS_USE_LIBNUMA (link with -lnuma) or the system call otherwise. Without Linux, or
+// with BOOST_UBLAS_NO_NUMA, placement falls back to the first touch policy of the system.
+#if defined (__linux__) && ! defined (BOOST_UBLAS_NO_NUMA)
+#define BOOST_UBLAS_NUMA_MMAP
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#ifdef BOOST_UBLAS_USE_LIBNUMA
+#include <numa.h>
+#endif
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+
+    // Pages are first written by the threads of the pool, each one the part of the block it will process
+    struct numa_first_touch_tag {};
+    // Pages are spread round robin over the memory nodes
+    struct numa_interleave_tag {};
+
+namespace detail {
+
+    /*
+        Page placement of large dense blocks.
+
+        Linux puts a page on the memory node of the thread which first writes it. A block zeroed by one
+        thread thus lives on one node, and the threads of the other nodes are starved for bandwidth when
+        they later process their part of it. Blocks are therefore mapped without being touched, given a
+        memory policy if any, then zeroed by the threads of the pool in the chunks parallel_for hands them:
+        a loop over the rows of a matrix, split the same way, finds its rows on the node of its thread.
+        Blocks smaller than a page are not worth it and come from the heap.
+    */
+    struct numa_memory {
+        static std::size_t page_size () {
+#ifdef BOOST_UBLAS_NUMA_MMAP
+            static const std::size_t size = std::size_t (sysconf (_SC_PAGESIZE));
+            return size;
+#else
+            return 4096;
+#endif
+        }
+
+        static void *allocate (std::size_t bytes) {
+#ifdef BOOST_UBLAS_NUMA_MMAP
+            if (bytes >= page_size ()) {
+                void *p = mmap (0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p == MAP_FAILED)
+                    throw std::bad_alloc ();
+                return p;
+            }
+#endif
+            void *p = boost::alignment::aligned_alloc (64, bytes);
+            if (! p)
+                throw std::bad_alloc ();
+            return p;
+        }
+
+        static void deallocate (void *p, std::size_t bytes) {
+#ifdef BOOST_UBLAS_NUMA_MMAP
+            if (bytes >= page_size ()) {
+                munmap (p, bytes);
+                return;
+            }
+#endif
+            boost::alignment::aligned_free (p);
+        }
+
+        // Spreads the pages of a mapped block over the memory nodes the process may use.
+        // Returns false, the block keeping the default policy, when this is not supported.
+        static bool interleave (void *p, std::size_t bytes) {
+            if (bytes < page_size ())
+                return false;
+#if defined (BOOST_UBLAS_NUMA_MMAP) && defined (BOOST_UBLAS_USE_LIBNUMA)
+            if (numa_available () < 0)
+                return false;
+            numa_interleave_memory (p, bytes, numa_all_nodes_ptr);
+            return true;
+#elif defined (BOOST_UBLAS_NUMA_MMAP) && defined (SYS_mbind) && defined (SYS_get_mempolicy)
+            const int mpol_interleave = 3;
+            const unsigned long mpol_f_mems_allowed = 1 << 2;
+            unsigned long nodes [1024 / (sizeof (unsigned long) * CHAR_BIT)];
+            const unsigned long max_node = sizeof (nodes) * CHAR_BIT;
+            if (syscall (SYS_get_mempolicy, 0, nodes, max_node, 0, mpol_f_mems_allowed) != 0)
+                std::fill (nodes, nodes + sizeof (nodes) / sizeof (nodes [0]), ~0ul);
+            // The kernel reads one node less than it is told
+            return syscall (SYS_mbind, p, bytes, mpol_interleave, nodes, max_node + 1, 0) == 0;
+#else
+            return false;
+#endif
+        }
+
+        // Zeroes the n elements of the block from the threads of the pool, each one its parallel_for chunk
+        template<class T>
+        static void first_touch (T *p, std::size_t n) {
+            char *data = reinterpret_cast<char *> (p);
+            if (parallel_policy::enabled (n)) {
+                const std::size_t grain = (std::max) (page_size () / sizeof (T), std::size_t (1));
+                parallel_for (0, n, grain, [data] (std::size_t first, std::size_t last) {
+                    std::memset (data + first * sizeof (T), 0, (last - first) * sizeof (T));
+                });
+            }
+            else
+                std::memset (data, 0, n * sizeof (T));
+        }
+    };
+
+    template<class P>
+    struct numa_placement {};
+
+    template<>
+    struct numa_placement<numa_first_touch_tag> {
+        template<class T>
+        static void apply (T *p, std::size_t n) {
+            numa_memory::first_touch (p, n);
+        }
+    };
+
+    template<>
+    struct numa_placement<numa_interleave_tag> {
+        template<class T>
+        static void apply (T *p, std::size_t n) {
+            numa_memory::interleave (p, n * sizeof (T));
+            numa_memory::first_touch (p, n);
+        }
+    };
+
+}
+
+    // Allocator placing large blocks on the memory nodes of a NUMA machine, as the ALLOC of unbounded_array:
+    // matrix<double, row_major, unbounded_array<double, numa_allocator<double> > > m (size1, size2);
+    // The elements of a new block are zero. Placement P is numa_first_touch_tag or numa_interleave_tag.
+    template<class T, class P = numa_first_touch_tag>
+    class numa_allocator {
+    public:
+        typedef T value_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef P placement_category;
+
+        template<class U>
+        struct rebind {
+            typedef numa_allocator<U, P> other;
+        };
+
+        numa_allocator () {}
+        template<class U>
+        numa_allocator (const numa_allocator<U, P> &) {}
+
+        pointer allocate (size_type n, const void * = 0) {
+            if (n == 0)
+                return 0;
+            BOOST_UBLAS_CHECK (n <= max_size (), bad_size ());
+            pointer p = static_cast<pointer> (detail::numa_memory::allocate (n * sizeof (T)));
+            detail::numa_placement<P>::apply (p, n);
+            return p;
+        }
+
+        void deallocate (pointer p, size_type n) {
+            if (p)
+                detail::numa_memory::deallocate (p, n * sizeof (T));
+        }
+
+        size_type max_size () const {
+            return size_type (-1) / sizeof (T);
+        }
+
+        void construct (pointer p, const T &value) {
+            new (p) T (value);
+        }
+        void destroy (pointer p) {
+            p->~T ();
+        }
+    };
+
+    template<class T, class U, class P>
+    inline bool operator == (const numa_allocator<T, P> &, const numa_allocator<U, P> &) {
+        return true;
+    }
+
+    template<class T, class U, class P>
+    inline bool operator != (const numa_allocator<T, P> &, const numa_allocator<U, P> &) {
+        return false;
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,301 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_PACKET_
+#define _BOOST_UBLAS_PACKET_
+
+#include <cstddef>
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/traits/alignment_trait.hpp>
+
+#if UBLAS_HAS_AVX
+#include <immintrin.h>
+#elif UBLAS_HAS_SSE4
+#include <smmintrin.h>
+#elif UBLAS_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace boost { namespace numeric { namespace ublas { namespace detail {
+
+    /*
+        Packets are the SIMD registers used by the vectorized evaluators and kernels.
+        packet_traits<T> describes the packet holding values of type T: the register type, the number
+        of elements it holds and the operations on it. Types for which is_vectorizable<T> is false,
+        or for which no back end is available, get a packet of a single scalar so that every kernel
+        can be written once in terms of packets.
+
+        load/store require an address aligned to alignment, loadu/storeu accept any address.
+        madd (a, b, c) returns a * b + c and uses fused multiply-add when the target supports it.
+        The scalar and floating point packets also provide the reductions: abs, max (a, b), which returns b
+        when either is NaN, and sum (a), the sum of the elements of a.
+    */
+
+    // Scalar fallback - a packet of one element
+    template <typename T>
+    struct scalar_packet_traits {
+        typedef T type;
+        typedef T value_type;
+        static const std::size_t size = 1;
+        static const std::size_t alignment = sizeof(T);
+        static const bool vectorized = false;
+
+        static BOOST_UBLAS_INLINE type load (const T *p) { return *p; }
+        static BOOST_UBLAS_INLINE type loadu (const T *p) { return *p; }
+        static BOOST_UBLAS_INLINE void store (T *p, const type &a) { *p = a; }
+        static BOOST_UBLAS_INLINE void storeu (T *p, const type &a) { *p = a; }
+        static BOOST_UBLAS_INLINE type set1 (const T &t) { return t; }
+        static BOOST_UBLAS_INLINE type add (const type &a, const type &b) { return a + b; }
+        static BOOST_UBLAS_INLINE type sub (const type &a, const type &b) { return a - b; }
+        static BOOST_UBLAS_INLINE type mul (const type &a, const type &b) { return a * b; }
+        static BOOST_UBLAS_INLINE type madd (const type &a, const type &b, const type &c) { return a * b + c; }
+        static BOOST_UBLAS_INLINE type abs (const type &a) { return a < type () ? - a : a; }
+        static BOOST_UBLAS_INLINE type max (const type &a, const type &b) { return a > b ? a : b; }
+        static BOOST_UBLAS_INLINE T sum (const type &a) { return a; }
+    };
+
+    template <typename T, bool Vectorizable = is_vectorizable<T>::value>
+    struct packet_traits : scalar_packet_traits<T> {};
+
+#if UBLAS_HAS_AVX
+    template <>
+    struct packet_traits<double, true> {
+        typedef __m256d type;
+        typedef double value_type;
+        static const std::size_t size = 4;
+        static const std::size_t alignment = 32;
+        static const bool vectorized = true;
+
+        static BOOST_UBLAS_INLINE type load (const double *p) { return _mm256_load_pd (p); }
+        static BOOST_UBLAS_INLINE type loadu (const double *p) { return _mm256_loadu_pd (p); }
+        static BOOST_UBLAS_INLINE void store (double *p, const type &a) { _mm256_store_pd (p, a); }
+        static BOOST_UBLAS_INLINE void storeu (double *p, const type &a) { _mm256_storeu_pd (p, a); }
+        static BOOST_UBLAS_INLINE type set1 (const double &t) { return _mm256_set1_pd (t); }
+        static BOOST_UBLAS_INLINE type add (const type &a, const type &b) { return _mm256_add_pd (a, b); }
+        static BOOST_UBLAS_INLINE type sub (const type &a, const type &b) { return _mm256_sub_pd (a, b); }
+        static BOOST_UBLAS_INLINE type mul (const type &a, const type &b) { return _mm256_mul_pd (a, b); }
+#if UBLAS_HAS_FMA
+        static BOOST_UBLAS_INLINE type madd (const type &a, const type &b, const type &c) { return _mm256_fmadd_pd (a, b, c); }
+#else
+        static BOOST_UBLAS_INLINE type madd (const type &a, const type &b, const type &c) { return _mm256_add_pd (_mm256_mul_pd (a, b), c); }
+#endif
+        static BOOST_UBLAS_INLINE type abs (const type &a) { return _mm256_andnot_pd (_mm256_set1_pd (-0.0), a); }
+        static BOOST_UBLAS_INLINE type max (const type &a, const type &b) { return _mm256_max_pd (a, b); }
+        static BOOST_UBLAS_INLINE double sum (const type &a) {
+            const __m128d t = _mm_add_pd (_mm256_castpd256_pd128 (a), _mm256_extractf128_pd (a, 1));
+            return _mm_cvtsd_f64 (_mm_add_sd (t, _mm_unpackhi_pd (t, t)));
+        }
+    };
+
+    template <>
+    struct packet_traits<float, true> {
+        typedef __m256 type;
+        typedef float value_type;
+        static const std::size_t size = 8;
+        static const std::size_t alignment = 32;
+        static const bool vectorized = true;
+
+        static BOOST_UBLAS_INLINE type load (const float *p) { return _mm256_load_ps (p); }
+        static BOOST_UBLAS_INLINE type loadu (const float *p) { return _mm256_loadu_ps (p); }
+        static BOOST_UBLAS_INLINE void store (float *p, const type &a) { _mm256_store_ps (p, a); }
+        static BOOST_UBLAS_INLINE void storeu (float *p, const type &a) { _mm256_storeu_ps (p, a); }
+        static BOOST_UBLAS_INLINE type set1 (const float &t) { return _mm256_set1_ps (t); }
+        static BOOST_UBLAS_INLINE type add (const type &a, const type &b) { return _mm256_add_ps (a, b); }
+        static BOOST_UBLAS_INLINE type sub (const type &a, const type &b) { return _mm256_sub_ps (a, b); }
+        static BOOST_UBLAS_INLINE type mul (const type &a, const type &b) { return _mm256_mul_ps (a, b); }
+#if UBLAS_HAS_FMA
+        static BOOST_UBLAS_INLINE type madd (const type &a, const type &b, const type &c) { return _mm256_fmadd_ps (a, b, c); }
+#else
+        static BOOST_UBLAS_INLINE type madd (const type &a, const type &b, const type &c) { return _mm256_add_ps (_mm256_mul_ps (a, b), c); }
+#endif
+        static BOOST_UBLAS_INLINE type abs (const type &a) { return _mm256_andnot_ps (_mm256_set1_ps (-0.0f), a); }
+        static BOOST_UBLAS_INLINE type max (const type &a, const type &b) { return _mm256_max_ps (a, b); }
+        static BOOST_UBLAS_INLINE float sum (const type &a) {
+            __m128 t = _mm_add_ps (_mm256_castps256_ps128 (a), _mm256_extractf128_ps (a, 1));
+            t = _mm_add_ps (t, _mm_movehl_ps (t, t));
+            return _mm_cvtss_f32 (_mm_add_ss (t, _mm_shuffle_ps (t, t, 1)));
+        }
+    };
+#elif UBLAS_HAS_SSE2
+    template <>
+    struct packet_traits<double, true> {
+        typedef __m128d type;
+        typedef double value_type;
+        static const std::size_t size = 2;
+        static const std::size_t alignment = 16;
+        static const bool vectorized = true;
+
+        static BOOST_UBLAS_INLINE type load (const double *p) { return _mm_load_pd (p); }
+        static BOOST_UBLAS_INLINE type loadu (const double *p) { return _mm_loadu_pd (p); }
+        static BOOST_UBLAS_INLINE void store (double *p, const type &a) { _mm_store_pd (p, a); }
+        static BOOST_UBLAS_INLINE void storeu (double *p, const type &a) { _mm_storeu_pd (p, a); }
+        static BOOST_UBLAS_INLINE type set1 (const double &t) { return _mm_set1_pd (t); }
+        static BOOST_UBLAS_INLINE type add (const type &a, const type &b) { return _mm_add_pd (a, b); }
+        static BOOST_UBLAS_INLINE type sub (const type &a, const type &b) { return _mm_sub_pd (a, b); }
+        static BOOST_UBLAS_INLINE type mul (const type &a, const type &b) { return _mm_mul_pd (a, b); }
+        static BOOST_UBLAS_INLINE type madd (const type &a, const type &b, const type &c) { return _mm_add_pd (_mm_mul_pd (a, b), c); }
+        static BOOST_UBLAS_INLINE type abs (const type &a) { return _mm_andnot_pd (_mm_set1_pd (-0.0), a); }
+        static BOOST_UBLAS_INLINE type max (const type &a, const type &b) { return _mm_max_pd (a, b); }
+        static BOOST_UBLAS_INLINE double sum (const type &a) { return _mm_cvtsd_f64 (_mm_add_sd (a, _mm_unpackhi_pd (a, a))); }
+    };
+
+    template <>
+    struct packet_traits<float, true> {
+        typedef __m128 type;
+        typedef float value_type;
+        static const std::size_t size = 4;
+        static const std::size_t alignment = 16;
+        static const bool vectorized = true;
+
+        static BOOST_UBLAS_INLINE type load (const float *p) { return _mm_load_ps (p); }
+        static BOOST_UBLAS_INLINE type loadu (const float *p) { return _mm_loadu_ps (p); }
+        static BOOST_UBLAS_INLINE void store (float *p, const type &a) { _mm_store_ps (p, a); }
+        static BOOST_UBLAS_INLINE void storeu (float *p, const type &a) { _mm_storeu_ps (p, a); }
+        static BOOST_UBLAS_INLINE type set1 (const float &t) { return _mm_set1_ps (t); }
+        static BOOST_UBLAS_INLINE type add (const type &a, const type &b) { return _mm_add_ps (a, b); }
+        static BOOST_UBLAS_INLINE type sub (const type &a, const type &b) { return _mm_sub_ps (a, b); }
+        static BOOST_UBLAS_INLINE type mul (const type &a, const type &b) { return _mm_mul_ps (a, b); }
+        static BOOST_UBLAS_INLINE type madd (const type &a, const type &b, const type &c) { return _mm_add_ps (_mm_mul_ps (a, b), c); }
+        static BOOST_UBLAS_INLINE type abs (const type &a) { return _mm_andnot_ps (_mm_set1_ps (-0.0f), a); }
+        static BOOST_UBLAS_INLINE type max (const type &a, const type &b) { return _mm_max_ps (a, b); }
+        static BOOST_UBLAS_INLINE float sum (const type &a) {
+            const __m128 t = _mm_add_ps (a, _mm_movehl_ps (a, a));
+            return _mm_cvtss_f32 (_mm_add_ss (t, _mm_shuffle_ps (t, t, 1)));
+        }
+    };
+#endif
+
+    // Integer packets. There is no packed 64 bit multiply below AVX-512 and no packed 32 bit multiply
+    // below SSE4.1, those products are done lane by lane through memory.
+#if UBLAS_HAS_AVX2
+    template <typename T>
+    struct int32_packet_traits {
+        typedef __m256i type;
+        typedef T value_type;
+        static const std::size_t size = 8;
+        static const std::size_t alignment = 32;
+        static const bool vectorized = true;
+
+        static BOOST_UBLAS_INLINE type load (const T *p) { return _mm256_load_si256 (reinterpret_cast<const __m256i *> (p)); }
+        static BOOST_UBLAS_INLINE type loadu (const T *p) { return _mm256_loadu_si256 (reinterpret_cast<const __m256i *> (p)); }
+        static BOOST_UBLAS_INLINE void store (T *p, const type &a) { _mm256_store_si256 (reinterpret_cast<__m256i *> (p), a); }
+        static BOOST_UBLAS_INLINE void storeu (T *p, const type &a) { _mm256_storeu_si256 (reinterpret_cast<__m256i *> (p), a); }
+        static BOOST_UBLAS_INLINE type set1 (const T &t) { return _mm256_set1_epi32 (t); }
+        static BOOST_UBLAS_INLINE type add (const type &a, const type &b) { return _mm256_add_epi32 (a, b); }
+        static BOOST_UBLAS_INLINE type sub (const type &a, const type &b) { return _mm256_sub_epi32 (a, b); }
+        static BOOST_UBLAS_INLINE type mul (const type &a, const type &b) { return _mm256_mullo_epi32 (a, b); }
+        static BOOST_UBLAS_INLINE type madd (const type &a, const type &b, const type &c) { return add (mul (a, b), c); }
+    };
+
+    template <typename T>
+    struct int64_packet_traits {
+        typedef __m256i type;
+        typedef T value_type;
+        static const std::size_t size = 4;
+        static const std::size_t alignment = 32;
+        static const bool vectorized = true;
+
+        static BOOST_UBLAS_INLINE type load (const T *p) { return _mm256_load_si256 (reinterpret_cast<const __m256i *> (p)); }
+        static BOOST_UBLAS_INLINE type loadu (const T *p) { return _mm256_loadu_si256 (reinterpret_cast<const __m256i *> (p)); }
+        static BOOST_UBLAS_INLINE void store (T *p, const type &a) { _mm256_store_si256 (reinterpret_cast<__m256i *> (p), a); }
+        static BOOST_UBLAS_INLINE void storeu (T *p, const type &a) { _mm256_storeu_si256 (reinterpret_cast<__m256i *> (p), a); }
+        static BOOST_UBLAS_INLINE type set1 (const T &t) { return _mm256_set1_epi64x (t); }
+        static BOOST_UBLAS_INLINE type add (const type &a, const type &b) { return _mm256_add_epi64 (a, b); }
+        static BOOST_UBLAS_INLINE type sub (const type &a, const type &b) { return _mm256_sub_epi64 (a, b); }
+        static BOOST_UBLAS_INLINE type mul (const type &a, const type &b) {
+            T la [size], lb [size];
+            storeu (la, a);
+            storeu (lb, b);
+            for (std::size_t i = 0; i < size; ++i)
+                la [i] *= lb [i];
+            return loadu (la);
+        }
+        static BOOST_UBLAS_INLINE type madd (const type &a, const type &b, const type &c) { return add (mul (a, b), c); }
+    };
+#elif UBLAS_HAS_SSE2
+    template <typename T>
+    struct int32_packet_traits {
+        typedef __m128i type;
+        typedef T value_type;
+        static const std::size_t size = 4;
+        static const std::size_t alignment = 16;
+        static const bool vectorized = true;
+
+        static BOOST_UBLAS_INLINE type load (const T *p) { return _mm_load_si128 (reinterpret_cast<const __m128i *> (p)); }
+        static BOOST_UBLAS_INLINE type loadu (const T *p) { return _mm_loadu_si128 (reinterpret_cast<const __m128i *> (p)); }
+        static BOOST_UBLAS_INLINE void store (T *p, const type &a) { _mm_store_si128 (reinterpret_cast<__m128i *> (p), a); }
+        static BOOST_UBLAS_INLINE void storeu (T *p, const type &a) { _mm_storeu_si128 (reinterpret_cast<__m128i *> (p), a); }
+        static BOOST_UBLAS_INLINE type set1 (const T &t) { return _mm_set1_epi32 (t); }
+        static BOOST_UBLAS_INLINE type add (const type &a, const type &b) { return _mm_add_epi32 (a, b); }
+        static BOOST_UBLAS_INLINE type sub (const type &a, const type &b) { return _mm_sub_epi32 (a, b); }
+#if UBLAS_HAS_SSE4
+        static BOOST_UBLAS_INLINE type mul (const type &a, const type &b) { return _mm_mullo_epi32 (a, b); }
+#else
+        static BOOST_UBLAS_INLINE type mul (const type &a, const type &b) {
+            T la [size], lb [size];
+            storeu (la, a);
+            storeu (lb, b);
+            for (std::size_t i = 0; i < size; ++i)
+                la [i] *= lb [i];
+            return loadu (la);
+        }
+#endif
+        static BOOST_UBLAS_INLINE type madd (const type &a, const type &b, const type &c) { return add (mul (a, b), c); }
+    };
+
+    template <typename T>
+    struct int64_packet_traits {
+        typedef __m128i type;
+        typedef T value_type;
+        static const std::size_t size = 2;
+        static const std::size_t alignment = 16;
+        static const bool vectorized = true;
+
+        static BOOST_UBLAS_INLINE type load (const T *p) { return _mm_load_si128 (reinterpret_cast<const __m128i *> (p)); }
+        static BOOST_UBLAS_INLINE type loadu (const T *p) { return _mm_loadu_si128 (reinterpret_cast<const __m128i *> (p)); }
+        static BOOST_UBLAS_INLINE void store (T *p, const type &a) { _mm_store_si128 (reinterpret_cast<__m128i *> (p), a); }
+        static BOOST_UBLAS_INLINE void storeu (T *p, const type &a) { _mm_storeu_si128 (reinterpret_cast<__m128i *> (p), a); }
+        static BOOST_UBLAS_INLINE type set1 (const T &t) { return _mm_set1_epi64x (t); }
+        static BOOST_UBLAS_INLINE type add (const type &a, const type &b) { return _mm_add_epi64 (a, b); }
+        static BOOST_UBLAS_INLINE type sub (const type &a, const type &b) { return _mm_sub_epi64 (a, b); }
+        static BOOST_UBLAS_INLINE type mul (const type &a, const type &b) {
+            T la [size], lb [size];
+            storeu (la, a);
+            storeu (lb, b);
+            for (std::size_t i = 0; i < size; ++i)
+                la [i] *= lb [i];
+            return loadu (la);
+        }
+        static BOOST_UBLAS_INLINE type madd (const type &a, const type &b, const type &c) { return add (mul (a, b), c); }
+    };
+#endif
+
+#if UBLAS_HAS_SSE2
+    template <typename T, std::size_t Size = sizeof(T)>
+    struct integer_packet_traits : scalar_packet_traits<T> {};
+
+    template <typename T>
+    struct integer_packet_traits<T, 4> : int32_packet_traits<T> {};
+
+    template <typename T>
+    struct integer_packet_traits<T, 8> : int64_packet_traits<T> {};
+
+    template <>
+    struct packet_traits<int, true> : integer_packet_traits<int> {};
+
+    template <>
+    struct packet_traits<long int, true> : integer_packet_traits<long int> {};
+
+    template <>
+    struct packet_traits<long long int, true> : integer_packet_traits<long long int> {};
+#endif
+
+}}}}
+
+#endif
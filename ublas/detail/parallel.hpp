@@ -0,0 +1,476 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_PARALLEL_
+#define _BOOST_UBLAS_PARALLEL_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/exception.hpp>
+
+#ifdef BOOST_UBLAS_USE_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#if defined (BOOST_UBLAS_BIND_THREADS) && defined (__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+
+    /*
+        Run time settings of the multi-threaded evaluation.
+
+        Parallel evaluation is opt-in: it is only compiled with BOOST_UBLAS_USE_THREADS, and even then
+        an assignment is split only when its destination has at least threshold () elements.
+        num_threads () counts the calling thread, so 1 means serial evaluation.
+    */
+    class parallel_policy {
+    public:
+        static std::size_t num_threads () {
+#ifdef BOOST_UBLAS_USE_THREADS
+            return threads ();
+#else
+            return 1;
+#endif
+        }
+        static void set_num_threads (std::size_t n) {
+            threads () = n > 0 ? n : 1;
+        }
+        static std::size_t threshold () {
+            return threshold_value ();
+        }
+        static void set_threshold (std::size_t n) {
+            threshold_value () = n;
+        }
+        // Whether an operation touching size elements should be split across threads.
+        static bool enabled (std::size_t size) {
+            return num_threads () > 1 && size >= threshold ();
+        }
+
+    private:
+        static std::size_t &threads () {
+#ifdef BOOST_UBLAS_USE_THREADS
+            static std::size_t n = (std::max) (std::thread::hardware_concurrency (), 1u);
+#else
+            static std::size_t n = 1;
+#endif
+            return n;
+        }
+        static std::size_t &threshold_value () {
+            static std::size_t n = BOOST_UBLAS_PARALLEL_THRESHOLD;
+            return n;
+        }
+    };
+
+namespace detail {
+
+#ifdef BOOST_UBLAS_USE_THREADS
+
+    /*
+        Persistent pool of worker threads running one job at a time.
+
+        A job is a number of independent tasks handed out through an atomic counter; the calling thread
+        takes part in the job and returns once every task has finished. A job started from inside a task
+        runs serially on the current thread, so nested parallel loops cannot dead lock the pool.
+        The first exception thrown by a task is rethrown in the calling thread.
+
+        Workers are numbered from 1 in the order they are created, the calling thread being 0. A pinned job
+        runs its task t on thread t, so that successive pinned jobs hand the same part of a range to the same
+        thread: its caches stay warm and, on NUMA machines, the pages it first touched stay local to it.
+        With BOOST_UBLAS_BIND_THREADS every worker is also bound to one of the processors the process may
+        run on (Linux only), which keeps the threads on their memory node.
+    */
+    class thread_pool {
+    private:
+        struct job {
+            job (std::size_t count, const std::function<void (std::size_t)> &task, std::size_t slots, bool pinned):
+                count (count), task (task), next (0), slots (slots), active (0), pinned (pinned), taken (pinned ? count : 0, false) {}
+
+            // Whether worker index has something to do, the mutex of the pool being held
+            bool wants (std::size_t index) const {
+                return pinned ? index < count && ! taken [index] : slots > 0;
+            }
+            void take (std::size_t index) {
+                if (pinned)
+                    taken [index] = true;
+                -- slots;
+            }
+
+            const std::size_t count;
+            const std::function<void (std::size_t)> &task;
+            std::atomic<std::size_t> next;
+            std::size_t slots;
+            std::size_t active;
+            const bool pinned;
+            std::vector<bool> taken;
+            std::exception_ptr error;
+        };
+
+    public:
+        static thread_pool &instance () {
+            static thread_pool pool;
+            return pool;
+        }
+
+        thread_pool (): job_ (0), stop_ (false) {}
+
+        ~thread_pool () {
+            {
+                std::lock_guard<std::mutex> lock (mutex_);
+                stop_ = true;
+            }
+            wake_.notify_all ();
+            for (std::size_t i = 0; i < workers_.size (); ++ i)
+                workers_ [i].join ();
+        }
+
+        // Calls task (t) for every t in [0, count) on at most concurrency threads, the calling one included.
+        template<class F>
+        void run (std::size_t count, std::size_t concurrency, const F &task) {
+            if (count == 0)
+                return;
+            if (count == 1 || concurrency <= 1 || inside ()) {
+                for (std::size_t t = 0; t < count; ++ t)
+                    task (t);
+                return;
+            }
+
+            std::lock_guard<std::mutex> run_lock (run_mutex_);
+            const std::size_t helpers = (std::min) (concurrency, count) - 1;
+            grow (helpers);
+
+            const std::function<void (std::size_t)> function (std::cref (task));
+            job j (count, function, helpers, false);
+            execute (j);
+        }
+
+        // Calls task (t) on thread t of the pool for every t in [0, count), the calling thread being 0.
+        template<class F>
+        void run_pinned (std::size_t count, const F &task) {
+            if (count == 0)
+                return;
+            if (count == 1 || inside ()) {
+                for (std::size_t t = 0; t < count; ++ t)
+                    task (t);
+                return;
+            }
+
+            std::lock_guard<std::mutex> run_lock (run_mutex_);
+            grow (count - 1);
+
+            const std::function<void (std::size_t)> function (std::cref (task));
+            job j (count, function, count - 1, true);
+            j.taken [0] = true;
+            execute (j);
+        }
+
+        // Whether the current thread is executing a task of the pool.
+        static bool &inside () {
+            static thread_local bool flag = false;
+            return flag;
+        }
+
+    private:
+        thread_pool (const thread_pool &);
+        thread_pool &operator = (const thread_pool &);
+
+        void grow (std::size_t helpers) {
+            while (workers_.size () < helpers)
+                workers_.push_back (std::thread (&thread_pool::worker, this, workers_.size () + 1));
+        }
+
+        // Hands the job to the workers, takes part in it and waits until it is done.
+        // A pinned job is only over once every worker it names has run its task.
+        void execute (job &j) {
+            {
+                std::lock_guard<std::mutex> lock (mutex_);
+                job_ = &j;
+            }
+            wake_.notify_all ();
+
+            work (j, 0);
+
+            std::unique_lock<std::mutex> lock (mutex_);
+            if (! j.pinned)
+                job_ = 0;
+            done_.wait (lock, [&j] { return j.active == 0 && (! j.pinned || j.slots == 0); });
+            job_ = 0;
+            if (j.error)
+                std::rethrow_exception (j.error);
+        }
+
+        void worker (std::size_t index) {
+#if defined (BOOST_UBLAS_BIND_THREADS) && defined (__linux__)
+            bind (index);
+#endif
+            std::unique_lock<std::mutex> lock (mutex_);
+            for (;;) {
+                wake_.wait (lock, [this, index] { return stop_ || (job_ != 0 && job_->wants (index)); });
+                if (stop_)
+                    return;
+                job *j = job_;
+                j->take (index);
+                ++ j->active;
+                lock.unlock ();
+                work (*j, index);
+                lock.lock ();
+                if (-- j->active == 0)
+                    done_.notify_all ();
+            }
+        }
+
+        void work (job &j, std::size_t index) {
+            const bool was_inside = inside ();
+            inside () = true;
+            if (j.pinned)
+                call (j, index);
+            else
+                for (;;) {
+                    const std::size_t t = j.next.fetch_add (1);
+                    if (t >= j.count)
+                        break;
+                    call (j, t);
+                }
+            inside () = was_inside;
+        }
+
+        void call (job &j, std::size_t t) {
+            try {
+                j.task (t);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock (mutex_);
+                if (! j.error)
+                    j.error = std::current_exception ();
+            }
+        }
+
+#if defined (BOOST_UBLAS_BIND_THREADS) && defined (__linux__)
+        // Binds the current thread to the index-th processor, modulo their number, of those it may run on
+        static void bind (std::size_t index) {
+            cpu_set_t allowed;
+            if (sched_getaffinity (0, sizeof (allowed), &allowed) != 0)
+                return;
+            const std::size_t count = CPU_COUNT (&allowed);
+            if (count == 0)
+                return;
+            std::size_t n = index % count;
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++ cpu)
+                if (CPU_ISSET (cpu, &allowed) && n -- == 0) {
+                    cpu_set_t set;
+                    CPU_ZERO (&set);
+                    CPU_SET (cpu, &set);
+                    pthread_setaffinity_np (pthread_self (), sizeof (set), &set);
+                    return;
+                }
+        }
+#endif
+
+        std::vector<std::thread> workers_;
+        std::mutex run_mutex_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable done_;
+        job *job_;
+        bool stop_;
+    };
+
+#endif
+
+    /*
+        Graph of tasks with dependencies, run by a work-stealing scheduler.
+
+        Tasks are added in an order compatible with their dependencies: a task may only depend on tasks
+        added before it, so running them in the order they were added is always valid, and is what happens
+        without BOOST_UBLAS_USE_THREADS or on one thread. Otherwise every thread of the pool owns a deque of
+        ready tasks: it pushes and pops the tasks it makes ready at the back, which keeps the data of the task
+        it just ran in cache, and when it runs dry it steals the oldest task from the front of another deque.
+        The first exception thrown by a task stops the scheduling and is rethrown by run.
+    */
+    class task_graph {
+    public:
+        typedef std::size_t task_id;
+
+        template<class F>
+        task_id add (const F &f) {
+            tasks_.push_back (std::function<void ()> (f));
+            successors_.push_back (std::vector<task_id> ());
+            predecessors_.push_back (0);
+            return tasks_.size () - 1;
+        }
+
+        // after cannot start before before has finished
+        void depend (task_id before, task_id after) {
+            BOOST_UBLAS_CHECK (before < after && after < tasks_.size (), bad_argument ());
+            successors_ [before].push_back (after);
+            ++ predecessors_ [after];
+        }
+
+        std::size_t size () const {
+            return tasks_.size ();
+        }
+
+        // Runs every task on at most concurrency threads, the calling one included.
+        void run (std::size_t concurrency = parallel_policy::num_threads ()) {
+#ifdef BOOST_UBLAS_USE_THREADS
+            concurrency = (std::min) (concurrency, tasks_.size ());
+            if (concurrency > 1 && ! thread_pool::inside ()) {
+                scheduler s (*this, concurrency);
+                thread_pool::instance ().run (concurrency, concurrency, [&s] (std::size_t w) { s.work (w); });
+                if (s.error)
+                    std::rethrow_exception (s.error);
+                return;
+            }
+#else
+            (void) concurrency;
+#endif
+            for (task_id t = 0; t < tasks_.size (); ++ t)
+                tasks_ [t] ();
+        }
+
+    private:
+#ifdef BOOST_UBLAS_USE_THREADS
+        struct queue {
+            std::mutex mutex;
+            std::deque<task_id> tasks;
+        };
+
+        struct scheduler {
+            scheduler (task_graph &g, std::size_t workers):
+                graph (g), pending (new std::atomic<std::size_t> [g.size ()]), queues (workers),
+                remaining (g.size ()), failed (false) {
+                std::size_t w = 0;
+                for (task_id t = 0; t < g.size (); ++ t) {
+                    pending [t] = g.predecessors_ [t];
+                    if (g.predecessors_ [t] == 0)
+                        queues [w ++ % workers].tasks.push_back (t);
+                }
+            }
+
+            bool pop (std::size_t w, task_id &t) {
+                queue &q = queues [w];
+                std::lock_guard<std::mutex> lock (q.mutex);
+                if (q.tasks.empty ())
+                    return false;
+                t = q.tasks.back ();
+                q.tasks.pop_back ();
+                return true;
+            }
+
+            bool steal (std::size_t w, task_id &t) {
+                for (std::size_t i = 1; i < queues.size (); ++ i) {
+                    queue &q = queues [(w + i) % queues.size ()];
+                    std::lock_guard<std::mutex> lock (q.mutex);
+                    if (! q.tasks.empty ()) {
+                        t = q.tasks.front ();
+                        q.tasks.pop_front ();
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void work (std::size_t w) {
+                task_id t;
+                while (remaining.load () != 0 && ! failed.load ()) {
+                    if (! pop (w, t) && ! steal (w, t)) {
+                        std::this_thread::yield ();
+                        continue;
+                    }
+                    try {
+                        graph.tasks_ [t] ();
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock (error_mutex);
+                        if (! error)
+                            error = std::current_exception ();
+                        failed = true;
+                        return;
+                    }
+                    const std::vector<task_id> &next = graph.successors_ [t];
+                    for (std::size_t i = 0; i < next.size (); ++ i)
+                        if (-- pending [next [i]] == 0) {
+                            std::lock_guard<std::mutex> lock (queues [w].mutex);
+                            queues [w].tasks.push_back (next [i]);
+                        }
+                    -- remaining;
+                }
+            }
+
+            task_graph &graph;
+            std::unique_ptr<std::atomic<std::size_t> []> pending;
+            std::vector<queue> queues;
+            std::atomic<std::size_t> remaining;
+            std::atomic<bool> failed;
+            std::mutex error_mutex;
+            std::exception_ptr error;
+        };
+#endif
+
+        std::vector<std::function<void ()> > tasks_;
+        std::vector<std::vector<task_id> > successors_;
+        std::vector<std::size_t> predecessors_;
+    };
+
+    // Splits [0, size) into parts ranges of about the same weight, index1 holding the running sums of the
+    // weights like the row pointers of a compressed matrix do. Range p is [bounds [p], bounds [p + 1]).
+    template<class IA>
+    BOOST_UBLAS_INLINE
+    void nonzero_partition (const IA &index1, std::size_t size, std::size_t parts, std::vector<std::size_t> &bounds) {
+        const std::size_t first = index1 [0];
+        const std::size_t nnz = index1 [size] - first;
+        bounds.resize (parts + 1);
+        bounds [0] = 0;
+        for (std::size_t p = 1; p < parts; ++ p) {
+            const std::size_t target = first + nnz / parts * p + nnz % parts * p / parts;
+            bounds [p] = std::lower_bound (index1.begin () + bounds [p - 1], index1.begin () + size, target) - index1.begin ();
+        }
+        bounds [parts] = size;
+    }
+
+    // Splits [first, last) into at most parallel_policy::num_threads () contiguous chunks and calls
+    // f (begin, end) for each of them. Chunk boundaries lie on multiples of grain counted from first,
+    // so callers can keep every chunk aligned to packets or cache lines. Chunk t runs on thread t of
+    // the pool, so loops splitting the same range the same way hand each thread the same chunk.
+    template<class F>
+    void parallel_for (std::size_t first, std::size_t last, std::size_t grain, const F &f) {
+        if (first >= last)
+            return;
+#ifdef BOOST_UBLAS_USE_THREADS
+        grain = (std::max) (grain, std::size_t (1));
+        const std::size_t grains = (last - first + grain - 1) / grain;
+        const std::size_t tasks = (std::min) (grains, parallel_policy::num_threads ());
+        if (tasks > 1) {
+            const std::size_t chunk = (grains + tasks - 1) / tasks * grain;
+            thread_pool::instance ().run_pinned (tasks, [&] (std::size_t t) {
+                const std::size_t begin = first + t * chunk;
+                if (begin < last)
+                    f (begin, (std::min) (begin + chunk, last));
+            });
+            return;
+        }
+#else
+        (void) grain;
+#endif
+        f (first, last);
+    }
+
+}
+
+}}}
+
+#endif
@@ -0,0 +1,187 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_RADIX_SORT_
+#define _BOOST_UBLAS_RADIX_SORT_
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <vector>
+#include <boost/numeric/ublas/detail/parallel.hpp>
+
+// Bits of the key sorted by each pass of the radix sort
+#ifndef BOOST_UBLAS_RADIX_SORT_DIGIT
+#define BOOST_UBLAS_RADIX_SORT_DIGIT 11
+#endif
+
+namespace boost { namespace numeric { namespace ublas { namespace detail {
+
+    /*
+        Sorting of coordinate storage.
+
+        The elements of a coordinate_vector or coordinate_matrix are sorted on a single key, the index of
+        a vector or the major index followed by the minor index of a matrix, packed into a std::size_t.
+        The pairs of key and position of the elements are sorted by a least significant digit radix sort,
+        BOOST_UBLAS_RADIX_SORT_DIGIT bits per pass between the pairs and a buffer of the same size, passes
+        whose digit is the same for all the elements being skipped. Only the elements appended since the
+        last sort are sorted, then merged after the sorted ones. Both sort and merge are stable, so that
+        duplicates are summed in the order they were appended. The sorted elements are finally written
+        back, their values gathered from their positions and the duplicates summed on the way.
+
+        The pairs are split over the threads of parallel_policy, each thread counting then scattering its
+        part of the pairs at every pass, and writing back its part of the keys.
+    */
+
+    struct radix_element {
+        std::size_t key;
+        std::size_t position;
+    };
+
+    inline bool operator < (const radix_element &e1, const radix_element &e2) {
+        return e1.key < e2.key;
+    }
+
+    // Bits of the indices [0, size)
+    inline std::size_t radix_bits (std::size_t size) {
+        std::size_t bits = 0;
+        for (; size > 1 && bits < sizeof (std::size_t) * CHAR_BIT; size = (size + 1) / 2)
+            ++ bits;
+        return bits;
+    }
+
+    // Whether keys of the given bits fit in a std::size_t
+    inline bool radix_key_fits (std::size_t bits) {
+        return bits < sizeof (std::size_t) * CHAR_BIT;
+    }
+
+    inline std::size_t radix_parts (std::size_t size) {
+        return parallel_policy::enabled (size) ? (std::max) ((std::min) (parallel_policy::num_threads (), size >> BOOST_UBLAS_RADIX_SORT_DIGIT), std::size_t (1)) : 1;
+    }
+
+    inline std::size_t radix_bound (std::size_t size, std::size_t p, std::size_t parts) {
+        return size / parts * p + size % parts * p / parts;
+    }
+
+    // Sorts the n elements of a on the low bits of their keys, with the n elements of buffer as scratch
+    // space. Returns a or buffer, whichever holds the sorted elements.
+    inline radix_element *radix_sort (radix_element *a, radix_element *buffer, std::size_t n, std::size_t bits) {
+        const std::size_t radix = std::size_t (1) << BOOST_UBLAS_RADIX_SORT_DIGIT;
+        const std::size_t parts = radix_parts (n);
+        std::vector<std::size_t> count (parts * radix);
+
+        for (std::size_t shift = 0; shift < bits; shift += BOOST_UBLAS_RADIX_SORT_DIGIT) {
+            std::fill (count.begin (), count.end (), 0);
+            parallel_for (0, parts, 1, [&] (std::size_t first, std::size_t last) {
+                for (std::size_t p = first; p < last; ++ p) {
+                    std::size_t *c = &count [p * radix];
+                    for (std::size_t k = radix_bound (n, p, parts); k < radix_bound (n, p + 1, parts); ++ k)
+                        ++ c [(a [k].key >> shift) & (radix - 1)];
+                }
+            });
+
+            // Positions of the digits, part after part within a digit
+            std::size_t sum = 0, used = 0;
+            for (std::size_t d = 0; d < radix; ++ d) {
+                const std::size_t before = sum;
+                for (std::size_t p = 0; p < parts; ++ p) {
+                    const std::size_t c = count [p * radix + d];
+                    count [p * radix + d] = sum;
+                    sum += c;
+                }
+                used += sum != before;
+            }
+            if (used <= 1)
+                continue;
+
+            parallel_for (0, parts, 1, [&] (std::size_t first, std::size_t last) {
+                for (std::size_t p = first; p < last; ++ p) {
+                    std::size_t *c = &count [p * radix];
+                    for (std::size_t k = radix_bound (n, p, parts); k < radix_bound (n, p + 1, parts); ++ k)
+                        buffer [c [(a [k].key >> shift) & (radix - 1)] ++] = a [k];
+                }
+            });
+            std::swap (a, buffer);
+        }
+        return a;
+    }
+
+    // Sorts the keys of the elements [0, filled), those of [0, sorted) being already sorted without duplicates,
+    // and writes them back without duplicates. key (k) is the key of element k and store (q, key, k, first)
+    // writes element q with the value of element k, first telling whether q was just started or k adds to it.
+    // Returns the number of elements left.
+    template<class K, class S>
+    std::size_t radix_sort_elements (std::size_t sorted, std::size_t filled, std::size_t bits, const K &key, const S &store) {
+        std::vector<radix_element> a (filled), buffer (filled - sorted);
+        const std::size_t parts = radix_parts (filled);
+        parallel_for (0, parts, 1, [&] (std::size_t first, std::size_t last) {
+            for (std::size_t k = radix_bound (filled, first, parts); k < radix_bound (filled, last, parts); ++ k) {
+                a [k].key = key (k);
+                a [k].position = k;
+            }
+        });
+
+        if (sorted < filled) {
+            radix_element *tail = radix_sort (&a [sorted], &buffer [0], filled - sorted, bits);
+            if (sorted > 0) {
+                // Merged from the back, the sorted elements first among equal keys
+                if (tail != &buffer [0])
+                    std::copy (a.begin () + sorted, a.end (), buffer.begin ());
+                std::size_t i = sorted, j = filled - sorted, k = filled;
+                while (j > 0) {
+                    if (i > 0 && buffer [j - 1].key < a [i - 1].key)
+                        a [-- k] = a [-- i];
+                    else
+                        a [-- k] = buffer [-- j];
+                }
+            }
+            else if (tail != &a [0]) {
+                a.swap (buffer);
+            }
+        }
+        std::vector<radix_element> ().swap (buffer);
+
+        // Parts start on a new key, and their first element on the number of keys before them
+        std::vector<std::size_t> bounds (parts + 1), offset (parts + 1);
+        for (std::size_t p = 1; p < parts; ++ p) {
+            std::size_t b = (std::max) (radix_bound (filled, p, parts), bounds [p - 1]);
+            while (b > 0 && b < filled && a [b].key == a [b - 1].key)
+                ++ b;
+            bounds [p] = b;
+        }
+        bounds [parts] = filled;
+        parallel_for (0, parts, 1, [&] (std::size_t first, std::size_t last) {
+            for (std::size_t p = first; p < last; ++ p) {
+                std::size_t keys = 0;
+                for (std::size_t k = bounds [p]; k < bounds [p + 1]; ++ k)
+                    keys += k == bounds [p] || a [k].key != a [k - 1].key;
+                offset [p + 1] = keys;
+            }
+        });
+        offset [0] = 0;
+        for (std::size_t p = 0; p < parts; ++ p)
+            offset [p + 1] += offset [p];
+
+        parallel_for (0, parts, 1, [&] (std::size_t first, std::size_t last) {
+            for (std::size_t p = first; p < last; ++ p) {
+                std::size_t q = offset [p];
+                for (std::size_t k = bounds [p]; k < bounds [p + 1]; ++ k) {
+                    const bool start = k == bounds [p] || a [k].key != a [k - 1].key;
+                    if (start && k != bounds [p])
+                        ++ q;
+                    store (q, a [k].key, a [k].position, start);
+                }
+            }
+        });
+        return offset [parts];
+    }
+
+}}}}
+
+#endif
@@ -0,0 +1,444 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_REDUCE_
+#define _BOOST_UBLAS_REDUCE_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_floating_point.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/numeric/ublas/fwd.hpp>
+#include <boost/numeric/ublas/traits.hpp>
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/detail/packet.hpp>
+#include <boost/numeric/ublas/detail/parallel.hpp>
+
+// Below this number of elements a reduction stays on the calling thread
+#ifndef BOOST_UBLAS_PARALLEL_REDUCTION_THRESHOLD
+#define BOOST_UBLAS_PARALLEL_REDUCTION_THRESHOLD 262144
+#endif
+
+namespace boost { namespace numeric { namespace ublas { namespace detail {
+
+    /*
+        Reductions over the storage of dense vector operands: sum, norms and inner product.
+
+        A single accumulator makes every addition wait for the previous one, so a reduction runs at one
+        element per floating point latency whatever the width of the machine. These kernels keep four
+        independent accumulators: four packets for contiguous float and double operands, four scalars for
+        strided operands and the other types, combined once at the end. The order of the additions differs
+        from the element by element loop, and so may the last bits of the result.
+
+        Operands of at least BOOST_UBLAS_PARALLEL_REDUCTION_THRESHOLD elements are split into one part per
+        thread of parallel_policy, whose partial results are combined in order: the result only depends
+        on the number of threads.
+    */
+
+    // size elements stride apart from data
+    template<class T>
+    struct strided_vector_view {
+        strided_vector_view (const T *data, std::size_t size, std::ptrdiff_t stride):
+            data (data), size (size), stride (stride) {}
+
+        strided_vector_view part (std::size_t first, std::size_t last) const {
+            return strided_vector_view (data + std::ptrdiff_t (first) * stride, last - first, stride);
+        }
+
+        const T *data;
+        std::size_t size;
+        std::ptrdiff_t stride;
+    };
+
+    // Storage of the dense matrices, with the strides between rows and columns
+    template<class M>
+    struct matrix_storage {
+        static const bool value = false;
+        typedef void value_type;
+    };
+
+    template<class M>
+    struct matrix_storage<const M>:
+        matrix_storage<M> {};
+
+    template<class T, class L, class A>
+    struct matrix_storage<matrix<T, L, A> > {
+        static const bool value = true;
+        typedef T value_type;
+
+        static const T *data (const matrix<T, L, A> &m) {
+            return m.data ().size () ? &m.data () [0] : 0;
+        }
+        static std::ptrdiff_t stride1 (const matrix<T, L, A> &m) {
+            return stride1 (m, typename L::orientation_category ());
+        }
+        static std::ptrdiff_t stride2 (const matrix<T, L, A> &m) {
+            return stride2 (m, typename L::orientation_category ());
+        }
+
+    private:
+        static std::ptrdiff_t stride1 (const matrix<T, L, A> &m, row_major_tag) {
+            return m.size2 ();
+        }
+        static std::ptrdiff_t stride1 (const matrix<T, L, A> &, column_major_tag) {
+            return 1;
+        }
+        static std::ptrdiff_t stride2 (const matrix<T, L, A> &, row_major_tag) {
+            return 1;
+        }
+        static std::ptrdiff_t stride2 (const matrix<T, L, A> &m, column_major_tag) {
+            return m.size1 ();
+        }
+    };
+
+    template<class M>
+    struct matrix_storage<matrix_reference<M> > {
+        static const bool value = matrix_storage<M>::value;
+        typedef typename matrix_storage<M>::value_type value_type;
+
+        static const value_type *data (const matrix_reference<M> &m) {
+            return matrix_storage<M>::data (m.expression ());
+        }
+        static std::ptrdiff_t stride1 (const matrix_reference<M> &m) {
+            return matrix_storage<M>::stride1 (m.expression ());
+        }
+        static std::ptrdiff_t stride2 (const matrix_reference<M> &m) {
+            return matrix_storage<M>::stride2 (m.expression ());
+        }
+    };
+
+    template<class M>
+    struct matrix_storage<matrix_range<M> > {
+        typedef typename matrix_range<M>::matrix_closure_type closure_type;
+        static const bool value = matrix_storage<closure_type>::value;
+        typedef typename matrix_storage<closure_type>::value_type value_type;
+
+        static const value_type *data (const matrix_range<M> &m) {
+            return matrix_storage<closure_type>::data (m.data ()) + m.start1 () * stride1 (m) + m.start2 () * stride2 (m);
+        }
+        static std::ptrdiff_t stride1 (const matrix_range<M> &m) {
+            return matrix_storage<closure_type>::stride1 (m.data ());
+        }
+        static std::ptrdiff_t stride2 (const matrix_range<M> &m) {
+            return matrix_storage<closure_type>::stride2 (m.data ());
+        }
+    };
+
+    template<class M>
+    struct matrix_storage<matrix_slice<M> > {
+        typedef typename matrix_slice<M>::matrix_closure_type closure_type;
+        static const bool value = matrix_storage<closure_type>::value;
+        typedef typename matrix_storage<closure_type>::value_type value_type;
+
+        static const value_type *data (const matrix_slice<M> &m) {
+            return matrix_storage<closure_type>::data (m.data ()) +
+                   m.start1 () * matrix_storage<closure_type>::stride1 (m.data ()) +
+                   m.start2 () * matrix_storage<closure_type>::stride2 (m.data ());
+        }
+        static std::ptrdiff_t stride1 (const matrix_slice<M> &m) {
+            return matrix_storage<closure_type>::stride1 (m.data ()) * m.stride1 ();
+        }
+        static std::ptrdiff_t stride2 (const matrix_slice<M> &m) {
+            return matrix_storage<closure_type>::stride2 (m.data ()) * m.stride2 ();
+        }
+    };
+
+    // Storage of the dense vector operands: vectors, their ranges and slices, and the rows and columns
+    // of dense matrices, through references or not
+    template<class V>
+    struct vector_storage {
+        static const bool value = false;
+        typedef void value_type;
+    };
+
+    template<class V>
+    struct vector_storage<const V>:
+        vector_storage<V> {};
+
+    template<class T, class A>
+    struct vector_storage<vector<T, A> > {
+        static const bool value = true;
+        typedef T value_type;
+
+        static strided_vector_view<T> view (const vector<T, A> &v) {
+            return strided_vector_view<T> (v.size () ? &v.data () [0] : 0, v.size (), 1);
+        }
+    };
+
+    template<class V>
+    struct vector_storage<vector_reference<V> > {
+        static const bool value = vector_storage<V>::value;
+        typedef typename vector_storage<V>::value_type value_type;
+
+        static strided_vector_view<value_type> view (const vector_reference<V> &v) {
+            return vector_storage<V>::view (v.expression ());
+        }
+    };
+
+    template<class V>
+    struct vector_storage<vector_range<V> > {
+        typedef typename vector_range<V>::vector_closure_type closure_type;
+        static const bool value = vector_storage<closure_type>::value;
+        typedef typename vector_storage<closure_type>::value_type value_type;
+
+        static strided_vector_view<value_type> view (const vector_range<V> &v) {
+            return vector_storage<closure_type>::view (v.data ()).part (v.start (), v.start () + v.size ());
+        }
+    };
+
+    template<class V>
+    struct vector_storage<vector_slice<V> > {
+        typedef typename vector_slice<V>::vector_closure_type closure_type;
+        static const bool value = vector_storage<closure_type>::value;
+        typedef typename vector_storage<closure_type>::value_type value_type;
+
+        static strided_vector_view<value_type> view (const vector_slice<V> &v) {
+            const strided_vector_view<value_type> base (vector_storage<closure_type>::view (v.data ()));
+            return strided_vector_view<value_type> (base.data + std::ptrdiff_t (v.start ()) * base.stride, v.size (), base.stride * v.stride ());
+        }
+    };
+
+    template<class M>
+    struct vector_storage<matrix_row<M> > {
+        typedef typename matrix_row<M>::matrix_closure_type closure_type;
+        static const bool value = matrix_storage<closure_type>::value;
+        typedef typename matrix_storage<closure_type>::value_type value_type;
+
+        static strided_vector_view<value_type> view (const matrix_row<M> &r) {
+            const value_type *data = matrix_storage<closure_type>::data (r.data ());
+            return strided_vector_view<value_type> (data ? data + std::ptrdiff_t (r.index ()) * matrix_storage<closure_type>::stride1 (r.data ()) : data,
+                                                    r.size (), matrix_storage<closure_type>::stride2 (r.data ()));
+        }
+    };
+
+    template<class M>
+    struct vector_storage<matrix_column<M> > {
+        typedef typename matrix_column<M>::matrix_closure_type closure_type;
+        static const bool value = matrix_storage<closure_type>::value;
+        typedef typename matrix_storage<closure_type>::value_type value_type;
+
+        static strided_vector_view<value_type> view (const matrix_column<M> &c) {
+            const value_type *data = matrix_storage<closure_type>::data (c.data ());
+            return strided_vector_view<value_type> (data ? data + std::ptrdiff_t (c.index ()) * matrix_storage<closure_type>::stride2 (c.data ()) : data,
+                                                    c.size (), matrix_storage<closure_type>::stride1 (c.data ()));
+        }
+    };
+
+    // Whether the reduction of T into R runs on packets
+    template<class T, class R>
+    struct packet_reduction {
+        static const bool value = packet_traits<T>::vectorized && boost::is_floating_point<T>::value && boost::is_same<T, R>::value;
+    };
+
+    // The reductions: r = reduce (r, f (x)) for every element x, from r = init ()
+    template<class T, class R>
+    struct sum_reduction {
+        typedef packet_traits<T> packet_type;
+        typedef typename packet_type::type packet;
+
+        static R init () { return R (); }
+        static void apply (R &r, const T &x) { r += x; }
+        static R combine (const R &r1, const R &r2) { return r1 + r2; }
+        static packet packet_apply (const packet &r, const packet &x) { return packet_type::add (r, x); }
+        static packet packet_combine (const packet &r1, const packet &r2) { return packet_type::add (r1, r2); }
+        static R packet_result (const packet &r) { return packet_type::sum (r); }
+    };
+
+    template<class T, class R>
+    struct abs_sum_reduction {
+        typedef packet_traits<T> packet_type;
+        typedef typename packet_type::type packet;
+
+        static R init () { return R (); }
+        static void apply (R &r, const T &x) { r += type_traits<T>::norm_1 (x); }
+        static R combine (const R &r1, const R &r2) { return r1 + r2; }
+        static packet packet_apply (const packet &r, const packet &x) { return packet_type::add (r, packet_type::abs (x)); }
+        static packet packet_combine (const packet &r1, const packet &r2) { return packet_type::add (r1, r2); }
+        static R packet_result (const packet &r) { return packet_type::sum (r); }
+    };
+
+    template<class T, class R>
+    struct square_sum_reduction {
+        typedef packet_traits<T> packet_type;
+        typedef typename packet_type::type packet;
+
+        static R init () { return R (); }
+        static void apply (R &r, const T &x) { const R u (type_traits<T>::norm_2 (x)); r += u * u; }
+        static R combine (const R &r1, const R &r2) { return r1 + r2; }
+        static packet packet_apply (const packet &r, const packet &x) { return packet_type::madd (x, x, r); }
+        static packet packet_combine (const packet &r1, const packet &r2) { return packet_type::add (r1, r2); }
+        static R packet_result (const packet &r) { return packet_type::sum (r); }
+    };
+
+    // NaN elements are skipped, as by the element by element loop
+    template<class T, class R>
+    struct abs_max_reduction {
+        typedef packet_traits<T> packet_type;
+        typedef typename packet_type::type packet;
+
+        static R init () { return R (); }
+        static void apply (R &r, const T &x) { const R u (type_traits<T>::norm_inf (x)); if (u > r) r = u; }
+        static R combine (const R &r1, const R &r2) { return r2 > r1 ? r2 : r1; }
+        static packet packet_apply (const packet &r, const packet &x) { return packet_type::max (packet_type::abs (x), r); }
+        static packet packet_combine (const packet &r1, const packet &r2) { return packet_type::max (r2, r1); }
+        static R packet_result (const packet &r) {
+            T lanes [packet_type::size];
+            packet_type::storeu (lanes, r);
+            R m = init ();
+            for (std::size_t i = 0; i < packet_type::size; ++ i)
+                apply (m, lanes [i]);
+            return m;
+        }
+    };
+
+    template<class F, class T, class R>
+    R reduce_serial (const strided_vector_view<T> &x, boost::mpl::false_) {
+        R r0 = F::init (), r1 = F::init (), r2 = F::init (), r3 = F::init ();
+        const T *p = x.data;
+        const std::ptrdiff_t s = x.stride;
+        std::size_t i = 0;
+        for (; i + 4 <= x.size; i += 4, p += 4 * s) {
+            F::apply (r0, p [0]);
+            F::apply (r1, p [s]);
+            F::apply (r2, p [2 * s]);
+            F::apply (r3, p [3 * s]);
+        }
+        for (; i < x.size; ++ i, p += s)
+            F::apply (r0, *p);
+        return F::combine (F::combine (r0, r1), F::combine (r2, r3));
+    }
+
+    template<class F, class T, class R>
+    R reduce_serial (const strided_vector_view<T> &x, boost::mpl::true_) {
+        typedef packet_traits<T> packet_type;
+        typedef typename packet_type::type packet;
+        const std::size_t ps = packet_type::size;
+        if (x.stride != 1 || x.size < 4 * ps)
+            return reduce_serial<F, T, R> (x, boost::mpl::false_ ());
+
+        const T *p = x.data;
+        const packet zero = packet_type::set1 (T ());
+        packet r0 = zero, r1 = zero, r2 = zero, r3 = zero;
+        std::size_t i = 0;
+        for (; i + 4 * ps <= x.size; i += 4 * ps) {
+            r0 = F::packet_apply (r0, packet_type::loadu (p + i));
+            r1 = F::packet_apply (r1, packet_type::loadu (p + i + ps));
+            r2 = F::packet_apply (r2, packet_type::loadu (p + i + 2 * ps));
+            r3 = F::packet_apply (r3, packet_type::loadu (p + i + 3 * ps));
+        }
+        for (; i + ps <= x.size; i += ps)
+            r0 = F::packet_apply (r0, packet_type::loadu (p + i));
+        R r = F::packet_result (F::packet_combine (F::packet_combine (r0, r1), F::packet_combine (r2, r3)));
+        for (; i < x.size; ++ i)
+            F::apply (r, p [i]);
+        return r;
+    }
+
+    template<class R, class T1, class T2>
+    R dot_serial (const strided_vector_view<T1> &x, const strided_vector_view<T2> &y, boost::mpl::false_) {
+        R r0 = R (), r1 = R (), r2 = R (), r3 = R ();
+        const T1 *p = x.data;
+        const T2 *q = y.data;
+        const std::ptrdiff_t s = x.stride, t = y.stride;
+        std::size_t i = 0;
+        for (; i + 4 <= x.size; i += 4, p += 4 * s, q += 4 * t) {
+            r0 += p [0] * q [0];
+            r1 += p [s] * q [t];
+            r2 += p [2 * s] * q [2 * t];
+            r3 += p [3 * s] * q [3 * t];
+        }
+        for (; i < x.size; ++ i, p += s, q += t)
+            r0 += *p * *q;
+        return (r0 + r1) + (r2 + r3);
+    }
+
+    template<class R, class T>
+    R dot_serial (const strided_vector_view<T> &x, const strided_vector_view<T> &y, boost::mpl::true_) {
+        typedef packet_traits<T> packet_type;
+        typedef typename packet_type::type packet;
+        const std::size_t ps = packet_type::size;
+        if (x.stride != 1 || y.stride != 1)
+            return dot_serial<R> (x, y, boost::mpl::false_ ());
+
+        const T *p = x.data, *q = y.data;
+        const packet zero = packet_type::set1 (T ());
+        packet r0 = zero, r1 = zero, r2 = zero, r3 = zero;
+        std::size_t i = 0;
+        for (; i + 4 * ps <= x.size; i += 4 * ps) {
+            r0 = packet_type::madd (packet_type::loadu (p + i), packet_type::loadu (q + i), r0);
+            r1 = packet_type::madd (packet_type::loadu (p + i + ps), packet_type::loadu (q + i + ps), r1);
+            r2 = packet_type::madd (packet_type::loadu (p + i + 2 * ps), packet_type::loadu (q + i + 2 * ps), r2);
+            r3 = packet_type::madd (packet_type::loadu (p + i + 3 * ps), packet_type::loadu (q + i + 3 * ps), r3);
+        }
+        for (; i + ps <= x.size; i += ps)
+            r0 = packet_type::madd (packet_type::loadu (p + i), packet_type::loadu (q + i), r0);
+        R r = packet_type::sum (packet_type::add (packet_type::add (r0, r1), packet_type::add (r2, r3)));
+        for (; i < x.size; ++ i)
+            r += p [i] * q [i];
+        return r;
+    }
+
+    // Number of parts a reduction over size elements is split into
+    inline std::size_t reduction_parts (std::size_t size) {
+        if (size < BOOST_UBLAS_PARALLEL_REDUCTION_THRESHOLD || size == 0)
+            return 1;
+        // Parts of at least a quarter of the threshold, or of one element for thresholds below 4
+        return (std::min) (parallel_policy::num_threads (), size / (std::max) (std::size_t (BOOST_UBLAS_PARALLEL_REDUCTION_THRESHOLD / 4), std::size_t (1)));
+    }
+
+    // Bounds of part p of n over size elements, on multiples of a cache line of doubles
+    inline std::size_t reduction_bound (std::size_t size, std::size_t p, std::size_t n) {
+        return p == n ? size : size / n * p / 8 * 8;
+    }
+
+    // Reduction F of the elements of x into R
+    template<class F, class T, class R>
+    R reduce (const strided_vector_view<T> &x) {
+        typedef boost::mpl::bool_<packet_reduction<T, R>::value> packets;
+        const std::size_t parts = reduction_parts (x.size);
+        if (parts <= 1)
+            return reduce_serial<F, T, R> (x, packets ());
+
+        std::vector<R> partial (parts);
+        parallel_for (0, parts, 1, [&] (std::size_t first, std::size_t last) {
+            for (std::size_t p = first; p < last; ++ p)
+                partial [p] = reduce_serial<F, T, R> (x.part (reduction_bound (x.size, p, parts), reduction_bound (x.size, p + 1, parts)), packets ());
+        });
+        R r = partial [0];
+        for (std::size_t p = 1; p < parts; ++ p)
+            r = F::combine (r, partial [p]);
+        return r;
+    }
+
+    // Inner product of x and y into R
+    template<class T1, class T2, class R>
+    R dot (const strided_vector_view<T1> &x, const strided_vector_view<T2> &y) {
+        typedef boost::mpl::bool_<packet_reduction<T1, R>::value && boost::is_same<T1, T2>::value> packets;
+        const std::size_t parts = reduction_parts (x.size);
+        if (parts <= 1)
+            return dot_serial<R> (x, y, packets ());
+
+        std::vector<R> partial (parts);
+        parallel_for (0, parts, 1, [&] (std::size_t first, std::size_t last) {
+            for (std::size_t p = first; p < last; ++ p) {
+                const std::size_t b = reduction_bound (x.size, p, parts), e = reduction_bound (x.size, p + 1, parts);
+                partial [p] = dot_serial<R> (x.part (b, e), y.part (b, e), packets ());
+            }
+        });
+        R r = partial [0];
+        for (std::size_t p = 1; p < parts; ++ p)
+            r += partial [p];
+        return r;
+    }
+
+}}}}
+
+#endif
@@ -0,0 +1,302 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_SCRATCH_
+#define _BOOST_UBLAS_SCRATCH_
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <boost/align/aligned_alloc.hpp>
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/exception.hpp>
+
+// Size in bytes of the chunks an arena grows by, unless a single allocation needs more
+#ifndef BOOST_UBLAS_ARENA_CHUNK_SIZE
+#define BOOST_UBLAS_ARENA_CHUNK_SIZE 1048576
+#endif
+
+// Alignment of scratch blocks, enough for any packet type
+#ifndef BOOST_UBLAS_SCRATCH_ALIGNMENT
+#define BOOST_UBLAS_SCRATCH_ALIGNMENT 64
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+
+    /*
+        Monotonic arena for temporaries.
+
+        Allocations bump a pointer through the current chunk, a new chunk being added when it is full.
+        Memory is not given back one allocation at a time: only the last allocation is popped when it is
+        returned, as it is by temporaries destroyed in reverse order, and the arena starts over from its
+        first chunk once every allocation has been returned. release () then merges the chunks into a
+        single one as large as all of them, so that the next round of the same allocations does not call
+        the system allocator at all.
+
+        An arena is not thread safe: memory must be returned on the thread that allocated it.
+        arena::local () is the scratch arena of the current thread, from which the library draws its own
+        temporaries; it is released at the end of every top level assignment.
+    */
+    class arena {
+    private:
+        struct chunk {
+            char *data;
+            std::size_t bytes;
+        };
+
+    public:
+        explicit arena (std::size_t chunk_bytes = BOOST_UBLAS_ARENA_CHUNK_SIZE):
+            chunk_bytes_ (chunk_bytes), current_ (0), offset_ (0), live_ (0), capacity_ (0) {}
+
+        ~arena () {
+            free_chunks ();
+        }
+
+        void *allocate (std::size_t bytes) {
+            bytes = round (bytes);
+            while (current_ < chunks_.size () && offset_ + bytes > chunks_ [current_].bytes) {
+                ++ current_;
+                offset_ = 0;
+            }
+            if (current_ == chunks_.size ())
+                add_chunk ((std::max) (bytes, chunk_bytes_));
+            void *data = chunks_ [current_].data + offset_;
+            offset_ += bytes;
+            ++ live_;
+            return data;
+        }
+
+        void deallocate (void *data, std::size_t bytes) {
+            if (! data)
+                return;
+            BOOST_UBLAS_CHECK (live_ > 0, internal_logic ());
+            if (-- live_ == 0) {
+                current_ = 0;
+                offset_ = 0;
+                return;
+            }
+            // The last allocation of the current chunk is popped
+            bytes = round (bytes);
+            if (current_ < chunks_.size () && offset_ >= bytes &&
+                static_cast<char *> (data) == chunks_ [current_].data + offset_ - bytes)
+                offset_ -= bytes;
+        }
+
+        // Merges the chunks into one when no allocation is live, so that they are reused without growing
+        void release () {
+            if (live_ != 0 || chunks_.size () <= 1)
+                return;
+            const std::size_t bytes = capacity_;
+            free_chunks ();
+            add_chunk (bytes);
+            current_ = 0;
+        }
+
+        // Gives every chunk back to the system, when no allocation is live
+        void clear () {
+            if (live_ != 0)
+                return;
+            free_chunks ();
+        }
+
+        std::size_t live () const {
+            return live_;
+        }
+        std::size_t capacity () const {
+            return capacity_;
+        }
+        std::size_t chunks () const {
+            return chunks_.size ();
+        }
+
+        static arena &local () {
+            static thread_local arena a;
+            return a;
+        }
+
+        // Arena used by default constructed arena_allocators on the current thread: the one of the
+        // innermost scope, or the scratch arena of the thread outside of any scope
+        static arena &current () {
+            arena *a = scoped ();
+            return a ? *a : local ();
+        }
+
+        // Makes an arena the current one of the thread for the lifetime of the scope
+        class scope {
+        public:
+            explicit scope (arena &a):
+                previous_ (scoped ()) {
+                scoped () = &a;
+            }
+            ~scope () {
+                scoped () = previous_;
+            }
+
+        private:
+            scope (const scope &);
+            scope &operator = (const scope &);
+
+            arena *previous_;
+        };
+
+    private:
+        arena (const arena &);
+        arena &operator = (const arena &);
+
+        static arena *&scoped () {
+            static thread_local arena *a = 0;
+            return a;
+        }
+
+        static std::size_t round (std::size_t bytes) {
+            const std::size_t alignment = BOOST_UBLAS_SCRATCH_ALIGNMENT;
+            return ((std::max) (bytes, std::size_t (1)) + alignment - 1) / alignment * alignment;
+        }
+
+        void add_chunk (std::size_t bytes) {
+            chunk c = { static_cast<char *> (boost::alignment::aligned_alloc (BOOST_UBLAS_SCRATCH_ALIGNMENT, bytes)), bytes };
+            if (! c.data)
+                throw std::bad_alloc ();
+            chunks_.push_back (c);
+            capacity_ += bytes;
+            current_ = chunks_.size () - 1;
+            offset_ = 0;
+        }
+
+        void free_chunks () {
+            for (std::size_t i = 0; i < chunks_.size (); ++ i)
+                boost::alignment::aligned_free (chunks_ [i].data);
+            chunks_.clear ();
+            capacity_ = 0;
+            current_ = 0;
+            offset_ = 0;
+        }
+
+        std::size_t chunk_bytes_;
+        std::vector<chunk> chunks_;
+        std::size_t current_;
+        std::size_t offset_;
+        std::size_t live_;
+        std::size_t capacity_;
+    };
+
+    // Allocator drawing from an arena, for instance as the ALLOC of an unbounded_array:
+    // unbounded_array<double, arena_allocator<double> > (n, arena_allocator<double> (a)).
+    // Default constructed, it draws from arena::current ().
+    template<class T>
+    class arena_allocator {
+    public:
+        typedef T value_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template<class U>
+        struct rebind {
+            typedef arena_allocator<U> other;
+        };
+
+        arena_allocator ():
+            arena_ (&arena::current ()) {}
+        explicit arena_allocator (arena &a):
+            arena_ (&a) {}
+        template<class U>
+        arena_allocator (const arena_allocator<U> &a):
+            arena_ (&a.get_arena ()) {}
+
+        pointer allocate (size_type n, const void * = 0) {
+            if (n == 0)
+                return 0;
+            return static_cast<pointer> (arena_->allocate (n * sizeof (T)));
+        }
+
+        void deallocate (pointer p, size_type n) {
+            arena_->deallocate (p, n * sizeof (T));
+        }
+
+        size_type max_size () const {
+            return size_type (-1) / sizeof (T);
+        }
+
+        void construct (pointer p, const T &value) {
+            new (p) T (value);
+        }
+        void destroy (pointer p) {
+            p->~T ();
+        }
+
+        arena &get_arena () const {
+            return *arena_;
+        }
+
+    private:
+        arena *arena_;
+    };
+
+    template<class T, class U>
+    inline bool operator == (const arena_allocator<T> &a1, const arena_allocator<U> &a2) {
+        return &a1.get_arena () == &a2.get_arena ();
+    }
+
+    template<class T, class U>
+    inline bool operator != (const arena_allocator<T> &a1, const arena_allocator<U> &a2) {
+        return ! (a1 == a2);
+    }
+
+namespace detail {
+
+    // Allocator of the library temporaries, drawing from the scratch arena of the current thread
+    // whatever arena::scope is active
+    template<class T>
+    class scratch_allocator:
+        public arena_allocator<T> {
+    public:
+        template<class U>
+        struct rebind {
+            typedef scratch_allocator<U> other;
+        };
+
+        scratch_allocator ():
+            arena_allocator<T> (arena::local ()) {}
+        template<class U>
+        scratch_allocator (const scratch_allocator<U> &a):
+            arena_allocator<T> (a) {}
+    };
+
+    // Marks a top level operation drawing temporaries from the scratch arena: when the outermost
+    // scope of the thread ends, the temporaries are gone and the scratch arena is released.
+    class scratch_scope {
+    public:
+        scratch_scope () {
+            ++ depth ();
+        }
+        ~scratch_scope () {
+            if (-- depth () == 0)
+                arena::local ().release ();
+        }
+
+    private:
+        scratch_scope (const scratch_scope &);
+        scratch_scope &operator = (const scratch_scope &);
+
+        static std::size_t &depth () {
+            static thread_local std::size_t d = 0;
+            return d;
+        }
+    };
+
+}
+
+}}}
+
+#endif
@@ -0,0 +1,272 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_SYMM_
+#define _BOOST_UBLAS_SYMM_
+
+#include <algorithm>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/hermitian.hpp>
+#include <boost/numeric/ublas/detail/gemm.hpp>
+
+namespace boost { namespace numeric { namespace ublas { namespace detail {
+
+    /*
+        Products with symmetric_matrix and hermitian_matrix working on their packed storage.
+
+        Element access to a packed matrix goes through the bounds checks and the triangle test of
+        operator () (i, j), which costs more than the multiply add it feeds. These kernels instead
+        read and write the packed array directly, and only while packing operands or writing tiles back,
+        so the inner loops are the vectorized micro kernel of the packed GEMM.
+
+        The rank k updates compute the lower half of the result only: tiles above the diagonal are skipped
+        and the other elements are written to whichever triangle the matrix stores.
+    */
+
+    template<bool Conj, class T>
+    BOOST_UBLAS_INLINE
+    T symm_conj (const T &t) {
+        return Conj ? type_traits<T>::conj (t) : t;
+    }
+
+    // Element (i, j) of a symmetric (hermitian if Conj) matrix stored in the TRI triangle of the packed array data
+    template<bool Conj, class TRI, class L, class T>
+    class packed_symmetric_view {
+    public:
+        packed_symmetric_view (const T *data, std::size_t size):
+            data_ (data), size_ (size) {}
+
+        BOOST_UBLAS_INLINE
+        T operator () (std::size_t i, std::size_t j) const {
+            if (TRI::other (i, j))
+                return data_ [TRI::element (L (), i, size_, j, size_)];
+            else
+                return symm_conj<Conj> (data_ [TRI::element (L (), j, size_, i, size_)]);
+        }
+
+    private:
+        const T *data_;
+        std::size_t size_;
+    };
+
+    // Element (p, j) of the k x n (conjugate) transpose of the n x k expression e
+    template<bool Conj, class E>
+    class symm_transpose {
+    public:
+        symm_transpose (const E &e): e_ (e) {}
+
+        BOOST_UBLAS_INLINE
+        typename E::value_type operator () (std::size_t p, std::size_t j) const {
+            return symm_conj<Conj> (typename E::value_type (e_ (j, p)));
+        }
+
+    private:
+        const E &e_;
+    };
+
+    // The n x 2k matrix [s1 * e1, s2 * e2], which turns the two products of a rank 2k update into one
+    template<class T, class E1, class E2>
+    class symm_concat {
+    public:
+        symm_concat (const E1 &e1, const T &s1, const E2 &e2, const T &s2, std::size_t k):
+            e1_ (e1), e2_ (e2), s1_ (s1), s2_ (s2), k_ (k) {}
+
+        typedef T value_type;
+
+        BOOST_UBLAS_INLINE
+        T operator () (std::size_t i, std::size_t p) const {
+            return p < k_ ? s1_ * e1_ (i, p) : s2_ * e2_ (i, p - k_);
+        }
+
+    private:
+        const E1 &e1_;
+        const E2 &e2_;
+        T s1_, s2_;
+        std::size_t k_;
+    };
+
+    // Element (i, j), i >= j, of the lower half of a rank k update: c (i, j) = beta * c (i, j) + v,
+    // beta being applied on the first pass over k only.
+    template<bool Conj, class TRI, class L, class T>
+    BOOST_UBLAS_INLINE
+    void packed_update_element (T *c, std::size_t n, std::size_t i, std::size_t j, const T &v, const T &beta, bool first) {
+        const bool stored = TRI::other (i, j);
+        T &x = c [stored ? TRI::element (L (), i, n, j, n) : TRI::element (L (), j, n, i, n)];
+        const T old = stored ? x : symm_conj<Conj> (x);
+        const T result = ! first || beta == T (1) ? old + v : beta == T (0) ? v : beta * old + v;
+        x = stored ? result : symm_conj<Conj> (result);
+    }
+
+    // c = beta * c + alpha * a * b^T (b^H if Conj) for the n x n symmetric (hermitian) matrix stored in the
+    // TRI triangle of the packed array c, a and b being n x k. Only tiles of the lower half are computed.
+    template<bool Conj, class TRI, class L, class T, class E1, class E2>
+    void packed_rank_update (T *c, std::size_t n, const E1 &a, const E2 &b, std::size_t k,
+                             const T &alpha, const T &beta) {
+        typedef gemm_blocking<T> blocking;
+        const std::size_t MR = blocking::mr;
+        const std::size_t NR = blocking::nr;
+        const std::size_t KC = blocking::kc;
+        const std::size_t MC = blocking::mc;
+        const std::size_t NC = blocking::nc;
+
+        if (n == 0)
+            return;
+
+        if (k == 0 || alpha == T (0)) {
+            if (beta != T (1))
+                for (std::size_t i = 0; i < n; ++ i)
+                    for (std::size_t j = 0; j <= i; ++ j)
+                        packed_update_element<Conj, TRI, L> (c, n, i, j, T (0), beta, true);
+            return;
+        }
+
+        const symm_transpose<Conj, E2> bt (b);
+        const std::size_t mc_max = ((std::min) (n, MC) + MR - 1) / MR * MR;
+        const std::size_t nc_max = ((std::min) (n, NC) + NR - 1) / NR * NR;
+        const std::size_t kc_max = (std::min) (k, KC);
+
+        typedef unbounded_array<T, scratch_allocator<T> > buffer_type;
+        buffer_type pa (mc_max * kc_max, no_init_tag ());
+        buffer_type pb (kc_max * nc_max, no_init_tag ());
+        T ab [MR * NR];
+
+        for (std::size_t jc = 0; jc < n; jc += NC) {
+            const std::size_t nc = (std::min) (NC, n - jc);
+            for (std::size_t pc = 0; pc < k; pc += KC) {
+                const std::size_t kc = (std::min) (KC, k - pc);
+                gemm_pack_b<NR> (bt, pc, kc, jc, nc, &pb [0]);
+                // rows above jc only meet columns right of the diagonal
+                for (std::size_t ic = jc; ic < n; ic += MC) {
+                    const std::size_t mc = (std::min) (MC, n - ic);
+                    gemm_pack_a<MR> (a, ic, mc, pc, kc, &pa [0]);
+                    for (std::size_t jr = 0; jr < nc; jr += NR) {
+                        const std::size_t nr = (std::min) (NR, nc - jr);
+                        for (std::size_t ir = 0; ir < mc; ir += MR) {
+                            const std::size_t mr = (std::min) (MR, mc - ir);
+                            const std::size_t i0 = ic + ir, j0 = jc + jr;
+                            if (i0 + mr <= j0)
+                                continue;
+                            gemm_micro_kernel<T, MR, NR>::apply (kc, &pa [ir * kc], &pb [jr * kc], ab);
+                            for (std::size_t i = 0; i < mr; ++ i)
+                                for (std::size_t j = 0; j < nr && j0 + j <= i0 + i; ++ j)
+                                    packed_update_element<Conj, TRI, L> (c, n, i0 + i, j0 + j, alpha * ab [i * NR + j], beta, pc == 0);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    template<class T, class TRI, class L, class A>
+    BOOST_UBLAS_INLINE
+    T *packed_data (symmetric_matrix<T, TRI, L, A> &m) {
+        return m.size1 () ? &m.data () [0] : 0;
+    }
+    template<class T, class TRI, class L, class A>
+    BOOST_UBLAS_INLINE
+    const T *packed_data (const symmetric_matrix<T, TRI, L, A> &m) {
+        return m.size1 () ? &m.data () [0] : 0;
+    }
+    template<class T, class TRI, class L, class A>
+    BOOST_UBLAS_INLINE
+    T *packed_data (hermitian_matrix<T, TRI, L, A> &m) {
+        return m.size1 () ? &m.data () [0] : 0;
+    }
+    template<class T, class TRI, class L, class A>
+    BOOST_UBLAS_INLINE
+    const T *packed_data (const hermitian_matrix<T, TRI, L, A> &m) {
+        return m.size1 () ? &m.data () [0] : 0;
+    }
+
+    // An operand aliasing the result is copied first, the kernels update the result in place
+    template<class M, class E>
+    BOOST_UBLAS_INLINE
+    bool symm_aliased (const M &m, const E &e) {
+        return static_cast<const void *> (&m) == static_cast<const void *> (&e);
+    }
+
+    // c = beta * c + alpha * a * a^T, and c = beta * c + alpha * a * a^H for hermitian c
+    template<class T, class TRI, class L, class A, class E>
+    void symmetric_rank_update (symmetric_matrix<T, TRI, L, A> &c, const E &a, const T &alpha, const T &beta) {
+        BOOST_UBLAS_CHECK (c.size1 () == a.size1 (), bad_size ());
+        if (symm_aliased (c, a)) {
+            const matrix<T> t (a);
+            packed_rank_update<false, TRI, L> (packed_data (c), c.size1 (), t, t, t.size2 (), alpha, beta);
+        }
+        else
+            packed_rank_update<false, TRI, L> (packed_data (c), c.size1 (), a, a, a.size2 (), alpha, beta);
+    }
+    template<class T, class TRI, class L, class A, class E>
+    void symmetric_rank_update (hermitian_matrix<T, TRI, L, A> &c, const E &a, const T &alpha, const T &beta) {
+        BOOST_UBLAS_CHECK (c.size1 () == a.size1 (), bad_size ());
+        if (symm_aliased (c, a)) {
+            const matrix<T> t (a);
+            packed_rank_update<true, TRI, L> (packed_data (c), c.size1 (), t, t, t.size2 (), alpha, beta);
+        }
+        else
+            packed_rank_update<true, TRI, L> (packed_data (c), c.size1 (), a, a, a.size2 (), alpha, beta);
+    }
+
+    // c = beta * c + alpha * a * b^T + alpha * b * a^T, and
+    // c = beta * c + alpha * a * b^H + conj (alpha) * b * a^H for hermitian c
+    template<bool Conj, class TRI, class L, class T, class E1, class E2>
+    void packed_rank_2k_update (T *c, std::size_t n, const E1 &a, const E2 &b, const T &alpha, const T &beta) {
+        BOOST_UBLAS_CHECK (a.size1 () == n && b.size1 () == n, bad_size ());
+        BOOST_UBLAS_CHECK (a.size2 () == b.size2 (), bad_size ());
+        const std::size_t k = a.size2 ();
+        const symm_concat<T, E1, E2> left (a, alpha, b, symm_conj<Conj> (alpha), k);
+        const symm_concat<T, E2, E1> right (b, T (1), a, T (1), k);
+        packed_rank_update<Conj, TRI, L> (c, n, left, right, 2 * k, T (1), beta);
+    }
+    template<class T, class TRI, class L, class A, class E1, class E2>
+    void symmetric_rank_2k_update (symmetric_matrix<T, TRI, L, A> &c, const E1 &a, const E2 &b, const T &alpha, const T &beta) {
+        if (symm_aliased (c, a) || symm_aliased (c, b)) {
+            const matrix<T> ta (a), tb (b);
+            packed_rank_2k_update<false, TRI, L> (packed_data (c), c.size1 (), ta, tb, alpha, beta);
+        }
+        else
+            packed_rank_2k_update<false, TRI, L> (packed_data (c), c.size1 (), a, b, alpha, beta);
+    }
+    template<class T, class TRI, class L, class A, class E1, class E2>
+    void symmetric_rank_2k_update (hermitian_matrix<T, TRI, L, A> &c, const E1 &a, const E2 &b, const T &alpha, const T &beta) {
+        if (symm_aliased (c, a) || symm_aliased (c, b)) {
+            const matrix<T> ta (a), tb (b);
+            packed_rank_2k_update<true, TRI, L> (packed_data (c), c.size1 (), ta, tb, alpha, beta);
+        }
+        else
+            packed_rank_2k_update<true, TRI, L> (packed_data (c), c.size1 (), a, b, alpha, beta);
+    }
+
+    // c = beta * c + alpha * s * b for s packed symmetric (hermitian), through the packed GEMM
+    // with the packing of s reading the packed array directly
+    template<bool Conj, class TRI, class L, class T, class M, class E>
+    void packed_symmetric_product (M &c, const T *s, std::size_t n, const E &b, const T &alpha, const T &beta) {
+        BOOST_UBLAS_CHECK (c.size1 () == n && b.size1 () == n, bad_size ());
+        BOOST_UBLAS_CHECK (c.size2 () == b.size2 (), bad_size ());
+        const packed_symmetric_view<Conj, TRI, L, T> sv (s, n);
+        if (symm_aliased (c, b)) {
+            const matrix<T> t (b);
+            gemm<T> (c, sv, t, n, c.size2 (), n, alpha, beta);
+        }
+        else
+            gemm<T> (c, sv, b, n, c.size2 (), n, alpha, beta);
+    }
+    template<class M, class T, class TRI, class L, class A, class E>
+    void symmetric_product (M &c, const symmetric_matrix<T, TRI, L, A> &s, const E &b, const T &alpha, const T &beta) {
+        packed_symmetric_product<false, TRI, L> (c, packed_data (s), s.size1 (), b, alpha, beta);
+    }
+    template<class M, class T, class TRI, class L, class A, class E>
+    void symmetric_product (M &c, const hermitian_matrix<T, TRI, L, A> &s, const E &b, const T &alpha, const T &beta) {
+        packed_symmetric_product<true, TRI, L> (c, packed_data (s), s.size1 (), b, alpha, beta);
+    }
+
+}}}}
+
+#endif
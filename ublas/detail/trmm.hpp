@@ -0,0 +1,303 @@
+//
+//  Copyright (c) 2014
+//  Mark Lingle, David Bellot
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_TRMM_
+#define _BOOST_UBLAS_TRMM_
+
+#include <algorithm>
+#include <vector>
+#include <boost/static_assert.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/detail/gemm.hpp>
+
+// Height of the block rows of the triangular products and solves
+#ifndef BOOST_UBLAS_TRIANGULAR_BLOCK_SIZE
+#define BOOST_UBLAS_TRIANGULAR_BLOCK_SIZE 64
+#endif
+
+namespace boost { namespace numeric { namespace ublas { namespace detail {
+
+    /*
+        Blocked products and solves with triangular_matrix and triangular_adaptor, in place on the right hand sides.
+
+        The triangle is split into block rows. The diagonal blocks are multiplied or solved element by element,
+        the blocks on the other side of the diagonal are skipped, and the remaining off diagonal blocks update
+        the right hand sides through the packed GEMM when there are several of them, or through dot products or
+        axpys following the storage orientation for a single vector. Elements strictly inside the triangle are
+        read straight from the packed array or the adapted matrix, without the structure tests of operator ().
+    */
+
+    // Element (i, j) strictly inside the TRI triangle of the packed array data
+    template<class TRI, class L, class T>
+    class packed_triangular_view {
+    public:
+        typedef T value_type;
+
+        packed_triangular_view (const T *data, std::size_t size1, std::size_t size2):
+            data_ (data), size1_ (size1), size2_ (size2) {}
+
+        BOOST_UBLAS_INLINE
+        T operator () (std::size_t i, std::size_t j) const {
+            return data_ [TRI::element (L (), i, size1_, j, size2_)];
+        }
+
+    private:
+        const T *data_;
+        std::size_t size1_, size2_;
+    };
+
+    // The block of e starting at (i0, j0), as a gemm operand
+    template<class E>
+    class trmm_block {
+    public:
+        trmm_block (const E &e, std::size_t i0, std::size_t j0):
+            e_ (e), i0_ (i0), j0_ (j0) {}
+
+        BOOST_UBLAS_INLINE
+        typename E::value_type operator () (std::size_t i, std::size_t j) const {
+            return e_ (i0_ + i, j0_ + j);
+        }
+
+    private:
+        const E &e_;
+        std::size_t i0_, j0_;
+    };
+
+    // The block of the right hand sides b starting at (i0, j0), as the result of gemm
+    template<class B>
+    class trmm_result_block {
+    public:
+        trmm_result_block (B &b, std::size_t i0, std::size_t j0):
+            b_ (b), i0_ (i0), j0_ (j0) {}
+
+        BOOST_UBLAS_INLINE
+        typename B::reference operator () (std::size_t i, std::size_t j) {
+            return b_ (i0_ + i, j0_ + j);
+        }
+
+    private:
+        B &b_;
+        std::size_t i0_, j0_;
+    };
+
+    // A vector seen as a one column matrix of right hand sides
+    template<class V>
+    class trmm_column {
+    public:
+        typedef typename V::value_type value_type;
+        typedef typename V::reference reference;
+
+        trmm_column (V &v): v_ (v) {}
+
+        BOOST_UBLAS_INLINE
+        std::size_t size1 () const {
+            return v_.size ();
+        }
+        BOOST_UBLAS_INLINE
+        std::size_t size2 () const {
+            return 1;
+        }
+        BOOST_UBLAS_INLINE
+        value_type operator () (std::size_t i, std::size_t /* j */) const {
+            return v_ (i);
+        }
+        BOOST_UBLAS_INLINE
+        reference operator () (std::size_t i, std::size_t /* j */) {
+            return v_ (i);
+        }
+
+    private:
+        V &v_;
+    };
+
+    // b [i0, i1) += alpha * r [i0, i1) x [j0, j1) * b [j0, j1)
+    template<class R, class B, class T>
+    void triangular_block_update (const R &r, B &b, std::size_t i0, std::size_t i1, std::size_t j0, std::size_t j1,
+                                  const T &alpha, row_major_tag) {
+        const std::size_t nrhs = b.size2 ();
+        if (i0 >= i1 || j0 >= j1)
+            return;
+        if (nrhs > 1) {
+            trmm_result_block<B> c (b, i0, 0);
+            const trmm_block<R> a (r, i0, j0);
+            const trmm_block<B> x (b, j0, 0);
+            gemm<T> (c, a, x, i1 - i0, nrhs, j1 - j0, alpha, T (1));
+            return;
+        }
+        // four partial sums break the dependency chain of the dot product
+        for (std::size_t i = i0; i < i1; ++ i) {
+            T s0 = T/*zero*/(), s1 = T/*zero*/(), s2 = T/*zero*/(), s3 = T/*zero*/();
+            std::size_t j = j0;
+            for (; j + 4 <= j1; j += 4) {
+                s0 += r (i, j) * b (j, 0);
+                s1 += r (i, j + 1) * b (j + 1, 0);
+                s2 += r (i, j + 2) * b (j + 2, 0);
+                s3 += r (i, j + 3) * b (j + 3, 0);
+            }
+            for (; j < j1; ++ j)
+                s0 += r (i, j) * b (j, 0);
+            b (i, 0) += alpha * ((s0 + s1) + (s2 + s3));
+        }
+    }
+    template<class R, class B, class T>
+    void triangular_block_update (const R &r, B &b, std::size_t i0, std::size_t i1, std::size_t j0, std::size_t j1,
+                                  const T &alpha, column_major_tag) {
+        if (b.size2 () > 1 || i0 >= i1) {
+            triangular_block_update (r, b, i0, i1, j0, j1, alpha, row_major_tag ());
+            return;
+        }
+        for (std::size_t j = j0; j < j1; ++ j) {
+            const T t = alpha * b (j, 0);
+            if (t != T/*zero*/())
+                for (std::size_t i = i0; i < i1; ++ i)
+                    b (i, 0) += r (i, j) * t;
+        }
+    }
+
+    // b [k0, k1) = t [k0, k1) x [k0, k1) * b [k0, k1) on a diagonal block, d holding the diagonal
+    template<bool Lower, class R, class T, class B>
+    void triangular_block_multiply (const R &r, const T *d, B &b, std::size_t k0, std::size_t k1) {
+        const std::size_t nrhs = b.size2 ();
+        // rows are overwritten in the order where the rows they read are still untouched
+        for (std::size_t t = k0; t < k1; ++ t) {
+            const std::size_t i = Lower ? k1 - 1 - (t - k0) : t;
+            for (std::size_t c = 0; c < nrhs; ++ c)
+                b (i, c) *= d [i];
+            const std::size_t j0 = Lower ? k0 : i + 1, j1 = Lower ? i : k1;
+            for (std::size_t j = j0; j < j1; ++ j) {
+                const T l = r (i, j);
+                for (std::size_t c = 0; c < nrhs; ++ c)
+                    b (i, c) += l * b (j, c);
+            }
+        }
+    }
+
+    // b [k0, k1) = t [k0, k1) x [k0, k1) ^-1 * b [k0, k1) on a diagonal block, d holding the diagonal
+    template<bool Lower, class R, class T, class B>
+    void triangular_block_solve (const R &r, const T *d, B &b, std::size_t k0, std::size_t k1) {
+        const std::size_t nrhs = b.size2 ();
+        for (std::size_t t = k0; t < k1; ++ t) {
+            const std::size_t i = Lower ? t : k1 - 1 - (t - k0);
+            const std::size_t j0 = Lower ? k0 : i + 1, j1 = Lower ? i : k1;
+            for (std::size_t j = j0; j < j1; ++ j) {
+                const T l = r (i, j);
+                if (l != T/*zero*/())
+                    for (std::size_t c = 0; c < nrhs; ++ c)
+                        b (i, c) -= l * b (j, c);
+            }
+#ifndef BOOST_UBLAS_SINGULAR_CHECK
+            BOOST_UBLAS_CHECK (d [i] != T/*zero*/(), singular ());
+#else
+            if (d [i] == T/*zero*/())
+                singular ().raise ();
+#endif
+            if (d [i] != T (1))
+                for (std::size_t c = 0; c < nrhs; ++ c)
+                    b (i, c) /= d [i];
+        }
+    }
+
+    // b = t * b, t being n x n triangular with diagonal d and r giving the elements strictly inside the triangle.
+    // Lower triangles are run bottom up and upper ones top down, so each block row only reads rows still untouched.
+    template<bool Lower, class O, class R, class T, class B>
+    void blocked_triangular_multiply (const R &r, const T *d, B &b, std::size_t n) {
+        const std::size_t nb = BOOST_UBLAS_TRIANGULAR_BLOCK_SIZE;
+        const std::size_t blocks = (n + nb - 1) / nb;
+        for (std::size_t t = 0; t < blocks; ++ t) {
+            const std::size_t k = Lower ? blocks - 1 - t : t;
+            const std::size_t k0 = k * nb, k1 = (std::min) (k0 + nb, n);
+            triangular_block_multiply<Lower> (r, d, b, k0, k1);
+            if (Lower)
+                triangular_block_update (r, b, k0, k1, 0, k0, T (1), O ());
+            else
+                triangular_block_update (r, b, k0, k1, k1, n, T (1), O ());
+        }
+    }
+
+    // b = t^-1 * b, by block forward (lower) or backward (upper) substitution
+    template<bool Lower, class O, class R, class T, class B>
+    void blocked_triangular_solve (const R &r, const T *d, B &b, std::size_t n) {
+        const std::size_t nb = BOOST_UBLAS_TRIANGULAR_BLOCK_SIZE;
+        const std::size_t blocks = (n + nb - 1) / nb;
+        for (std::size_t t = 0; t < blocks; ++ t) {
+            const std::size_t k = Lower ? t : blocks - 1 - t;
+            const std::size_t k0 = k * nb, k1 = (std::min) (k0 + nb, n);
+            if (Lower)
+                triangular_block_update (r, b, k0, k1, 0, k0, T (-1), O ());
+            else
+                triangular_block_update (r, b, k0, k1, k1, n, T (-1), O ());
+            triangular_block_solve<Lower> (r, d, b, k0, k1);
+        }
+    }
+
+    // Whether the triangular structure or solve tag TAG is lower, and has a unit diagonal
+    template<class TAG>
+    struct triangular_tag_traits {
+        static const bool lower = boost::is_convertible<TAG, lower_tag>::value;
+        static const bool unit = boost::is_convertible<TAG, unit_lower_tag>::value || boost::is_convertible<TAG, unit_upper_tag>::value;
+    };
+
+    template<class T, class TRI, class L, class A>
+    BOOST_UBLAS_INLINE
+    packed_triangular_view<TRI, L, T> triangular_view (const triangular_matrix<T, TRI, L, A> &m) {
+        return packed_triangular_view<TRI, L, T> (m.data ().size () ? &m.data () [0] : 0, m.size1 (), m.size2 ());
+    }
+    template<class M, class TRI>
+    BOOST_UBLAS_INLINE
+    const typename triangular_adaptor<M, TRI>::matrix_closure_type &triangular_view (const triangular_adaptor<M, TRI> &m) {
+        return m.data ();
+    }
+
+    // The diagonal of m, all ones if Unit; operator () (i, i) knows about unit and strict structures
+    template<bool Unit, class M>
+    std::vector<typename M::value_type> triangular_diagonal (const M &m) {
+        typedef typename M::value_type value_type;
+        std::vector<value_type> d (m.size1 (), value_type (1));
+        if (! Unit)
+            for (std::size_t i = 0; i < d.size (); ++ i)
+                d [i] = m (i, i);
+        return d;
+    }
+
+    // b = m * b for a triangular_matrix or triangular_adaptor m with structure TRI
+    template<class TRI, class M, class B>
+    void triangular_multiply (const M &m, B &b) {
+        typedef typename M::value_type value_type;
+        typedef triangular_tag_traits<typename TRI::triangular_type> traits;
+
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == b.size1 (), bad_size ());
+        const std::vector<value_type> d (triangular_diagonal<false> (m));
+        blocked_triangular_multiply<traits::lower, typename M::orientation_category> (triangular_view (m), d.empty () ? 0 : &d [0], b, m.size1 ());
+    }
+
+    // Whether the tag C of a solve names the triangle stored by a structure TRI, the only one the block substitution reads
+    template<class C, class TRI>
+    struct triangular_solve_stored:
+        boost::mpl::bool_<triangular_tag_traits<C>::lower == triangular_tag_traits<typename TRI::triangular_type>::lower> {};
+
+    // b = m^-1 * b for a triangular_matrix or triangular_adaptor m with structure TRI, C being the tag of the solve
+    template<class C, class TRI, class M, class B>
+    void triangular_solve (const M &m, B &b) {
+        typedef typename M::value_type value_type;
+        typedef triangular_tag_traits<C> traits;
+
+        BOOST_STATIC_ASSERT ((triangular_solve_stored<C, TRI>::value));
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == b.size1 (), bad_size ());
+        const std::vector<value_type> d (triangular_diagonal<traits::unit> (m));
+        blocked_triangular_solve<traits::lower, typename M::orientation_category> (triangular_view (m), d.empty () ? 0 : &d [0], b, m.size1 ());
+    }
+
+}}}}
+
+#endif
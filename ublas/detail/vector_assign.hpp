@@ -14,6 +14,8 @@
 #define _BOOST_UBLAS_VECTOR_ASSIGN_
 
 #include <boost/numeric/ublas/functional.hpp> // scalar_assign
+#include <boost/numeric/ublas/detail/gemv.hpp>
+#include <boost/type_traits/is_void.hpp>
 // Required for make_conformant storage
 #include <vector>
 
@@ -438,16 +440,58 @@ namespace detail {
 #endif
     }
 
-    // Dispatcher
     template<template <class T1, class T2> class F, class V, class E>
     BOOST_UBLAS_INLINE
-    void vector_assign (V &v, const vector_expression<E> &e) {
+    void gemv_assign_rest (V &v, const E &e, boost::mpl::true_) {
+        vector_assign<F> (v, detail::gemv_expression<E>::rest (e));
+    }
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void gemv_assign_rest (V &, const E &, boost::mpl::false_) {}
+
+    // Dense vector assigned y + alpha A x, A having dense storage: x is copied to a buffer, y is
+    // assigned element by element, then the product is added by the kernels of detail/gemv.hpp.
+    // The result is assigned before the product is added and must not alias A, as with noalias.
+    template<template <class T1, class T2> class F, class V, class E>
+    void vector_assign (V &v, const vector_expression<E> &e, boost::mpl::true_) {
+        typedef detail::gemv_expression<E> expression_traits;
+        typedef typename expression_traits::term_type term_type;
+        typedef detail::gemv_term<term_type> term_traits;
+        typedef typename term_traits::value_type value_type;
+        typedef detail::gemv_assignment<F<typename V::reference, typename E::value_type> > assignment_traits;
+        typedef boost::mpl::bool_<! boost::is_void<typename expression_traits::rest_type>::value> has_rest;
+        BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
+
+        detail::scratch_scope scope;
+        const term_type &term = expression_traits::term (e ());
+        BOOST_UBLAS_CHECK (term_traits::matrix (term).size2 == term_traits::vector (term).size (), bad_size ());
+        const value_type alpha (term_traits::alpha (term));
+        unbounded_array<value_type, detail::scratch_allocator<value_type> > x;
+        detail::gemv_scale (term_traits::vector (term), assignment_traits::negate != expression_traits::negate ? value_type (- alpha) : alpha, x);
+        gemv_assign_rest<F> (v, e (), has_rest ());
+        detail::gemv_vector (term_traits::matrix (term), x.size () ? &x [0] : static_cast<const value_type *> (0), v,
+                             assignment_traits::init && ! has_rest::value);
+    }
+
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<E> &e, boost::mpl::false_) {
         typedef typename vector_assign_traits<typename V::storage_category,
                                               F<typename V::reference, typename E::value_type>::computed,
                                               typename E::const_iterator::iterator_category>::storage_category storage_category;
         vector_assign<F> (v, e, storage_category ());
     }
 
+    // Dispatcher
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<E> &e) {
+        typedef boost::mpl::bool_<detail::gemv_expression<E>::value &&
+                                  detail::gemv_assignment<F<typename V::reference, typename E::value_type> >::value &&
+                                  detail::vector_storage<V>::value> gemv_category;
+        vector_assign<F> (v, e, gemv_category ());
+    }
+
     template<class SC, class RI>
     struct vector_swap_traits {
         typedef SC storage_category;
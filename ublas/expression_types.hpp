@@ -360,7 +360,7 @@ namespace boost { namespace numeric { namespace ublas {
             */
             // matrix_assign< scalar_assign > ( m_expression(), tree_optimizer::optimize(other.m_expression()) );
             
-            typedef typename expression_types< MAX_RECURSION_DEPTH, Other, Other >::type expressions; // MAX_RECURSION_DEPTH = 5 as defined in tree_optimizer.hpp
+            typedef typename expression_types< MAX_RECURSION_DEPTH, Other, Other >::type expressions; // MAX_RECURSION_DEPTH defaults to 5 in tree_optimizer.hpp
             typedef typename to_variadic< expressions >::type tree_optimizer;
             
             assign(mexpression(), tree_optimizer::optimize(other.mexpression()), scalar_assign<typename E::value_type, typename Other::value_type>());
@@ -376,7 +376,7 @@ namespace boost { namespace numeric { namespace ublas {
              */
             // matrix_assign< scalar_assign > ( m_expression(), tree_optimizer::optimize(other.m_expression()) );
             
-            typedef typename expression_types< MAX_RECURSION_DEPTH, Other, Other >::type expressions; // MAX_RECURSION_DEPTH = 5 as defined in tree_optimizer.hpp
+            typedef typename expression_types< MAX_RECURSION_DEPTH, Other, Other >::type expressions; // MAX_RECURSION_DEPTH defaults to 5 in tree_optimizer.hpp
             typedef typename to_variadic< expressions >::type tree_optimizer;
             //std::cout << "test size = " << mpl::size<expressions>::value << "\n";
             assign(mexpression(), tree_optimizer::optimize(other.mexpression()), scalar_assign<typename E::value_type, typename Other::value_type>());
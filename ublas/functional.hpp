@@ -33,6 +33,8 @@ namespace boost { namespace numeric { namespace ublas { namespace raw {
 #endif
 
 #include <boost/numeric/ublas/detail/definitions.hpp>
+#include <boost/numeric/ublas/detail/gemm.hpp>
+#include <boost/numeric/ublas/detail/reduce.hpp>
 
 
 
@@ -358,6 +360,12 @@ namespace boost { namespace numeric { namespace ublas {
                 t += *it, ++ it;
             return t; 
         }
+        // Dense storage case
+        template<class T>
+        static BOOST_UBLAS_INLINE
+        result_type apply (const detail::strided_vector_view<T> &v) {
+            return detail::reduce<detail::sum_reduction<T, result_type>, T, result_type> (v);
+        }
         // Sparse case
         template<class I>
         static BOOST_UBLAS_INLINE
@@ -408,6 +416,12 @@ namespace boost { namespace numeric { namespace ublas {
             }
             return t;
         }
+        // Dense storage case
+        template<class T>
+        static BOOST_UBLAS_INLINE
+        result_type apply (const detail::strided_vector_view<T> &v) {
+            return detail::reduce<detail::abs_sum_reduction<T, real_type>, T, real_type> (v);
+        }
         // Sparse case
         template<class I>
         static BOOST_UBLAS_INLINE
@@ -487,6 +501,30 @@ namespace boost { namespace numeric { namespace ublas {
                 ++ it;
             }
             return scale * type_traits<real_type>::type_sqrt (sum_squares);
+#endif
+        }
+        // Dense storage case
+        template<class T>
+        static BOOST_UBLAS_INLINE
+        result_type apply (const detail::strided_vector_view<T> &v) {
+#ifndef BOOST_UBLAS_SCALED_NORM
+            return type_traits<real_type>::type_sqrt (detail::reduce<detail::square_sum_reduction<T, real_type>, T, real_type> (v));
+#else
+            real_type scale = real_type ();
+            real_type sum_squares (1);
+            const T *p = v.data;
+            for (std::size_t i = 0; i < v.size; ++ i, p += v.stride) {
+                real_type u (type_traits<value_type>::norm_2 (*p));
+                if (scale < u) {
+                    real_type w (scale / u);
+                    sum_squares = sum_squares * w * w + real_type (1);
+                    scale = u;
+                } else if (real_type () /* zero */ != u) {
+                    real_type w (u / scale);
+                    sum_squares += w * w;
+                }
+            }
+            return scale * type_traits<real_type>::type_sqrt (sum_squares);
 #endif
         }
         // Sparse case
@@ -553,6 +591,12 @@ namespace boost { namespace numeric { namespace ublas {
             }
             return t;
         }
+        // Dense storage case
+        template<class T>
+        static BOOST_UBLAS_INLINE
+        result_type apply (const detail::strided_vector_view<T> &v) {
+            return detail::reduce<detail::abs_max_reduction<T, real_type>, T, real_type> (v);
+        }
         // Sparse case
         template<class I>
         static BOOST_UBLAS_INLINE
@@ -617,6 +661,23 @@ namespace boost { namespace numeric { namespace ublas {
             }
             return i_norm_inf;
         }
+        // Dense storage case
+        template<class T>
+        static BOOST_UBLAS_INLINE
+        result_type apply (const detail::strided_vector_view<T> &v) {
+            // ISSUE For CBLAS compatibility return 0 index in empty case
+            result_type i_norm_inf (0);
+            real_type t = real_type ();
+            const T *p = v.data;
+            for (std::size_t i = 0; i < v.size; ++ i, p += v.stride) {
+                real_type u (type_traits<value_type>::norm_inf (*p));
+                if (u > t) {
+                    i_norm_inf = i;
+                    t = u;
+                }
+            }
+            return i_norm_inf;
+        }
         // Sparse case
         template<class I>
         static BOOST_UBLAS_INLINE
@@ -657,25 +718,10 @@ namespace boost { namespace numeric { namespace ublas {
             using namespace raw;
             typedef typename C1::size_type vector_size_type;
             vector_size_type size (BOOST_UBLAS_SAME (c1 ().size (), c2 ().size ()));
-            const typename V1::value_type *data1 = data_const (c1 ());
-            const typename V1::value_type *data2 = data_const (c2 ());
-            vector_size_type s1 = stride (c1 ());
-            vector_size_type s2 = stride (c2 ());
-            result_type t = result_type (0);
-            if (s1 == 1 && s2 == 1) {
-                for (vector_size_type i = 0; i < size; ++ i)
-                    t += data1 [i] * data2 [i];
-            } else if (s2 == 1) {
-                for (vector_size_type i = 0, i1 = 0; i < size; ++ i, i1 += s1)
-                    t += data1 [i1] * data2 [i];
-            } else if (s1 == 1) {
-                for (vector_size_type i = 0, i2 = 0; i < size; ++ i, i2 += s2)
-                    t += data1 [i] * data2 [i2];
-            } else {
-                for (vector_size_type i = 0, i1 = 0, i2 = 0; i < size; ++ i, i1 += s1, i2 += s2)
-                    t += data1 [i1] * data2 [i2];
-            }
-            return t;
+            typedef typename C1::value_type value_type1;
+            typedef typename C2::value_type value_type2;
+            return apply (detail::strided_vector_view<value_type1> (data_const (c1 ()), size, stride (c1 ())),
+                          detail::strided_vector_view<value_type2> (data_const (c2 ()), size, stride (c2 ())));
 #elif defined(BOOST_UBLAS_HAVE_BINDINGS)
             return boost::numeric::bindings::atlas::dot (c1 (), c2 ());
 #else
@@ -711,6 +757,12 @@ namespace boost { namespace numeric { namespace ublas {
 #endif
             return t;
         }
+        // Dense storage case
+        template<class T1, class T2>
+        static BOOST_UBLAS_INLINE
+        result_type apply (const detail::strided_vector_view<T1> &v1, const detail::strided_vector_view<T2> &v2) {
+            return detail::dot<T1, T2, result_type> (v1, v2);
+        }
         // Packed case
         template<class I1, class I2>
         static BOOST_UBLAS_INLINE
@@ -2121,6 +2173,14 @@ namespace boost { namespace numeric { namespace ublas {
             return tmp;
         }
         
+        // Evaluates the whole product at once: c = beta * c + alpha * c1 * c2.
+        // inner is the common dimension c1.size2() == c2.size1().
+        template <typename Dest, typename Xpr1, typename Xpr2>
+        static BOOST_UBLAS_INLINE
+        void gemm (Dest& c, const Xpr1& c1, const Xpr2& c2, size_type inner, const value_type& alpha, const value_type& beta) {
+            detail::gemm<value_type> (c, c1, c2, c.size1(), c.size2(), inner, alpha, beta);
+        }
+        
     };
 
 }}}
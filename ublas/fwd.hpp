@@ -35,6 +35,9 @@ namespace boost { namespace numeric { namespace ublas {
     template<typename T, std::size_t N, size_t Alignment = alignment_trait<T>::value >
     class aligned_array;
 
+    // Selects the constructors of dense storage and containers which leave the elements uninitialized
+    struct no_init_tag {};
+
     template <class Z = std::size_t, class D = std::ptrdiff_t>
     class basic_range;
     template <class Z = std::size_t, class D = std::ptrdiff_t>
@@ -230,6 +233,8 @@ namespace boost { namespace numeric { namespace ublas {
     class compressed_matrix;
     template<class T, class L = row_major, std::size_t IB = 0, class IA = unbounded_array<std::size_t>, class TA = unbounded_array<T> >
     class coordinate_matrix;
+    template<class T, std::size_t R, std::size_t C = R, class IA = unbounded_array<std::size_t>, class TA = unbounded_array<T> >
+    class block_compressed_matrix;
 
     // expression classes
     template<class E1, class E2, class F>
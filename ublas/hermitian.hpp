@@ -253,6 +253,7 @@ namespace boost { namespace numeric { namespace ublas {
 #ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
         using matrix_container<self_type>::operator ();
 #endif
+        typedef const hermitian_matrix& nested_type;
         typedef typename A::size_type size_type;
         typedef typename A::difference_type difference_type;
         typedef T value_type;
@@ -1162,6 +1163,7 @@ namespace boost { namespace numeric { namespace ublas {
 #ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
         using matrix_expression<self_type>::operator ();
 #endif
+        typedef const hermitian_adaptor nested_type;
         typedef const M const_matrix_type;
         typedef M matrix_type;
         typedef TRI triangular_type;
@@ -18,9 +18,21 @@
 #include <boost/numeric/ublas/matrix_proxy.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/banded.hpp>
+#include <boost/numeric/ublas/detail/gemm.hpp>
+#include <boost/numeric/ublas/detail/parallel.hpp>
+#include <boost/numeric/ublas/detail/band.hpp>
 
 // LU factorizations in the spirit of LAPACK and Golub & van Loan
 
+// Width of the column panels of block_lu_factorize, and width below which a panel is factored unblocked.
+#ifndef BOOST_UBLAS_LU_BLOCK_SIZE
+#define BOOST_UBLAS_LU_BLOCK_SIZE 128
+#endif
+#ifndef BOOST_UBLAS_LU_PANEL_LEAF
+#define BOOST_UBLAS_LU_PANEL_LEAF 8
+#endif
+
 namespace boost { namespace numeric { namespace ublas {
 
     /** \brief
@@ -261,6 +273,341 @@ namespace boost { namespace numeric { namespace ublas {
         return singular;
     }
 
+    namespace detail {
+
+        // Unblocked LU with partial pivoting of the columns [j0, j0 + n), rows j0 and below.
+        // Pivot rows are swapped within the columns [c0, c1), the updates stay within [j0, j0 + n).
+        template<class M, class PM>
+        void lu_panel_unblocked (M &m, PM &pm, typename M::size_type j0, typename M::size_type n,
+                                 typename M::size_type c0, typename M::size_type c1,
+                                 typename M::size_type &singular) {
+            typedef typename M::size_type size_type;
+            typedef typename M::value_type value_type;
+
+            size_type size1 = m.size1 ();
+            size_type j1 = j0 + n;
+            for (size_type i = j0; i < j1; ++ i) {
+                size_type i_norm_inf = i + index_norm_inf (project (column (m, i), range (i, size1)));
+                BOOST_UBLAS_CHECK (i_norm_inf < size1, external_logic ());
+                if (m (i_norm_inf, i) != value_type/*zero*/()) {
+                    if (i_norm_inf != i) {
+                        pm (i) = i_norm_inf;
+                        for (size_type j = c0; j < c1; ++ j)
+                            std::swap (m (i_norm_inf, j), m (i, j));
+                    } else {
+                        BOOST_UBLAS_CHECK (pm (i) == i_norm_inf, external_logic ());
+                    }
+                    value_type m_inv = value_type (1) / m (i, i);
+                    for (size_type k = i + 1; k < size1; ++ k)
+                        m (k, i) *= m_inv;
+                } else if (singular == 0) {
+                    singular = i + 1;
+                }
+                for (size_type k = i + 1; k < size1; ++ k) {
+                    value_type t = m (k, i);
+                    if (t != value_type/*zero*/())
+                        for (size_type j = i + 1; j < j1; ++ j)
+                            m (k, j) -= t * m (i, j);
+                }
+            }
+        }
+
+        // Applies the row interchanges pm (k) of the pivots k in [k0, k1) to the columns [j0, j1) of mv.
+        template<class PM, class MV>
+        void lu_swap_rows (const PM &pm, MV &mv, typename MV::size_type k0, typename MV::size_type k1,
+                           typename MV::size_type j0, typename MV::size_type j1) {
+            typedef typename MV::size_type size_type;
+
+            for (size_type k = k0; k < k1; ++ k)
+                if (pm (k) != k)
+                    for (size_type j = j0; j < j1; ++ j)
+                        std::swap (mv (k, j), mv (pm (k), j));
+        }
+
+        // Update b [i0, i1) x [j0, j0 + nj) -= a [i0, i1) x [k0, k0 + nk) * b [k0, k0 + nk) x [j0, j0 + nj)
+        // with the packed GEMM kernel. a and b may be the same matrix as long as the blocks do not overlap.
+        template<class M, class MV>
+        void lu_update (const M &a, MV &b, typename MV::size_type i0, typename MV::size_type i1,
+                        typename MV::size_type k0, typename MV::size_type nk,
+                        typename MV::size_type j0, typename MV::size_type nj) {
+            typedef typename MV::value_type value_type;
+
+            if (i0 >= i1 || nk == 0 || nj == 0)
+                return;
+            matrix_range<MV> c (b, range (i0, i1), range (j0, j0 + nj));
+            const matrix_range<const M> l (a, range (i0, i1), range (k0, k0 + nk));
+            const matrix_range<MV> r (b, range (k0, k0 + nk), range (j0, j0 + nj));
+            gemm<value_type> (c, l, r, i1 - i0, nj, nk, value_type (-1), value_type (1));
+        }
+
+        // b [k0, k0 + nk) x [j0, j0 + nj) = L^-1 * b [k0, k0 + nk) x [j0, j0 + nj),
+        // L being the unit lower triangle of m [k0, k0 + nk) x [k0, k0 + nk).
+        // Halving nk recursively leaves all but the small diagonal solves to GEMM.
+        template<class M, class MV>
+        void lu_solve_unit_lower (const M &m, MV &b, typename MV::size_type k0, typename MV::size_type nk,
+                                  typename MV::size_type j0, typename MV::size_type nj) {
+            typedef typename MV::size_type size_type;
+            typedef typename MV::value_type value_type;
+
+            if (nj == 0)
+                return;
+            if (nk > BOOST_UBLAS_LU_PANEL_LEAF) {
+                size_type n1 = nk / 2;
+                lu_solve_unit_lower (m, b, k0, n1, j0, nj);
+                lu_update (m, b, k0 + n1, k0 + nk, k0, n1, j0, nj);
+                lu_solve_unit_lower (m, b, k0 + n1, nk - n1, j0, nj);
+                return;
+            }
+            size_type j1 = j0 + nj;
+            for (size_type k = k0; k < k0 + nk; ++ k)
+                for (size_type i = k + 1; i < k0 + nk; ++ i) {
+                    value_type t = m (i, k);
+                    if (t != value_type/*zero*/())
+                        for (size_type j = j0; j < j1; ++ j)
+                            b (i, j) -= t * b (k, j);
+                }
+        }
+
+        // b [k0, k0 + nk) x [j0, j0 + nj) = U^-1 * b [k0, k0 + nk) x [j0, j0 + nj),
+        // U being the upper triangle of m [k0, k0 + nk) x [k0, k0 + nk), recursively like lu_solve_unit_lower.
+        template<class M, class MV>
+        void lu_solve_upper (const M &m, MV &b, typename MV::size_type k0, typename MV::size_type nk,
+                             typename MV::size_type j0, typename MV::size_type nj) {
+            typedef typename MV::size_type size_type;
+            typedef typename MV::value_type value_type;
+
+            if (nj == 0)
+                return;
+            if (nk > BOOST_UBLAS_LU_PANEL_LEAF) {
+                size_type n1 = nk / 2;
+                lu_solve_upper (m, b, k0 + n1, nk - n1, j0, nj);
+                lu_update (m, b, k0, k0 + n1, k0 + n1, nk - n1, j0, nj);
+                lu_solve_upper (m, b, k0, n1, j0, nj);
+                return;
+            }
+            size_type j1 = j0 + nj;
+            for (size_type k = k0 + nk; k -- > k0; ) {
+#ifndef BOOST_UBLAS_SINGULAR_CHECK
+                BOOST_UBLAS_CHECK (m (k, k) != value_type/*zero*/(), singular ());
+#else
+                if (m (k, k) == value_type/*zero*/())
+                    singular ().raise ();
+#endif
+                value_type m_inv = value_type (1) / m (k, k);
+                for (size_type j = j0; j < j1; ++ j)
+                    b (k, j) *= m_inv;
+                for (size_type i = k0; i < k; ++ i) {
+                    value_type t = m (i, k);
+                    if (t != value_type/*zero*/())
+                        for (size_type j = j0; j < j1; ++ j)
+                            b (i, j) -= t * b (k, j);
+                }
+            }
+        }
+
+        // Recursive LU of the panel [j0, j0 + n): factor the left half, update the right half with
+        // a triangular solve and a GEMM, then factor the right half. Almost all the flops of the panel
+        // end up in GEMM calls, only the leaves of width BOOST_UBLAS_LU_PANEL_LEAF are unblocked.
+        // Pivot rows are swapped within the columns [c0, c1).
+        template<class M, class PM>
+        void lu_panel_recursive (M &m, PM &pm, typename M::size_type j0, typename M::size_type n,
+                                 typename M::size_type c0, typename M::size_type c1,
+                                 typename M::size_type &singular) {
+            typedef typename M::size_type size_type;
+
+            if (n <= BOOST_UBLAS_LU_PANEL_LEAF) {
+                lu_panel_unblocked (m, pm, j0, n, c0, c1, singular);
+                return;
+            }
+            size_type n1 = n / 2;
+            lu_panel_recursive (m, pm, j0, n1, c0, c1, singular);
+            lu_solve_unit_lower (m, m, j0, n1, j0 + n1, n - n1);
+            lu_update (m, m, j0 + n1, m.size1 (), j0, n1, j0 + n1, n - n1);
+            lu_panel_recursive (m, pm, j0 + n1, n - n1, c0, c1, singular);
+        }
+
+    }
+
+    // Blocked right-looking LU factorization with partial pivoting.
+    // Same results, pivots and return value as lu_factorize (m, pm), up to rounding,
+    // but the rank-1 updates are gathered into GEMM calls: each panel of BOOST_UBLAS_LU_BLOCK_SIZE columns
+    // is factored recursively, then the rows right of it are solved and the trailing matrix updated at once.
+    template<class M, class PM>
+    typename M::size_type block_lu_factorize (M &m, PM &pm) {
+        typedef typename M::size_type size_type;
+
+#if BOOST_UBLAS_TYPE_CHECK
+        typedef M matrix_type;
+        matrix_type cm (m);
+#endif
+        size_type singular = 0;
+        size_type size1 = m.size1 ();
+        size_type size2 = m.size2 ();
+        size_type size = (std::min) (size1, size2);
+        const size_type nb = BOOST_UBLAS_LU_BLOCK_SIZE;
+        for (size_type j0 = 0; j0 < size; j0 += nb) {
+            size_type jb = (std::min) (nb, size - j0);
+            detail::lu_panel_recursive (m, pm, j0, jb, size_type (0), size2, singular);
+            detail::lu_solve_unit_lower (m, m, j0, jb, j0 + jb, size2 - j0 - jb);
+            detail::lu_update (m, m, j0 + jb, size1, j0, jb, j0 + jb, size2 - j0 - jb);
+        }
+#if BOOST_UBLAS_TYPE_CHECK
+        swap_rows (pm, cm);
+        BOOST_UBLAS_CHECK (singular != 0 ||
+                           detail::expression_type_check (prod (triangular_adaptor<matrix_type, unit_lower> (m),
+                                                                triangular_adaptor<matrix_type, upper> (m)), cm), internal_logic ());
+#endif
+        return singular;
+    }
+
+    // Tiled LU factorization with partial pivoting, run as a graph of tasks on the thread pool.
+    // Same results, pivots and return value as block_lu_factorize (m, pm). Step k factors the panel of the k-th
+    // column block, then for every column block j right of it swaps and solves the tile (k, j) and updates
+    // the tiles (i, j) below it, each of these being a task depending only on the tiles it reads,
+    // so the panel of step k + 1 starts as soon as its own column block is updated, while the rest of
+    // the trailing matrix of step k is still being updated. The pivots are applied to the columns left
+    // of each panel once the graph has run.
+    template<class M, class PM>
+    typename M::size_type parallel_lu_factorize (M &m, PM &pm) {
+        typedef typename M::size_type size_type;
+        typedef detail::task_graph::task_id task_id;
+
+#if BOOST_UBLAS_TYPE_CHECK
+        typedef M matrix_type;
+        matrix_type cm (m);
+#endif
+        size_type singular = 0;
+        size_type size1 = m.size1 ();
+        size_type size2 = m.size2 ();
+        size_type size = (std::min) (size1, size2);
+        const size_type nb = BOOST_UBLAS_LU_BLOCK_SIZE;
+        const size_type steps = (size + nb - 1) / nb;
+        const size_type rows = (size1 + nb - 1) / nb;
+        const size_type cols = (size2 + nb - 1) / nb;
+        const task_id none = task_id (-1);
+
+        detail::task_graph graph;
+        // last task having written the tile (i, j)
+        std::vector<task_id> last (rows * cols, none);
+        for (size_type k = 0; k < steps; ++ k) {
+            const size_type k0 = k * nb;
+            const size_type kb = (std::min) (nb, size - k0);
+            const size_type c1 = (std::min) (k0 + nb, size2);
+            // on a wide matrix the last column block is wider than its panel
+            task_id panel = graph.add ([&m, &pm, &singular, k0, kb, c1] {
+                detail::lu_panel_recursive (m, pm, k0, kb, k0, c1, singular);
+                detail::lu_solve_unit_lower (m, m, k0, kb, k0 + kb, c1 - k0 - kb);
+            });
+            for (size_type i = k; i < rows; ++ i)
+                if (last [i * cols + k] != none)
+                    graph.depend (last [i * cols + k], panel);
+
+            for (size_type j = k + 1; j < cols; ++ j) {
+                const size_type j0 = j * nb;
+                const size_type jb = (std::min) (nb, size2 - j0);
+                task_id solve = graph.add ([&m, &pm, k0, kb, j0, jb] {
+                    detail::lu_swap_rows (pm, m, k0, k0 + kb, j0, j0 + jb);
+                    detail::lu_solve_unit_lower (m, m, k0, kb, j0, jb);
+                });
+                graph.depend (panel, solve);
+                // the row interchanges reach every tile of the column block below the diagonal
+                for (size_type i = k; i < rows; ++ i)
+                    if (last [i * cols + j] != none)
+                        graph.depend (last [i * cols + j], solve);
+
+                for (size_type i = k + 1; i < rows; ++ i) {
+                    const size_type i0 = i * nb;
+                    const size_type i1 = (std::min) (i0 + nb, size1);
+                    task_id update = graph.add ([&m, i0, i1, k0, kb, j0, jb] {
+                        detail::lu_update (m, m, i0, i1, k0, kb, j0, jb);
+                    });
+                    graph.depend (solve, update);
+                    last [i * cols + j] = update;
+                }
+            }
+        }
+        graph.run ();
+
+        detail::parallel_for (0, steps, 1, [&m, &pm, nb, size] (size_type begin, size_type end) {
+            for (size_type k = begin; k < end; ++ k)
+                detail::lu_swap_rows (pm, m, (k + 1) * nb, size, k * nb, (std::min) ((k + 1) * nb, size));
+        });
+#if BOOST_UBLAS_TYPE_CHECK
+        swap_rows (pm, cm);
+        BOOST_UBLAS_CHECK (singular != 0 ||
+                           detail::expression_type_check (prod (triangular_adaptor<matrix_type, unit_lower> (m),
+                                                                triangular_adaptor<matrix_type, upper> (m)), cm), internal_logic ());
+#endif
+        return singular;
+    }
+
+    // Tiled LU substitution for several right hand sides, the columns of mv, run as a graph of tasks.
+    // Every column block of mv is permuted, then solved tile by tile against L and U, the updates
+    // of the tiles below (above) a solved tile running in parallel with the solves that follow.
+    template<class M, class PMT, class PMA, class MV>
+    void parallel_lu_substitute (const M &m, const permutation_matrix<PMT, PMA> &pm, MV &mv) {
+        typedef typename MV::size_type size_type;
+        typedef detail::task_graph::task_id task_id;
+
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == mv.size1 (), bad_size ());
+        size_type size = mv.size1 ();
+        size_type size2 = mv.size2 ();
+        const size_type nb = BOOST_UBLAS_LU_BLOCK_SIZE;
+        const size_type steps = (size + nb - 1) / nb;
+        const size_type cols = (size2 + nb - 1) / nb;
+
+        detail::task_graph graph;
+        // last task having written the tile (i, j) of the current column block
+        std::vector<task_id> last (steps);
+        for (size_type j = 0; j < cols; ++ j) {
+            const size_type j0 = j * nb;
+            const size_type jb = (std::min) (nb, size2 - j0);
+            task_id swap = graph.add ([&pm, &mv, size, j0, jb] {
+                detail::lu_swap_rows (pm, mv, 0, size, j0, j0 + jb);
+            });
+            std::fill (last.begin (), last.end (), swap);
+
+            for (size_type k = 0; k < steps; ++ k) {
+                const size_type k0 = k * nb;
+                const size_type kb = (std::min) (nb, size - k0);
+                task_id solve = graph.add ([&m, &mv, k0, kb, j0, jb] {
+                    detail::lu_solve_unit_lower (m, mv, k0, kb, j0, jb);
+                });
+                graph.depend (last [k], solve);
+                last [k] = solve;
+                for (size_type i = k + 1; i < steps; ++ i) {
+                    const size_type i0 = i * nb;
+                    task_id update = graph.add ([&m, &mv, i0, size, nb, k0, kb, j0, jb] {
+                        detail::lu_update (m, mv, i0, (std::min) (i0 + nb, size), k0, kb, j0, jb);
+                    });
+                    graph.depend (solve, update);
+                    graph.depend (last [i], update);
+                    last [i] = update;
+                }
+            }
+            for (size_type k = steps; k -- > 0; ) {
+                const size_type k0 = k * nb;
+                const size_type kb = (std::min) (nb, size - k0);
+                task_id solve = graph.add ([&m, &mv, k0, kb, j0, jb] {
+                    detail::lu_solve_upper (m, mv, k0, kb, j0, jb);
+                });
+                graph.depend (last [k], solve);
+                last [k] = solve;
+                for (size_type i = 0; i < k; ++ i) {
+                    const size_type i0 = i * nb;
+                    task_id update = graph.add ([&m, &mv, i0, nb, k0, kb, j0, jb] {
+                        detail::lu_update (m, mv, i0, i0 + nb, k0, kb, j0, jb);
+                    });
+                    graph.depend (solve, update);
+                    graph.depend (last [i], update);
+                    last [i] = update;
+                }
+            }
+        }
+        graph.run ();
+    }
+
     // LU substitution
     template<class M, class E>
     void lu_substitute (const M &m, vector_expression<E> &e) {
@@ -345,6 +692,277 @@ namespace boost { namespace numeric { namespace ublas {
         lu_substitute (mv, m);
     }
 
+
+    namespace detail {
+
+        // a (i, k) -= a (i, j) * a (j, k) for the rows [i0, i1) and the columns [k0, k1) of a band, along its rows
+        template<class A>
+        void banded_lu_update (const A &a, std::size_t j, std::size_t i0, std::size_t i1, std::size_t k0, std::size_t k1, row_major_tag) {
+            typedef typename A::value_type value_type;
+
+            for (std::size_t i = i0; i < i1; ++ i) {
+                const value_type l = a (i, j);
+                if (l != value_type/*zero*/())
+                    for (std::size_t k = k0; k < k1; ++ k)
+                        a (i, k) -= l * a (j, k);
+            }
+        }
+        // the same along the columns of the band
+        template<class A>
+        void banded_lu_update (const A &a, std::size_t j, std::size_t i0, std::size_t i1, std::size_t k0, std::size_t k1, column_major_tag) {
+            typedef typename A::value_type value_type;
+
+            for (std::size_t k = k0; k < k1; ++ k) {
+                const value_type u = a (j, k);
+                if (u != value_type/*zero*/())
+                    for (std::size_t i = i0; i < i1; ++ i)
+                        a (i, k) -= a (i, j) * u;
+            }
+        }
+
+        // Right looking LU factorization without pivoting of a band of lower and upper diagonals,
+        // in O (n * lower * upper) operations. Returns 0, or the index + 1 of the first zero pivot.
+        template<class A, class O>
+        std::size_t banded_lu_factorize (const A &a, std::size_t size1, std::size_t size2, std::size_t lower, std::size_t upper, O) {
+            typedef typename A::value_type value_type;
+
+            std::size_t singular = 0;
+            const std::size_t size = (std::min) (size1, size2);
+            for (std::size_t j = 0; j < size; ++ j) {
+                const std::size_t i1 = (std::min) (j + lower + 1, size1);
+                const std::size_t k1 = (std::min) (j + upper + 1, size2);
+                if (a (j, j) != value_type/*zero*/()) {
+                    const value_type m_inv = value_type (1) / a (j, j);
+                    for (std::size_t i = j + 1; i < i1; ++ i)
+                        a (i, j) *= m_inv;
+                } else if (singular == 0) {
+                    singular = j + 1;
+                }
+                banded_lu_update (a, j, j + 1, i1, j + 1, k1, O ());
+            }
+            return singular;
+        }
+
+        // The same for a tridiagonal band, as the elimination of the Thomas algorithm
+        template<class A>
+        std::size_t tridiagonal_lu_factorize (const A &a, std::size_t size1, std::size_t size2) {
+            typedef typename A::value_type value_type;
+
+            std::size_t singular = 0;
+            const std::size_t size = (std::min) (size1, size2);
+            for (std::size_t j = 0; j < size; ++ j) {
+                const value_type d = a (j, j);
+                if (d == value_type/*zero*/() && singular == 0)
+                    singular = j + 1;
+                if (j + 1 < size1) {
+                    if (d != value_type/*zero*/())
+                        a (j + 1, j) /= d;
+                    if (j + 1 < size2)
+                        a (j + 1, j + 1) -= a (j + 1, j) * a (j, j + 1);
+                }
+            }
+            return singular;
+        }
+
+        // Right looking LU factorization with partial pivoting of a band of lower and upper diagonals, as LAPACK gbtf2,
+        // in O (n * lower * (lower + upper)) operations. A row interchange moves elements up to lower diagonals above
+        // the band, which a must hold as extra upper diagonals. The interchanges are not applied to the multipliers
+        // of the previous columns. Returns 0, or the index + 1 of the first zero pivot.
+        template<class A, class PM, class O>
+        std::size_t banded_lu_factorize (const A &a, std::size_t size1, std::size_t size2, std::size_t lower, std::size_t upper, PM &pm, O) {
+            typedef typename A::value_type value_type;
+            typedef typename type_traits<value_type>::real_type real_type;
+
+            std::size_t singular = 0;
+            // end of the columns reached by the interchanges so far
+            std::size_t ju = 0;
+            const std::size_t size = (std::min) (size1, size2);
+            for (std::size_t j = 0; j < size; ++ j) {
+                const std::size_t i1 = (std::min) (j + lower + 1, size1);
+                std::size_t p = j;
+                real_type norm = type_traits<value_type>::norm_inf (a (j, j));
+                for (std::size_t i = j + 1; i < i1; ++ i) {
+                    const real_type t = type_traits<value_type>::norm_inf (a (i, j));
+                    if (t > norm) {
+                        norm = t;
+                        p = i;
+                    }
+                }
+                if (a (p, j) != value_type/*zero*/()) {
+                    ju = (std::max) (ju, (std::min) (p + upper + 1, size2));
+                    if (p != j) {
+                        pm (j) = p;
+                        for (std::size_t k = j; k < ju; ++ k)
+                            std::swap (a (j, k), a (p, k));
+                    } else {
+                        BOOST_UBLAS_CHECK (pm (j) == p, external_logic ());
+                    }
+                    const value_type m_inv = value_type (1) / a (j, j);
+                    for (std::size_t i = j + 1; i < i1; ++ i)
+                        a (i, j) *= m_inv;
+                    banded_lu_update (a, j, j + 1, i1, j + 1, ju, O ());
+                } else if (singular == 0) {
+                    singular = j + 1;
+                }
+            }
+            return singular;
+        }
+
+        // e = U^-1 L^-1 P e for the factors of banded_lu_factorize, U having upper diagonals and the unit lower L
+        // lower ones, the interchanges pm being applied as the columns of L are, or none if pm is null
+        template<class A, class PM, class E>
+        void banded_lu_substitute (const A &a, std::size_t size, std::size_t lower, std::size_t upper, const PM *pm, E &e, vector_tag) {
+            typedef typename E::value_type value_type;
+
+            for (std::size_t j = 0; j < size; ++ j) {
+                if (pm && (*pm) (j) != j)
+                    std::swap (e (j), e ((*pm) (j)));
+                const value_type t = e (j);
+                if (t != value_type/*zero*/()) {
+                    const std::size_t i1 = (std::min) (j + lower + 1, size);
+                    for (std::size_t i = j + 1; i < i1; ++ i)
+                        e (i) -= a (i, j) * t;
+                }
+            }
+            for (std::size_t j = size; j -- > 0; ) {
+                e (j) /= a (j, j);
+                const value_type t = e (j);
+                if (t != value_type/*zero*/()) {
+                    const std::size_t i0 = j > upper ? j - upper : 0;
+                    for (std::size_t i = i0; i < j; ++ i)
+                        e (i) -= a (i, j) * t;
+                }
+            }
+        }
+        template<class A, class PM, class E>
+        void banded_lu_substitute (const A &a, std::size_t size, std::size_t lower, std::size_t upper, const PM *pm, E &e, matrix_tag) {
+            typedef typename E::value_type value_type;
+
+            const std::size_t nrhs = e.size2 ();
+            for (std::size_t j = 0; j < size; ++ j) {
+                if (pm && (*pm) (j) != j)
+                    row (e, j).swap (row (e, (*pm) (j)));
+                const std::size_t i1 = (std::min) (j + lower + 1, size);
+                for (std::size_t i = j + 1; i < i1; ++ i) {
+                    const value_type l = a (i, j);
+                    if (l != value_type/*zero*/())
+                        for (std::size_t c = 0; c < nrhs; ++ c)
+                            e (i, c) -= l * e (j, c);
+                }
+            }
+            for (std::size_t j = size; j -- > 0; ) {
+                const value_type d = a (j, j);
+                for (std::size_t c = 0; c < nrhs; ++ c)
+                    e (j, c) /= d;
+                const std::size_t i0 = j > upper ? j - upper : 0;
+                for (std::size_t i = i0; i < j; ++ i) {
+                    const value_type u = a (i, j);
+                    if (u != value_type/*zero*/())
+                        for (std::size_t c = 0; c < nrhs; ++ c)
+                            e (i, c) -= u * e (j, c);
+                }
+            }
+        }
+
+        // e = U^-1 L^-1 e for the factors of tridiagonal_lu_factorize, the two sweeps of the Thomas algorithm
+        template<class A, class E>
+        void tridiagonal_lu_substitute (const A &a, std::size_t size, E &e) {
+            if (size == 0)
+                return;
+            for (std::size_t i = 1; i < size; ++ i)
+                e (i) -= a (i, i - 1) * e (i - 1);
+            e (size - 1) /= a (size - 1, size - 1);
+            for (std::size_t i = size - 1; i -- > 0; )
+                e (i) = (e (i) - a (i, i + 1) * e (i + 1)) / a (i, i);
+        }
+
+    }
+
+    // LU factorization without pivoting of a banded matrix, in place and within the band: the unit lower factor
+    // takes the lower diagonals, the upper factor the diagonal and the upper diagonals. Tridiagonal matrices
+    // are factored as by the Thomas algorithm.
+    template<class T, class L, class A>
+    typename banded_matrix<T, L, A>::size_type lu_factorize (banded_matrix<T, L, A> &m) {
+        typedef banded_matrix<T, L, A> matrix_type;
+        typedef detail::band_storage<matrix_type> storage_type;
+        typedef typename L::orientation_category orientation_category;
+
+        const typename storage_type::type a (storage_type::view (m));
+        if (m.lower () == 1 && m.upper () == 1)
+            return detail::tridiagonal_lu_factorize (a, m.size1 (), m.size2 ());
+        return detail::banded_lu_factorize (a, m.size1 (), m.size2 (), m.lower (), m.upper (), orientation_category ());
+    }
+
+    // LU factorization with partial pivoting of a banded matrix with l lower diagonals, as LAPACK gbtrf.
+    // The row interchanges fill in up to l diagonals above the band, so m first gains l upper diagonals.
+    // m then holds the upper factor in its diagonal and upper diagonals and the multipliers in its lower ones.
+    // The multipliers are not permuted by the later interchanges, so the factors are only meant for
+    // lu_substitute (m, pm, mv).
+    template<class T, class L, class A, class PM>
+    typename banded_matrix<T, L, A>::size_type lu_factorize (banded_matrix<T, L, A> &m, PM &pm) {
+        typedef banded_matrix<T, L, A> matrix_type;
+        typedef typename matrix_type::size_type size_type;
+        typedef typename matrix_type::value_type value_type;
+        typedef detail::band_storage<matrix_type> storage_type;
+        typedef detail::band_storage<const matrix_type> const_storage_type;
+        typedef typename L::orientation_category orientation_category;
+
+        const size_type size1 = m.size1 ();
+        const size_type size2 = m.size2 ();
+        const size_type lower = m.lower ();
+        const size_type upper = m.upper ();
+        if (lower > 0) {
+            matrix_type w (size1, size2, lower, upper + lower);
+            std::fill (w.data ().begin (), w.data ().end (), value_type/*zero*/());
+            const typename storage_type::type wa (storage_type::view (w));
+            const typename const_storage_type::type ma (const_storage_type::view (m));
+            for (size_type i = 0; i < size1; ++ i) {
+                const size_type j1 = (std::min) (i + upper + 1, size2);
+                for (size_type j = i > lower ? i - lower : 0; j < j1; ++ j)
+                    wa (i, j) = ma (i, j);
+            }
+            m.swap (w);
+        }
+        const typename storage_type::type a (storage_type::view (m));
+        return detail::banded_lu_factorize (a, size1, size2, lower, upper, pm, orientation_category ());
+    }
+
+    // Banded LU substitution: solves m x = e in place, m being factored by lu_factorize (m)
+    template<class T, class L, class A, class E>
+    void lu_substitute (const banded_matrix<T, L, A> &m, vector_expression<E> &e) {
+        typedef const banded_matrix<T, L, A> matrix_type;
+        typedef detail::band_storage<matrix_type> storage_type;
+
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size (), bad_size ());
+        const typename storage_type::type a (storage_type::view (m));
+        if (m.lower () == 1 && m.upper () == 1)
+            detail::tridiagonal_lu_substitute (a, m.size1 (), e ());
+        else
+            detail::banded_lu_substitute (a, m.size1 (), m.lower (), m.upper (), static_cast<const permutation_matrix<> *> (0), e (), vector_tag ());
+    }
+    template<class T, class L, class A, class E>
+    void lu_substitute (const banded_matrix<T, L, A> &m, matrix_expression<E> &e) {
+        typedef const banded_matrix<T, L, A> matrix_type;
+        typedef detail::band_storage<matrix_type> storage_type;
+
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size1 (), bad_size ());
+        const typename storage_type::type a (storage_type::view (m));
+        detail::banded_lu_substitute (a, m.size1 (), m.lower (), m.upper (), static_cast<const permutation_matrix<> *> (0), e (), matrix_tag ());
+    }
+    // Banded LU substitution: solves m x = mv in place, m and pm being factored by lu_factorize (m, pm)
+    template<class T, class L, class A, class PMT, class PMA, class MV>
+    void lu_substitute (const banded_matrix<T, L, A> &m, const permutation_matrix<PMT, PMA> &pm, MV &mv) {
+        typedef const banded_matrix<T, L, A> matrix_type;
+        typedef detail::band_storage<matrix_type> storage_type;
+
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == pm.size (), bad_size ());
+        const typename storage_type::type a (storage_type::view (m));
+        detail::banded_lu_substitute (a, m.size1 (), m.lower (), m.upper (), &pm, mv, typename MV::type_category ());
+    }
+
 }}}
 
 #endif
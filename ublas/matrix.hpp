@@ -76,6 +76,45 @@ namespace boost { namespace numeric {
             }
             m.assign_temporary (temporary);
         }
+
+        // Construction of the temporaries receiving the result of a product, all their elements being written
+        // by the product. Dense containers over an unbounded_array leave the elements uninitialized, so that
+        // they are first touched by the threads computing them; other containers are constructed as usual.
+        template <class V>
+        struct uninitialized_vector {
+            typedef V vector_type;
+
+            static vector_type construct (typename vector_type::size_type size) {
+                return vector_type (size);
+            }
+        };
+
+        template <class T, class ALLOC>
+        struct uninitialized_vector<vector<T, unbounded_array<T, ALLOC> > > {
+            typedef vector<T, unbounded_array<T, ALLOC> > vector_type;
+
+            static vector_type construct (typename vector_type::size_type size) {
+                return vector_type (size, no_init_tag ());
+            }
+        };
+
+        template <class M>
+        struct uninitialized_matrix {
+            typedef M matrix_type;
+
+            static matrix_type construct (typename matrix_type::size_type size1, typename matrix_type::size_type size2) {
+                return matrix_type (size1, size2);
+            }
+        };
+
+        template <class T, class L, class ALLOC>
+        struct uninitialized_matrix<matrix<T, L, unbounded_array<T, ALLOC> > > {
+            typedef matrix<T, L, unbounded_array<T, ALLOC> > matrix_type;
+
+            static matrix_type construct (typename matrix_type::size_type size1, typename matrix_type::size_type size2) {
+                return matrix_type (size1, size2, no_init_tag ());
+            }
+        };
     }
 
     /** \brief A dense matrix of values of type \c T.
@@ -148,6 +187,18 @@ namespace boost { namespace numeric {
 	        size1_ (size1), size2_ (size2), data_ (layout_type::storage_size (size1, size2), init) {
 	    }
 
+	  /** Dense matrix constructor with defined size leaving the elements uninitialized.
+	   * Use it for matrices entirely overwritten afterwards, such as the result of a product:
+	   * the memory is then first touched by the code computing the elements.
+	   * \param size1 number of rows
+	   * \param size2 number of columns
+	   */
+	    BOOST_UBLAS_INLINE
+	    matrix (size_type size1, size_type size2, no_init_tag):
+	        matrix_container<self_type> (),
+	        size1_ (size1), size2_ (size2), data_ (layout_type::storage_size (size1, size2), no_init_tag ()) {
+	    }
+
 	  /** Dense matrix constructor with defined size and an initial data array
 	   * \param size1 number of rows
 	   * \param size2 number of columns
@@ -166,6 +217,29 @@ namespace boost { namespace numeric {
             matrix_container<self_type> (),
             size1_ (m.size1_), size2_ (m.size2_), data_ (m.data_) {}
 
+#ifdef BOOST_UBLAS_CPP_GE_2011
+	  /** Move-constructor of a dense matrix, taking over the storage of m which is left of size (0,0)
+	   * \param m is a dense matrix
+	   */
+        BOOST_UBLAS_INLINE
+        matrix (matrix &&m) BOOST_NOEXCEPT_IF (std::is_nothrow_move_constructible<array_type>::value):
+            matrix_container<self_type> (),
+            size1_ (m.size1_), size2_ (m.size2_), data_ (std::move (m.data_)) {
+            m.size1_ = 0;
+            m.size2_ = 0;
+        }
+
+	  /** Dense matrix constructor with defined size taking over an initial data array
+	   * \param size1 number of rows
+	   * \param size2 number of columns
+	   * \param data array to move into the matrix. Must have the same dimension as the matrix
+	   */
+        BOOST_UBLAS_INLINE
+        matrix (size_type size1, size_type size2, array_type &&data):
+            matrix_container<self_type> (),
+            size1_ (size1), size2_ (size2), data_ (std::move (data)) {}
+#endif
+
 	  /** Copy-constructor of a dense matrix from a matrix expression
 	   * \param ae is a matrix expression
 	   */
@@ -304,8 +378,23 @@ namespace boost { namespace numeric {
         using matrix_expression< matrix<T, L, A> >::operator+=;
         using matrix_expression< matrix<T, L, A> >::operator-=;
 
+    // Products are accumulated in place by the packed GEMM kernel of the tree optimizer assignment.
+    // As with the product assignment of matrix_expression, the product must not alias this matrix.
+        template<class E1, class E2>
+        BOOST_UBLAS_INLINE
+        matrix& operator += (const general_product<E1, E2, dmatdmatprod<E1, E2> > &p) {
+            ublas::assign (*this, p, scalar_plus_assign<value_type, typename dmatdmatprod<E1, E2>::value_type> ());
+            return *this;
+        }
+        template<class E1, class E2>
+        BOOST_UBLAS_INLINE
+        matrix& operator -= (const general_product<E1, E2, dmatdmatprod<E1, E2> > &p) {
+            ublas::assign (*this, p, scalar_minus_assign<value_type, typename dmatdmatprod<E1, E2>::value_type> ());
+            return *this;
+        }
+
         // Assignment
-#ifdef BOOST_UBLAS_MOVE_SEMANTICS
+#if defined (BOOST_UBLAS_MOVE_SEMANTICS) && ! defined (BOOST_UBLAS_CPP_GE_2011)
 
         /*! @note "pass by value" the key idea to enable move semantics */
         BOOST_UBLAS_INLINE
@@ -321,6 +410,14 @@ namespace boost { namespace numeric {
             data () = m.data ();
             return *this;
         }
+#endif
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        /*! @note temporaries are swapped in, their storage is released with them */
+        BOOST_UBLAS_INLINE
+        matrix &operator = (matrix &&m) BOOST_NOEXCEPT {
+            assign_temporary (m);
+            return *this;
+        }
 #endif
         template<class C>          // Container assignment without temporary
         BOOST_UBLAS_INLINE
@@ -1162,8 +1259,8 @@ namespace boost { namespace numeric {
         typedef typename L::orientation_category orientation_category;
             
         enum {
-            ColsAtCompileTime = M,
-            RowsAtCompileTime = N,
+            RowsAtCompileTime = M,
+            ColsAtCompileTime = N,
             SizeAtCompileTime = M * N,
         };
 
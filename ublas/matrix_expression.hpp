@@ -1246,6 +1246,7 @@ namespace boost { namespace numeric { namespace ublas {
 #ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
         using matrix_expression<self_type>::operator ();
 #endif
+        typedef const matrix_unary2 nested_type;
         typedef typename E::size_type size_type;
         typedef typename E::difference_type difference_type;
         typedef typename F::result_type value_type;
@@ -2475,6 +2476,12 @@ namespace boost { namespace numeric { namespace ublas {
 #endif
     };
 
+    /*
+        Old ublas matrix sum and difference. These are superseded by matrix_expression::operator+ and operator-,
+        which build dmatdmatsum / dmatdmatsub expressions for the tree optimizer. Both overload sets are equally
+        good matches for two matrix expressions, so keeping them would make every A + B ambiguous.
+    */
+/*
     // (m1 + m2) [i] [j] = m1 [i] [j] + m2 [i] [j]
     template<class E1, class E2>
     BOOST_UBLAS_INLINE
@@ -2498,6 +2505,7 @@ namespace boost { namespace numeric { namespace ublas {
                                                                    typename E2::value_type> >::expression_type expression_type;
         return expression_type (e1 (), e2 ());
     }
+*/
 
     // (m1 * m2) [i] [j] = m1 [i] [j] * m2 [i] [j]
     template<class E1, class E2>
@@ -2527,11 +2535,16 @@ namespace boost { namespace numeric { namespace ublas {
     class matrix_binary_scalar1:
         public matrix_expression<matrix_binary_scalar1<E1, E2, F> > {
 
+    public:
+        typedef const matrix_binary_scalar1 nested_type;
+    private:
         typedef E1 expression1_type;
         typedef E2 expression2_type;
         typedef F functor_type;
+    public:
         typedef const E1& expression1_closure_type;
         typedef typename E2::const_closure_type expression2_closure_type;
+    private:
         typedef matrix_binary_scalar1<E1, E2, F> self_type;
     public:
 #ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
@@ -2562,6 +2575,17 @@ namespace boost { namespace numeric { namespace ublas {
             return e2_.size2 ();
         }
 
+    public:
+        // Expression accessors
+        BOOST_UBLAS_INLINE
+        const expression1_closure_type &expression1 () const {
+            return e1_;
+        }
+        BOOST_UBLAS_INLINE
+        const expression2_closure_type &expression2 () const {
+            return e2_;
+        }
+
     public:
         // Element access
         BOOST_UBLAS_INLINE
@@ -2959,6 +2983,9 @@ namespace boost { namespace numeric { namespace ublas {
     class matrix_binary_scalar2:
         public matrix_expression<matrix_binary_scalar2<E1, E2, F> > {
 
+    public:
+        typedef const matrix_binary_scalar2 nested_type;
+    private:
         typedef E1 expression1_type;
         typedef E2 expression2_type;
         typedef F functor_type;
@@ -2997,6 +3024,17 @@ namespace boost { namespace numeric { namespace ublas {
             return e1_.size2 ();
         }
 
+    public:
+        // Expression accessors
+        BOOST_UBLAS_INLINE
+        const expression1_closure_type &expression1 () const {
+            return e1_;
+        }
+        BOOST_UBLAS_INLINE
+        const expression2_closure_type &expression2 () const {
+            return e2_;
+        }
+
     public:
         // Element access
         BOOST_UBLAS_INLINE
@@ -16,6 +16,9 @@
 #include <boost/numeric/ublas/vector_sparse.hpp>
 #include <boost/numeric/ublas/matrix_expression.hpp>
 #include <boost/numeric/ublas/detail/matrix_assign.hpp>
+#include <boost/numeric/ublas/detail/radix_sort.hpp>
+#include <algorithm>
+#include <vector>
 #if BOOST_UBLAS_TYPE_CHECK
 #include <boost/numeric/ublas/matrix.hpp>
 #endif
@@ -277,6 +280,7 @@ namespace boost { namespace numeric { namespace ublas {
 #ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
         using matrix_container<self_type>::operator ();
 #endif
+        typedef const mapped_matrix& nested_type;
         typedef typename A::size_type size_type;
         typedef typename A::difference_type difference_type;
         typedef T value_type;
@@ -309,6 +313,16 @@ namespace boost { namespace numeric { namespace ublas {
         mapped_matrix (const mapped_matrix &m):
             matrix_container<self_type> (),
             size1_ (m.size1_), size2_ (m.size2_), data_ (m.data_) {}
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        // Takes over the elements of m, left of size (0, 0)
+        BOOST_UBLAS_INLINE
+        mapped_matrix (mapped_matrix &&m) BOOST_NOEXCEPT_IF (std::is_nothrow_move_constructible<array_type>::value):
+            matrix_container<self_type> (),
+            size1_ (m.size1_), size2_ (m.size2_), data_ (std::move (m.data_)) {
+            m.size1_ = 0;
+            m.size2_ = 0;
+        }
+#endif
         template<class AE>
         BOOST_UBLAS_INLINE
         mapped_matrix (const matrix_expression<AE> &ae, size_type non_zeros = 0):
@@ -451,6 +465,12 @@ namespace boost { namespace numeric { namespace ublas {
             assign (m);
             return *this;
         }
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        BOOST_UBLAS_INLINE
+        mapped_matrix &operator = (mapped_matrix &&m) BOOST_NOEXCEPT {
+            return assign_temporary (m);
+        }
+#endif
         BOOST_UBLAS_INLINE
         mapped_matrix &assign_temporary (mapped_matrix &m) {
             swap (m);
@@ -2632,6 +2652,7 @@ namespace boost { namespace numeric { namespace ublas {
 #ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
         using matrix_container<self_type>::operator ();
 #endif
+        typedef const compressed_matrix& nested_type;
         // ISSUE require type consistency check
         // is_convertable (IA::size_type, TA::size_type)
         typedef typename IA::value_type size_type;
@@ -2682,6 +2703,25 @@ namespace boost { namespace numeric { namespace ublas {
             index1_data_ (m.index1_data_), index2_data_ (m.index2_data_), value_data_ (m.value_data_) {
             storage_invariants ();
         }
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        // Takes over the storage of m, left of size (0, 0) without any storage, not even the single
+        // index1 entry of an empty matrix (filled1 () == 0), so that moving never allocates
+        BOOST_UBLAS_INLINE
+        compressed_matrix (compressed_matrix &&m)
+            BOOST_NOEXCEPT_IF (std::is_nothrow_move_constructible<index_array_type>::value &&
+                               std::is_nothrow_move_constructible<value_array_type>::value):
+            matrix_container<self_type> (),
+            size1_ (m.size1_), size2_ (m.size2_), capacity_ (m.capacity_),
+            filled1_ (m.filled1_), filled2_ (m.filled2_),
+            index1_data_ (std::move (m.index1_data_)), index2_data_ (std::move (m.index2_data_)),
+            value_data_ (std::move (m.value_data_)) {
+            m.size1_ = 0;
+            m.size2_ = 0;
+            m.capacity_ = 0;
+            m.filled1_ = 0;
+            m.filled2_ = 0;
+        }
+#endif
          
         BOOST_UBLAS_INLINE
         compressed_matrix (const coordinate_matrix<T, L, IB, IA, TA> &m):
@@ -2697,7 +2737,7 @@ namespace boost { namespace numeric { namespace ublas {
             const_subiterator_type  i = i_start;
             size_type r = 1;
             for (; (r < layout_type::size_M (size1_, size2_)) && (i != i_end); ++r) {
-                i = std::lower_bound(i, i_end, r);
+                i = std::lower_bound(i, i_end, k_based (r));
                 index1_data_[r] = k_based( i - i_start );
             }
             filled1_ = r + 1;
@@ -2783,7 +2823,8 @@ namespace boost { namespace numeric { namespace ublas {
         }
         BOOST_UBLAS_INLINE
         void complete_index1_data () {
-            while (filled1_ <= layout_type::size_M (size1_, size2_)) {
+            // A moved from matrix has no index1 data to complete
+            while (filled1_ > 0 && filled1_ <= layout_type::size_M (size1_, size2_)) {
                 this->index1_data_ [filled1_] = k_based (filled2_);
                 ++ this->filled1_;
             }
@@ -2829,9 +2870,11 @@ namespace boost { namespace numeric { namespace ublas {
             else {
                 index2_data_.resize (capacity_);
                 value_data_.resize (capacity_);
-                filled1_ = 1;
                 filled2_ = 0;
-                index1_data_ [filled1_ - 1] = k_based (filled2_);
+                if (filled1_ > 0) {
+                    filled1_ = 1;
+                    index1_data_ [filled1_ - 1] = k_based (filled2_);
+                }
             }
             storage_invariants ();
        }
@@ -2946,9 +2989,12 @@ namespace boost { namespace numeric { namespace ublas {
         // Zeroing
         BOOST_UBLAS_INLINE
         void clear () {
-            filled1_ = 1;
             filled2_ = 0;
-            index1_data_ [filled1_ - 1] = k_based (filled2_);
+            // A moved from matrix is already empty, without index1 data
+            if (filled1_ > 0) {
+                filled1_ = 1;
+                index1_data_ [filled1_ - 1] = k_based (filled2_);
+            }
             storage_invariants ();
         }
 
@@ -2975,6 +3021,12 @@ namespace boost { namespace numeric { namespace ublas {
             assign (m);
             return *this;
         }
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        BOOST_UBLAS_INLINE
+        compressed_matrix &operator = (compressed_matrix &&m) BOOST_NOEXCEPT {
+            return assign_temporary (m);
+        }
+#endif
         BOOST_UBLAS_INLINE
         compressed_matrix &assign_temporary (compressed_matrix &m) {
             swap (m);
@@ -3961,9 +4013,14 @@ namespace boost { namespace numeric { namespace ublas {
 
     private:
         void storage_invariants () const {
-            BOOST_UBLAS_CHECK (layout_type::size_M (size1_, size2_) + 1 == index1_data_.size (), internal_logic ());
             BOOST_UBLAS_CHECK (capacity_ == index2_data_.size (), internal_logic ());
             BOOST_UBLAS_CHECK (capacity_ == value_data_.size (), internal_logic ());
+            if (filled1_ == 0) {
+                // Moved from, then possibly reserved
+                BOOST_UBLAS_CHECK (size1_ == 0 && size2_ == 0 && index1_data_.size () == 0 && filled2_ == 0, internal_logic ());
+                return;
+            }
+            BOOST_UBLAS_CHECK (layout_type::size_M (size1_, size2_) + 1 == index1_data_.size (), internal_logic ());
             BOOST_UBLAS_CHECK (filled1_ > 0 && filled1_ <= layout_type::size_M (size1_, size2_) + 1, internal_logic ());
             BOOST_UBLAS_CHECK (filled2_ <= capacity_, internal_logic ());
             BOOST_UBLAS_CHECK (index1_data_ [filled1_ - 1] == k_based (filled2_), internal_logic ());
@@ -3998,6 +4055,567 @@ namespace boost { namespace numeric { namespace ublas {
     const typename compressed_matrix<T, L, IB, IA, TA>::value_type compressed_matrix<T, L, IB, IA, TA>::zero_ = value_type/*zero*/();
 
 
+    // Block compressed sparse row (BCSR) matrix class
+    // The matrix is cut into R x C blocks and only blocks holding a non zero are stored, densely and
+    // row major, together with one column index per block. Matrices with a natural block structure,
+    // like finite element matrices with several unknowns per node, need R * C times fewer indices
+    // than in compressed_matrix and their products run on fixed size dense kernels.
+    // The sizes need not be multiples of the block size, the blocks of the last block row and column
+    // are padded with zeros.
+    // The matrix is read only: it is built from another (sparse) matrix, then read through element access
+    // and sparse iterators, which visit every stored element, zeros of the stored blocks included.
+    template<class T, std::size_t R, std::size_t C, class IA, class TA>
+    class block_compressed_matrix:
+        public matrix_expression<block_compressed_matrix<T, R, C, IA, TA> > {
+
+        typedef const T *const_pointer;
+        typedef block_compressed_matrix<T, R, C, IA, TA> self_type;
+    public:
+        typedef const block_compressed_matrix& nested_type;
+        typedef typename IA::value_type size_type;
+        typedef typename IA::size_type array_size_type;
+        typedef typename IA::difference_type difference_type;
+        typedef T value_type;
+        typedef const T &const_reference;
+        typedef const_reference reference;
+        typedef IA index_array_type;
+        typedef TA value_array_type;
+        typedef const matrix_reference<const self_type> const_closure_type;
+        typedef const_closure_type closure_type;
+        typedef sparse_tag storage_category;
+        typedef row_major_tag orientation_category;
+
+        enum {
+            block_rows = R,
+            block_columns = C,
+            block_size = R * C,
+        };
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix ():
+            matrix_expression<self_type> (),
+            size1_ (0), size2_ (0), filled2_ (0),
+            index1_data_ (1, 0), index2_data_ (), value_data_ () {}
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix (size_type size1, size_type size2):
+            matrix_expression<self_type> (),
+            size1_ (size1), size2_ (size2), filled2_ (0),
+            index1_data_ (blocks1 () + 1, 0), index2_data_ (), value_data_ () {}
+        // Conversion from compressed_matrix, coordinate_matrix or any other matrix expression, traversed
+        // with its sparse iterators in storage order
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        block_compressed_matrix (const matrix_expression<AE> &ae):
+            matrix_expression<self_type> (),
+            size1_ (ae ().size1 ()), size2_ (ae ().size2 ()), filled2_ (0),
+            index1_data_ (blocks1 () + 1, 0), index2_data_ (), value_data_ () {
+            std::vector<entry> entries;
+            gather (ae (), entries, typename AE::orientation_category ());
+            build (entries);
+        }
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return size1_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return size2_;
+        }
+        // Number of stored elements, zeros of the stored blocks included
+        BOOST_UBLAS_INLINE
+        size_type nnz () const {
+            return filled2_ * block_size;
+        }
+        // Number of block rows and block columns
+        BOOST_UBLAS_INLINE
+        size_type blocks1 () const {
+            return (size1_ + R - 1) / R;
+        }
+        BOOST_UBLAS_INLINE
+        size_type blocks2 () const {
+            return (size2_ + C - 1) / C;
+        }
+
+        // Storage accessors
+        // index1_data () [bi] is the first stored block of block row bi, index2_data () [k] the block column
+        // of the block k, whose elements are value_data () [k * R * C, (k + 1) * R * C)
+        BOOST_UBLAS_INLINE
+        array_size_type filled1 () const {
+            return blocks1 () + 1;
+        }
+        BOOST_UBLAS_INLINE
+        array_size_type filled2 () const {
+            return filled2_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &index1_data () const {
+            return index1_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &index2_data () const {
+            return index2_data_;
+        }
+        BOOST_UBLAS_INLINE
+        const value_array_type &value_data () const {
+            return value_data_;
+        }
+
+        // Element access
+        BOOST_UBLAS_INLINE
+        const_pointer find_element (size_type i, size_type j) const {
+            BOOST_UBLAS_CHECK (i < size1_, bad_index ());
+            BOOST_UBLAS_CHECK (j < size2_, bad_index ());
+            const size_type k = find_block (i / R, j / C);
+            if (k == filled2_)
+                return 0;
+            return &value_data_ [k * block_size + (i % R) * C + j % C];
+        }
+        BOOST_UBLAS_INLINE
+        const_reference operator () (size_type i, size_type j) const {
+            const_pointer p = find_element (i, j);
+            if (p)
+                return *p;
+            else
+                return zero_;
+        }
+
+        // Swapping
+        BOOST_UBLAS_INLINE
+        void swap (block_compressed_matrix &m) {
+            if (this != &m) {
+                std::swap (size1_, m.size1_);
+                std::swap (size2_, m.size2_);
+                std::swap (filled2_, m.filled2_);
+                index1_data_.swap (m.index1_data_);
+                index2_data_.swap (m.index2_data_);
+                value_data_.swap (m.value_data_);
+            }
+        }
+        BOOST_UBLAS_INLINE
+        friend void swap (block_compressed_matrix &m1, block_compressed_matrix &m2) {
+            m1.swap (m2);
+        }
+
+        // Iterator types
+        class const_iterator1;
+        class const_iterator2;
+        typedef reverse_iterator_base1<const_iterator1> const_reverse_iterator1;
+        typedef reverse_iterator_base2<const_iterator2> const_reverse_iterator2;
+
+        // Element lookup
+        // Rank 1 iterators visit the stored elements: find1 moves to the next (direction > 0) or previous row
+        // from i whose block row stores the block column of j, find2 to the stored element of row i from j on.
+        const_iterator1 find1 (int rank, size_type i, size_type j, int direction = 1) const {
+            size_type k = filled2_;
+            if (rank == 1) {
+                while (i < size1_) {
+                    k = find_block (i / R, j / C);
+                    if (k != filled2_)
+                        break;
+                    if (direction > 0)
+                        i = (i / R + 1) * R;
+                    else if (i < R)
+                        break;
+                    else
+                        i = i / R * R - 1;
+                }
+                i = (std::min) (i, size1_);
+            }
+            return const_iterator1 (*this, rank, i, j, k);
+        }
+        const_iterator2 find2 (int rank, size_type i, size_type j) const {
+            size_type p = 0;
+            if (rank == 1 && i < size1_) {
+                const size_type first = index1_data_ [i / R];
+                const size_type last = index1_data_ [i / R + 1];
+                const size_type k = std::lower_bound (index2_data_.begin () + first, index2_data_.begin () + last, j / C) - index2_data_.begin ();
+                p = k * C;
+                if (k != last && index2_data_ [k] == j / C)
+                    p += j % C;
+                p = (std::min) (p, row_end (i));
+            }
+            return const_iterator2 (*this, rank, i, j, p);
+        }
+
+        class const_iterator1:
+            public container_const_reference<block_compressed_matrix>,
+            public bidirectional_iterator_base<sparse_bidirectional_iterator_tag,
+                                               const_iterator1, value_type> {
+        public:
+            typedef typename block_compressed_matrix::value_type value_type;
+            typedef typename block_compressed_matrix::difference_type difference_type;
+            typedef typename block_compressed_matrix::const_reference reference;
+            typedef typename block_compressed_matrix::const_pointer pointer;
+
+            typedef const_iterator2 dual_iterator_type;
+            typedef const_reverse_iterator2 dual_reverse_iterator_type;
+
+            // Construction and destruction
+            BOOST_UBLAS_INLINE
+            const_iterator1 ():
+                container_const_reference<self_type> (), rank_ (), i_ (), j_ (), k_ () {}
+            BOOST_UBLAS_INLINE
+            const_iterator1 (const self_type &m, int rank, size_type i, size_type j, size_type k):
+                container_const_reference<self_type> (m), rank_ (rank), i_ (i), j_ (j), k_ (k) {}
+
+            // Arithmetic
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator ++ () {
+                if (rank_ == 1 && (i_ + 1) % R != 0 && i_ + 1 < (*this) ().size1 ())
+                    ++ i_;
+                else if (rank_ == 1)
+                    *this = (*this) ().find1 (rank_, i_ + 1, j_, 1);
+                else
+                    ++ i_;
+                return *this;
+            }
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator -- () {
+                if (rank_ == 1 && i_ % R != 0 && i_ < (*this) ().size1 ())
+                    -- i_;
+                else if (rank_ == 1)
+                    *this = (*this) ().find1 (rank_, i_ - 1, j_, -1);
+                else
+                    -- i_;
+                return *this;
+            }
+
+            // Dereference
+            BOOST_UBLAS_INLINE
+            const_reference operator * () const {
+                BOOST_UBLAS_CHECK (index1 () < (*this) ().size1 (), bad_index ());
+                BOOST_UBLAS_CHECK (index2 () < (*this) ().size2 (), bad_index ());
+                if (rank_ == 1)
+                    return (*this) ().value_data_ [k_ * block_size + (i_ % R) * C + j_ % C];
+                else
+                    return (*this) () (i_, j_);
+            }
+
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator2 begin () const {
+                return (*this) ().find2 (1, index1 (), 0);
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator2 end () const {
+                return (*this) ().find2 (1, index1 (), (*this) ().size2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator2 rbegin () const {
+                return const_reverse_iterator2 (end ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator2 rend () const {
+                return const_reverse_iterator2 (begin ());
+            }
+#endif
+
+            // Indices
+            BOOST_UBLAS_INLINE
+            size_type index1 () const {
+                return i_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type index2 () const {
+                return j_;
+            }
+
+            // Assignment
+            BOOST_UBLAS_INLINE
+            const_iterator1 &operator = (const const_iterator1 &it) {
+                container_const_reference<self_type>::assign (&it ());
+                rank_ = it.rank_;
+                i_ = it.i_;
+                j_ = it.j_;
+                k_ = it.k_;
+                return *this;
+            }
+
+            // Comparison
+            BOOST_UBLAS_INLINE
+            bool operator == (const const_iterator1 &it) const {
+                BOOST_UBLAS_CHECK (&(*this) () == &it (), external_logic ());
+                return i_ == it.i_ && j_ == it.j_;
+            }
+
+        private:
+            int rank_;
+            size_type i_;
+            size_type j_;
+            size_type k_;
+        };
+
+        typedef const_iterator1 iterator1;
+
+        BOOST_UBLAS_INLINE
+        const_iterator1 begin1 () const {
+            return find1 (0, 0, 0);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator1 end1 () const {
+            return find1 (0, size1_, 0);
+        }
+
+        class const_iterator2:
+            public container_const_reference<block_compressed_matrix>,
+            public bidirectional_iterator_base<sparse_bidirectional_iterator_tag,
+                                               const_iterator2, value_type> {
+        public:
+            typedef typename block_compressed_matrix::value_type value_type;
+            typedef typename block_compressed_matrix::difference_type difference_type;
+            typedef typename block_compressed_matrix::const_reference reference;
+            typedef typename block_compressed_matrix::const_pointer pointer;
+
+            typedef const_iterator1 dual_iterator_type;
+            typedef const_reverse_iterator1 dual_reverse_iterator_type;
+
+            // Construction and destruction
+            BOOST_UBLAS_INLINE
+            const_iterator2 ():
+                container_const_reference<self_type> (), rank_ (), i_ (), j_ (), p_ () {}
+            BOOST_UBLAS_INLINE
+            const_iterator2 (const self_type &m, int rank, size_type i, size_type j, size_type p):
+                container_const_reference<self_type> (m), rank_ (rank), i_ (i), j_ (j), p_ (p) {}
+
+            // Arithmetic
+            // p_ = k * C + c is the column c of the stored block k of the row
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator ++ () {
+                if (rank_ == 1)
+                    ++ p_;
+                else
+                    ++ j_;
+                return *this;
+            }
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator -- () {
+                if (rank_ == 1)
+                    -- p_;
+                else
+                    -- j_;
+                return *this;
+            }
+
+            // Dereference
+            BOOST_UBLAS_INLINE
+            const_reference operator * () const {
+                BOOST_UBLAS_CHECK (index1 () < (*this) ().size1 (), bad_index ());
+                BOOST_UBLAS_CHECK (index2 () < (*this) ().size2 (), bad_index ());
+                if (rank_ == 1)
+                    return (*this) ().value_data_ [p_ / C * block_size + (i_ % R) * C + p_ % C];
+                else
+                    return (*this) () (i_, j_);
+            }
+
+#ifndef BOOST_UBLAS_NO_NESTED_CLASS_RELATION
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator1 begin () const {
+                return (*this) ().find1 (1, 0, index2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_iterator1 end () const {
+                return (*this) ().find1 (1, (*this) ().size1 (), index2 ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator1 rbegin () const {
+                return const_reverse_iterator1 (end ());
+            }
+            BOOST_UBLAS_INLINE
+#ifdef BOOST_UBLAS_MSVC_NESTED_CLASS_RELATION
+            typename self_type::
+#endif
+            const_reverse_iterator1 rend () const {
+                return const_reverse_iterator1 (begin ());
+            }
+#endif
+
+            // Indices
+            BOOST_UBLAS_INLINE
+            size_type index1 () const {
+                return i_;
+            }
+            BOOST_UBLAS_INLINE
+            size_type index2 () const {
+                if (rank_ == 1)
+                    return (*this) ().index2_data_ [p_ / C] * C + p_ % C;
+                else
+                    return j_;
+            }
+
+            // Assignment
+            BOOST_UBLAS_INLINE
+            const_iterator2 &operator = (const const_iterator2 &it) {
+                container_const_reference<self_type>::assign (&it ());
+                rank_ = it.rank_;
+                i_ = it.i_;
+                j_ = it.j_;
+                p_ = it.p_;
+                return *this;
+            }
+
+            // Comparison
+            BOOST_UBLAS_INLINE
+            bool operator == (const const_iterator2 &it) const {
+                BOOST_UBLAS_CHECK (&(*this) () == &it (), external_logic ());
+                if (rank_ == 1 || it.rank_ == 1)
+                    return p_ == it.p_;
+                else
+                    return i_ == it.i_ && j_ == it.j_;
+            }
+
+        private:
+            int rank_;
+            size_type i_;
+            size_type j_;
+            size_type p_;
+        };
+
+        typedef const_iterator2 iterator2;
+
+        BOOST_UBLAS_INLINE
+        const_iterator2 begin2 () const {
+            return find2 (0, 0, 0);
+        }
+        BOOST_UBLAS_INLINE
+        const_iterator2 end2 () const {
+            return find2 (0, 0, size2_);
+        }
+
+        // Reverse iterators
+
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator1 rbegin1 () const {
+            return const_reverse_iterator1 (end1 ());
+        }
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator1 rend1 () const {
+            return const_reverse_iterator1 (begin1 ());
+        }
+
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator2 rbegin2 () const {
+            return const_reverse_iterator2 (end2 ());
+        }
+        BOOST_UBLAS_INLINE
+        const_reverse_iterator2 rend2 () const {
+            return const_reverse_iterator2 (begin2 ());
+        }
+
+    private:
+        // Position of the stored block (bi, bj), filled2_ if it is not stored
+        BOOST_UBLAS_INLINE
+        size_type find_block (size_type bi, size_type bj) const {
+            typename index_array_type::const_iterator end = index2_data_.begin () + index1_data_ [bi + 1];
+            typename index_array_type::const_iterator it = std::lower_bound (index2_data_.begin () + index1_data_ [bi], end, bj);
+            if (it == end || *it != bj)
+                return filled2_;
+            return it - index2_data_.begin ();
+        }
+        // End of the stored elements of row i for find2, the padding columns of the last block column excluded
+        BOOST_UBLAS_INLINE
+        size_type row_end (size_type i) const {
+            const size_type first = index1_data_ [i / R];
+            const size_type last = index1_data_ [i / R + 1];
+            if (first != last && index2_data_ [last - 1] == blocks2 () - 1)
+                return last * C - (blocks2 () * C - size2_);
+            return last * C;
+        }
+
+        struct entry {
+            size_type i, j;
+            value_type t;
+        };
+        // Orders the elements by block, block rows first
+        struct block_less {
+            BOOST_UBLAS_INLINE
+            bool operator () (const entry &a, const entry &b) const {
+                return a.i / R < b.i / R || (a.i / R == b.i / R && a.j / C < b.j / C);
+            }
+        };
+
+        template<class AE>
+        static void gather (const AE &ae, std::vector<entry> &entries, row_major_tag) {
+            for (typename AE::const_iterator1 it1 = ae.begin1 (); it1 != ae.end1 (); ++ it1)
+                for (typename AE::const_iterator2 it2 = it1.begin (); it2 != it1.end (); ++ it2) {
+                    entry e = { it2.index1 (), it2.index2 (), *it2 };
+                    entries.push_back (e);
+                }
+        }
+        template<class AE>
+        static void gather (const AE &ae, std::vector<entry> &entries, column_major_tag) {
+            for (typename AE::const_iterator2 it2 = ae.begin2 (); it2 != ae.end2 (); ++ it2)
+                for (typename AE::const_iterator1 it1 = it2.begin (); it1 != it2.end (); ++ it1) {
+                    entry e = { it1.index1 (), it1.index2 (), *it1 };
+                    entries.push_back (e);
+                }
+        }
+        template<class AE>
+        static void gather (const AE &ae, std::vector<entry> &entries, unknown_orientation_tag) {
+            gather (ae, entries, row_major_tag ());
+        }
+
+        void build (std::vector<entry> &entries) {
+            std::stable_sort (entries.begin (), entries.end (), block_less ());
+            // count the blocks of every block row, then lay them out
+            std::vector<size_type> columns;
+            for (std::size_t k = 0; k < entries.size (); ++ k) {
+                if (k == 0 || block_less () (entries [k - 1], entries [k])) {
+                    ++ index1_data_ [entries [k].i / R + 1];
+                    columns.push_back (entries [k].j / C);
+                }
+            }
+            for (size_type bi = 0; bi < blocks1 (); ++ bi)
+                index1_data_ [bi + 1] += index1_data_ [bi];
+            filled2_ = columns.size ();
+            index2_data_.resize (filled2_);
+            std::copy (columns.begin (), columns.end (), index2_data_.begin ());
+            value_data_.resize (filled2_ * block_size, value_type/*zero*/());
+            std::ptrdiff_t block = -1;
+            for (std::size_t k = 0; k < entries.size (); ++ k) {
+                if (k == 0 || block_less () (entries [k - 1], entries [k]))
+                    ++ block;
+                // duplicates, as in an unsorted coordinate_matrix, are summed
+                value_data_ [block * block_size + (entries [k].i % R) * C + entries [k].j % C] += entries [k].t;
+            }
+        }
+
+        size_type size1_;
+        size_type size2_;
+        array_size_type filled2_;
+        index_array_type index1_data_;
+        index_array_type index2_data_;
+        value_array_type value_data_;
+        static const value_type zero_;
+    };
+
+    template<class T, std::size_t R, std::size_t C, class IA, class TA>
+    const typename block_compressed_matrix<T, R, C, IA, TA>::value_type block_compressed_matrix<T, R, C, IA, TA>::zero_ = value_type/*zero*/();
+
+
     // Coordinate array based sparse matrix class
     // Thanks to Kresimir Fresl for extending this to cover different index bases.
     template<class T, class L, std::size_t IB, class IA, class TA>
@@ -4013,6 +4631,7 @@ namespace boost { namespace numeric { namespace ublas {
 #ifdef BOOST_UBLAS_ENABLE_PROXY_SHORTCUTS
         using matrix_container<self_type>::operator ();
 #endif
+        typedef const coordinate_matrix& nested_type;
         // ISSUE require type consistency check, is_convertable (IA::size_type, TA::size_type)
         typedef typename IA::value_type size_type;
         // ISSUE difference_type cannot be deduced for sparse indices, we only know the value_type
@@ -4060,6 +4679,25 @@ namespace boost { namespace numeric { namespace ublas {
             index1_data_ (m.index1_data_), index2_data_ (m.index2_data_), value_data_ (m.value_data_) {
             storage_invariants ();
         }
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        // Takes over the storage of m, left of size (0, 0) with no capacity
+        BOOST_UBLAS_INLINE
+        coordinate_matrix (coordinate_matrix &&m)
+            BOOST_NOEXCEPT_IF (std::is_nothrow_move_constructible<index_array_type>::value &&
+                               std::is_nothrow_move_constructible<value_array_type>::value):
+            matrix_container<self_type> (),
+            size1_ (m.size1_), size2_ (m.size2_), capacity_ (m.capacity_),
+            filled_ (m.filled_), sorted_filled_ (m.sorted_filled_), sorted_ (m.sorted_),
+            index1_data_ (std::move (m.index1_data_)), index2_data_ (std::move (m.index2_data_)),
+            value_data_ (std::move (m.value_data_)) {
+            m.size1_ = 0;
+            m.size2_ = 0;
+            m.capacity_ = 0;
+            m.filled_ = 0;
+            m.sorted_filled_ = 0;
+            m.sorted_ = true;
+        }
+#endif
         template<class AE>
         BOOST_UBLAS_INLINE
         coordinate_matrix (const matrix_expression<AE> &ae, array_size_type non_zeros = 0):
@@ -4304,6 +4942,12 @@ namespace boost { namespace numeric { namespace ublas {
             assign (m);
             return *this;
         }
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        BOOST_UBLAS_INLINE
+        coordinate_matrix &operator = (coordinate_matrix &&m) BOOST_NOEXCEPT {
+            return assign_temporary (m);
+        }
+#endif
         BOOST_UBLAS_INLINE
         coordinate_matrix &assign_temporary (coordinate_matrix &m) {
             swap (m);
@@ -4443,6 +5087,37 @@ namespace boost { namespace numeric { namespace ublas {
         BOOST_UBLAS_INLINE
         void sort () const {
             if (! sorted_ && filled_ > 0) {
+                const std::size_t bits2 = detail::radix_bits (layout_type::size_m (size1_, size2_));
+                const std::size_t bits = detail::radix_bits (layout_type::size_M (size1_, size2_)) + bits2;
+                if (detail::radix_key_fits (bits)) {
+#ifndef BOOST_UBLAS_COO_ALWAYS_DO_FULL_SORT
+                    const std::size_t sorted = sorted_filled_;
+#else
+                    const std::size_t sorted = 0;
+#endif
+                    // (major, minor) packed into one key, the values gathered aside
+                    std::vector<value_type> values (filled_);
+                    filled_ = detail::radix_sort_elements (sorted, filled_, bits,
+                        [this, bits2] (std::size_t k) {
+                            return (std::size_t (zero_based (index1_data_ [k])) << bits2) | std::size_t (zero_based (index2_data_ [k]));
+                        },
+                        [this, bits2, &values] (std::size_t q, std::size_t key, std::size_t k, bool first) {
+                            if (first) {
+                                index1_data_ [q] = k_based (size_type (key >> bits2));
+                                index2_data_ [q] = k_based (size_type (key & ((std::size_t (1) << bits2) - 1)));
+                                values [q] = value_data_ [k];
+                            }
+                            else
+                                values [q] += value_data_ [k];
+                        });
+                    std::copy (values.begin (), values.begin () + filled_, value_data_.begin ());
+                    sorted_filled_ = filled_;
+                    sorted_ = true;
+                    storage_invariants ();
+                    return;
+                }
+
+                // Keys too wide for a std::size_t
                 typedef index_triple_array<index_array_type, index_array_type, value_array_type> array_triple;
                 array_triple ita (filled_, index1_data_, index2_data_, value_data_);
 #ifndef BOOST_UBLAS_COO_ALWAYS_DO_FULL_SORT
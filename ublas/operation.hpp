@@ -13,7 +13,15 @@
 #ifndef _BOOST_UBLAS_OPERATION_
 #define _BOOST_UBLAS_OPERATION_
 
+#include <algorithm>
+#include <vector>
+#include <boost/type_traits/is_convertible.hpp>
 #include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/matrix.hpp> // uninitialized_vector
+#include <boost/numeric/ublas/detail/parallel.hpp>
+#include <boost/numeric/ublas/detail/band.hpp>
+#include <boost/numeric/ublas/detail/gemv.hpp>
+#include <boost/numeric/ublas/detail/fused.hpp>
 
 /** \file operation.hpp
  *  \brief This file contains some specialized products.
@@ -25,40 +33,256 @@
 
 namespace boost { namespace numeric { namespace ublas {
 
-    template<class V, class T1, class L1, class IA1, class TA1, class E2>
+namespace detail {
+
+    // Whether a sparse matrix vector product with nnz non zeros is split across threads.
+    // Only dense results qualify, their elements can be written concurrently.
+    template<class V>
     BOOST_UBLAS_INLINE
-    V &
-    axpy_prod (const compressed_matrix<T1, L1, 0, IA1, TA1> &e1,
-               const vector_expression<E2> &e2,
-               V &v, row_major_tag) {
+    bool parallel_axpy_prod (std::size_t nnz) {
+        return boost::is_convertible<typename V::storage_category, dense_proxy_tag>::value && parallel_policy::enabled (nnz);
+    }
+
+    // v (i) += row i of e1 times e2 for the rows [first, last) of a row major compressed matrix,
+    // or v (i) = row i of e1 times e2 with init, v (i) being then written without being read
+    template<class V, class M, class E2>
+    BOOST_UBLAS_INLINE
+    void compressed_axpy_rows (const M &e1, const E2 &e2, V &v, std::size_t first, std::size_t last, bool init) {
         typedef typename V::size_type size_type;
         typedef typename V::value_type value_type;
 
-        for (size_type i = 0; i < e1.filled1 () -1; ++ i) {
+        for (size_type i = first; i < last; ++ i) {
             size_type begin = e1.index1_data () [i];
             size_type end = e1.index1_data () [i + 1];
-            value_type t (v (i));
+            value_type t (init ? value_type/*zero*/() : value_type (v (i)));
             for (size_type j = begin; j < end; ++ j)
-                t += e1.value_data () [j] * e2 () (e1.index2_data () [j]);
+                t += e1.value_data () [j] * e2 (e1.index2_data () [j]);
             v (i) = t;
         }
-        return v;
     }
 
-    template<class V, class T1, class L1, class IA1, class TA1, class E2>
+    // v += column j of e1 times e2 (j) for the columns [first, last) of a column major compressed matrix
+    template<class V, class M, class E2>
     BOOST_UBLAS_INLINE
-    V &
-    axpy_prod (const compressed_matrix<T1, L1, 0, IA1, TA1> &e1,
-               const vector_expression<E2> &e2,
-               V &v, column_major_tag) {
+    void compressed_axpy_columns (const M &e1, const E2 &e2, V &v, std::size_t first, std::size_t last) {
         typedef typename V::size_type size_type;
 
-        for (size_type j = 0; j < e1.filled1 () -1; ++ j) {
+        for (size_type j = first; j < last; ++ j) {
             size_type begin = e1.index1_data () [j];
             size_type end = e1.index1_data () [j + 1];
             for (size_type i = begin; i < end; ++ i)
-                v (e1.index2_data () [i]) += e1.value_data () [i] * e2 () (j);
+                v (e1.index2_data () [i]) += e1.value_data () [i] * e2 (j);
+        }
+    }
+
+    // Task of the parallel row major product: the rows of the parts [first, last), disjoint between tasks.
+    // With init the rows are first written by the thread computing them, so are their pages for a new result.
+    template<class V, class M, class E2>
+    struct compressed_axpy_row_task {
+        compressed_axpy_row_task (const M &e1, const E2 &e2, V &v, const std::vector<std::size_t> &bounds, bool init):
+            e1 (e1), e2 (e2), v (v), bounds (bounds), init (init) {}
+
+        void operator () (std::size_t first, std::size_t last) const {
+            compressed_axpy_rows (e1, e2, v, bounds [first], bounds [last], init);
+        }
+
+        const M &e1;
+        const E2 &e2;
+        V &v;
+        const std::vector<std::size_t> &bounds;
+        bool init;
+    };
+
+    // Task of the parallel column major product: part 0 accumulates into v, every other part into its own
+    // partial result, so that no element is written by two threads
+    template<class V, class M, class E2, class W>
+    struct compressed_axpy_column_task {
+        compressed_axpy_column_task (const M &e1, const E2 &e2, V &v, std::vector<W> &partials, const std::vector<std::size_t> &bounds):
+            e1 (e1), e2 (e2), v (v), partials (partials), bounds (bounds) {}
+
+        void operator () (std::size_t first, std::size_t last) const {
+            for (std::size_t p = first; p < last; ++ p) {
+                if (p == 0) {
+                    compressed_axpy_columns (e1, e2, v, bounds [p], bounds [p + 1]);
+                }
+                else {
+                    // allocated here, so that the pages are first touched by the thread using them
+                    W &partial = partials [p - 1];
+                    partial.resize (v.size (), false);
+                    partial.clear ();
+                    compressed_axpy_columns (e1, e2, partial, bounds [p], bounds [p + 1]);
+                }
+            }
+        }
+
+        const M &e1;
+        const E2 &e2;
+        V &v;
+        std::vector<W> &partials;
+        const std::vector<std::size_t> &bounds;
+    };
+
+    // v += e1 * e2, or v = e1 * e2 with init, for the block rows [first, last) of a block compressed matrix.
+    // Every block is a fixed size dense product that the compiler unrolls; the blocks on the right and
+    // bottom edges of the matrix may stick out of it and are clipped.
+    template<class V, class M, class E2>
+    BOOST_UBLAS_INLINE
+    void block_compressed_axpy_rows (const M &e1, const E2 &e2, V &v, std::size_t first, std::size_t last, bool init) {
+        typedef typename V::value_type value_type;
+        typedef typename M::value_type matrix_value_type;
+        const std::size_t R = M::block_rows;
+        const std::size_t C = M::block_columns;
+        const std::size_t size1 = e1.size1 ();
+        const std::size_t size2 = e1.size2 ();
+
+        for (std::size_t bi = first; bi < last; ++ bi) {
+            value_type t [R];
+            for (std::size_t r = 0; r < R; ++ r)
+                t [r] = value_type/*zero*/();
+            for (std::size_t k = e1.index1_data () [bi]; k < e1.index1_data () [bi + 1]; ++ k) {
+                const std::size_t j = e1.index2_data () [k] * C;
+                const matrix_value_type *block = &e1.value_data () [k * R * C];
+                if (j + C <= size2) {
+                    value_type x [C];
+                    for (std::size_t c = 0; c < C; ++ c)
+                        x [c] = e2 (j + c);
+                    for (std::size_t r = 0; r < R; ++ r)
+                        for (std::size_t c = 0; c < C; ++ c)
+                            t [r] += block [r * C + c] * x [c];
+                }
+                else {
+                    for (std::size_t r = 0; r < R; ++ r)
+                        for (std::size_t c = 0; j + c < size2; ++ c)
+                            t [r] += block [r * C + c] * e2 (j + c);
+                }
+            }
+            const std::size_t i = bi * R;
+            if (init) {
+                for (std::size_t r = 0; r < R && i + r < size1; ++ r)
+                    v (i + r) = t [r];
+            }
+            else {
+                for (std::size_t r = 0; r < R && i + r < size1; ++ r)
+                    v (i + r) += t [r];
+            }
         }
+    }
+
+    // Task of the parallel block compressed product: the block rows of the parts [first, last)
+    template<class V, class M, class E2>
+    struct block_compressed_axpy_row_task {
+        block_compressed_axpy_row_task (const M &e1, const E2 &e2, V &v, const std::vector<std::size_t> &bounds, bool init):
+            e1 (e1), e2 (e2), v (v), bounds (bounds), init (init) {}
+
+        void operator () (std::size_t first, std::size_t last) const {
+            block_compressed_axpy_rows (e1, e2, v, bounds [first], bounds [last], init);
+        }
+
+        const M &e1;
+        const E2 &e2;
+        V &v;
+        const std::vector<std::size_t> &bounds;
+        bool init;
+    };
+
+    // Adds the partial results of the column major product to the elements [first, last) of v
+    template<class V, class W>
+    struct partial_sum_task {
+        partial_sum_task (V &v, const std::vector<W> &partials):
+            v (v), partials (partials) {}
+
+        void operator () (std::size_t first, std::size_t last) const {
+            typedef typename V::value_type value_type;
+
+            for (std::size_t i = first; i < last; ++ i) {
+                value_type t (v (i));
+                for (std::size_t p = 0; p < partials.size (); ++ p)
+                    t += partials [p] (i);
+                v (i) = t;
+            }
+        }
+
+        V &v;
+        const std::vector<W> &partials;
+    };
+
+    // v += e1 * e2, or v = e1 * e2 with init, for a row major compressed matrix. Rows are evaluated in
+    // parallel when parallel_policy allows it, each thread taking a range of rows holding about the same
+    // number of non zeros. Every element is computed as in the serial loop.
+    template<class V, class M, class E2>
+    BOOST_UBLAS_INLINE
+    void compressed_axpy_prod (const M &e1, const E2 &e2, V &v, bool init, row_major_tag) {
+        typedef typename V::value_type value_type;
+        // A moved from matrix, of size (0, 0), has no index1 data
+        const std::size_t size1 = e1.filled1 () > 0 ? e1.filled1 () - 1 : 0;
+
+        if (parallel_axpy_prod<V> (e1.nnz ())) {
+            std::vector<std::size_t> bounds;
+            nonzero_partition (e1.index1_data (), size1, parallel_policy::num_threads (), bounds);
+            parallel_for (0, bounds.size () - 1, 1, compressed_axpy_row_task<V, M, E2> (e1, e2, v, bounds, init));
+        }
+        else {
+            compressed_axpy_rows (e1, e2, v, 0, size1, init);
+        }
+        // The rows past the last filled one are empty
+        if (init) {
+            for (std::size_t i = size1; i < e1.size1 (); ++ i)
+                v (i) = value_type/*zero*/();
+        }
+    }
+
+    // v += e1 * e2, or v = e1 * e2 with init, for a column major compressed matrix. Columns are evaluated
+    // in parallel when parallel_policy allows it, each thread taking a range of columns holding about the
+    // same number of non zeros and scattering into its own partial result. The partial results are then
+    // added to v, also in parallel, without any atomic operation.
+    template<class V, class M, class E2>
+    BOOST_UBLAS_INLINE
+    void compressed_axpy_prod (const M &e1, const E2 &e2, V &v, bool init, column_major_tag) {
+        typedef typename V::value_type value_type;
+        typedef vector<value_type> partial_type;
+        const std::size_t size2 = e1.filled1 () > 0 ? e1.filled1 () - 1 : 0;
+
+        // Scattered updates reach every row from any thread
+        if (init)
+            v.assign (zero_vector<value_type> (e1.size1 ()));
+        if (parallel_axpy_prod<V> (e1.nnz ())) {
+            std::vector<std::size_t> bounds;
+            nonzero_partition (e1.index1_data (), size2, parallel_policy::num_threads (), bounds);
+            std::vector<partial_type> partials (bounds.size () - 2);
+            parallel_for (0, bounds.size () - 1, 1,
+                          compressed_axpy_column_task<V, M, E2, partial_type> (e1, e2, v, partials, bounds));
+            parallel_for (0, v.size (), (std::max) (std::size_t (64 / sizeof (value_type)), std::size_t (1)),
+                          partial_sum_task<V, partial_type> (v, partials));
+        }
+        else {
+            compressed_axpy_columns (e1, e2, v, 0, size2);
+        }
+    }
+
+}
+
+    // Rows are evaluated in parallel when parallel_policy allows it, each thread taking a range of rows
+    // holding about the same number of non zeros. Every element is computed as in the serial loop.
+    template<class V, class T1, class L1, class IA1, class TA1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const compressed_matrix<T1, L1, 0, IA1, TA1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, row_major_tag) {
+        detail::compressed_axpy_prod (e1, e2 (), v, false, row_major_tag ());
+        return v;
+    }
+
+    // Columns are evaluated in parallel when parallel_policy allows it, each thread taking a range of
+    // columns holding about the same number of non zeros and scattering into its own partial result.
+    // The partial results are then added to v, also in parallel, without any atomic operation.
+    template<class V, class T1, class L1, class IA1, class TA1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const compressed_matrix<T1, L1, 0, IA1, TA1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, column_major_tag) {
+        detail::compressed_axpy_prod (e1, e2 (), v, false, column_major_tag ());
         return v;
     }
 
@@ -72,15 +296,16 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename V::value_type value_type;
         typedef typename L1::orientation_category orientation_category;
 
+#if BOOST_UBLAS_TYPE_CHECK
         if (init)
             v.assign (zero_vector<value_type> (e1.size1 ()));
-#if BOOST_UBLAS_TYPE_CHECK
         vector<value_type> cv (v);
         typedef typename type_traits<value_type>::real_type real_type;
         real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
         indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
 #endif
-        axpy_prod (e1, e2, v, orientation_category ());
+        // Without the zeroing pass, the kernel writing v with init is the first to touch it
+        detail::compressed_axpy_prod (e1, e2 (), v, init, orientation_category ());
 #if BOOST_UBLAS_TYPE_CHECK
         BOOST_UBLAS_CHECK (norm_1 (v - cv) <= 2 * std::numeric_limits<real_type>::epsilon () * verrorbound, internal_logic ());
 #endif
@@ -93,8 +318,100 @@ namespace boost { namespace numeric { namespace ublas {
                const vector_expression<E2> &e2) {
         typedef V vector_type;
 
-        vector_type v (e1.size1 ());
-        return axpy_prod (e1, e2, v, true);
+        vector_type v (detail::uninitialized_vector<vector_type>::construct (e1.size1 ()));
+        axpy_prod (e1, e2, v, true);
+        return v;
+    }
+
+    // Block rows are evaluated in parallel when parallel_policy allows it, split by number of stored blocks.
+    template<class V, class T1, std::size_t R1, std::size_t C1, class IA1, class TA1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const block_compressed_matrix<T1, R1, C1, IA1, TA1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        typedef block_compressed_matrix<T1, R1, C1, IA1, TA1> matrix_type;
+        typedef typename V::value_type value_type;
+        const std::size_t blocks1 = e1.blocks1 ();
+        BOOST_UBLAS_CHECK (e1.size2 () == e2 ().size (), bad_size ());
+        BOOST_UBLAS_CHECK (e1.size1 () == v.size (), bad_size ());
+
+#if BOOST_UBLAS_TYPE_CHECK
+        if (init)
+            v.assign (zero_vector<value_type> (e1.size1 ()));
+        vector<value_type> cv (v);
+        typedef typename type_traits<value_type>::real_type real_type;
+        real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
+        indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
+#endif
+        // Every block row writes its rows, so with init the rows are first touched by the threads computing them
+        if (detail::parallel_axpy_prod<V> (e1.nnz ())) {
+            std::vector<std::size_t> bounds;
+            detail::nonzero_partition (e1.index1_data (), blocks1, parallel_policy::num_threads (), bounds);
+            detail::parallel_for (0, bounds.size () - 1, 1,
+                                  detail::block_compressed_axpy_row_task<V, matrix_type, E2> (e1, e2 (), v, bounds, init));
+        }
+        else {
+            detail::block_compressed_axpy_rows (e1, e2 (), v, 0, blocks1, init);
+        }
+#if BOOST_UBLAS_TYPE_CHECK
+        BOOST_UBLAS_CHECK (norm_1 (v - cv) <= 2 * std::numeric_limits<real_type>::epsilon () * verrorbound, internal_logic ());
+#endif
+        return v;
+    }
+    template<class V, class T1, std::size_t R1, std::size_t C1, class IA1, class TA1, class E2>
+    BOOST_UBLAS_INLINE
+    V
+    axpy_prod (const block_compressed_matrix<T1, R1, C1, IA1, TA1> &e1,
+               const vector_expression<E2> &e2) {
+        typedef V vector_type;
+
+        vector_type v (detail::uninitialized_vector<vector_type>::construct (e1.size1 ()));
+        axpy_prod (e1, e2, v, true);
+        return v;
+    }
+
+    // The band is read straight from its storage: row major bands as dot products along their rows,
+    // column major ones as axpys along their columns. Rows are evaluated in parallel when parallel_policy
+    // allows it, each thread taking a range of rows; with init it writes them without a zeroing pass.
+    template<class V, class T1, class L1, class A1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const banded_matrix<T1, L1, A1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init = true) {
+        typedef typename V::value_type value_type;
+        typedef const banded_matrix<T1, L1, A1> matrix_type;
+        typedef detail::band_storage<matrix_type> storage_type;
+        typedef typename storage_type::type view_type;
+        typedef typename L1::orientation_category orientation_category;
+        const std::size_t size1 = e1.size1 ();
+        const std::size_t size2 = e1.size2 ();
+
+        BOOST_UBLAS_CHECK (size2 == e2 ().size (), bad_size ());
+        BOOST_UBLAS_CHECK (size1 == v.size (), bad_size ());
+        std::vector<value_type> x (size2);
+        for (std::size_t j = 0; j < size2; ++ j)
+            x [j] = e2 () (j);
+        const view_type a (storage_type::view (e1));
+        const detail::banded_axpy_row_task<view_type, value_type, V, orientation_category>
+            task (a, e1.lower (), e1.upper (), size2, size2 ? &x [0] : 0, v, init);
+        if (detail::parallel_axpy_prod<V> (size1 * (e1.lower () + 1 + e1.upper ())))
+            detail::parallel_for (0, size1, (std::max) (std::size_t (64 / sizeof (value_type)), std::size_t (1)), task);
+        else
+            task (0, size1);
+        return v;
+    }
+    template<class V, class T1, class L1, class A1, class E2>
+    BOOST_UBLAS_INLINE
+    V
+    axpy_prod (const banded_matrix<T1, L1, A1> &e1,
+               const vector_expression<E2> &e2) {
+        typedef V vector_type;
+
+        vector_type v (detail::uninitialized_vector<vector_type>::construct (e1.size1 ()));
+        axpy_prod (e1, e2, v, true);
+        return v;
     }
 
     template<class V, class T1, class L1, class IA1, class TA1, class E2>
@@ -209,6 +526,53 @@ namespace boost { namespace numeric { namespace ublas {
     }
 
 
+    // Dense storage case
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const matrix_expression<E1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init, boost::mpl::true_) {
+        typedef typename V::value_type value_type;
+
+#if BOOST_UBLAS_TYPE_CHECK
+        vector<value_type> cv (v);
+        if (init)
+            cv.clear ();
+        typedef typename type_traits<value_type>::real_type real_type;
+        real_type verrorbound (norm_1 (cv) + norm_1 (e1) * norm_1 (e2));
+        indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
+#endif
+        detail::gemv_axpy (detail::matrix_view (e1 ()), e2, value_type (1), v, init);
+#if BOOST_UBLAS_TYPE_CHECK
+        BOOST_UBLAS_CHECK (norm_1 (v - cv) <= 2 * std::numeric_limits<real_type>::epsilon () * verrorbound, internal_logic ());
+#endif
+        return v;
+    }
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const matrix_expression<E1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, bool init, boost::mpl::false_) {
+        typedef typename V::value_type value_type;
+        typedef typename E2::const_iterator::iterator_category iterator_category;
+
+        if (init)
+            v.assign (zero_vector<value_type> (e1 ().size1 ()));
+#if BOOST_UBLAS_TYPE_CHECK
+        vector<value_type> cv (v);
+        typedef typename type_traits<value_type>::real_type real_type;
+        real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
+        indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
+#endif
+        axpy_prod (e1, e2, v, iterator_category ());
+#if BOOST_UBLAS_TYPE_CHECK
+        BOOST_UBLAS_CHECK (norm_1 (v - cv) <= 2 * std::numeric_limits<real_type>::epsilon () * verrorbound, internal_logic ());
+#endif
+        return v;
+    }
+
   /** \brief computes <tt>v += A x</tt> or <tt>v = A x</tt> in an
           optimized fashion.
 
@@ -240,22 +604,9 @@ namespace boost { namespace numeric { namespace ublas {
     axpy_prod (const matrix_expression<E1> &e1,
                const vector_expression<E2> &e2,
                V &v, bool init = true) {
-        typedef typename V::value_type value_type;
-        typedef typename E2::const_iterator::iterator_category iterator_category;
+        typedef boost::mpl::bool_<detail::matrix_storage<E1>::value && detail::vector_storage<V>::value> storage_category;
 
-        if (init)
-            v.assign (zero_vector<value_type> (e1 ().size1 ()));
-#if BOOST_UBLAS_TYPE_CHECK
-        vector<value_type> cv (v);
-        typedef typename type_traits<value_type>::real_type real_type;
-        real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
-        indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
-#endif
-        axpy_prod (e1, e2, v, iterator_category ());
-#if BOOST_UBLAS_TYPE_CHECK
-        BOOST_UBLAS_CHECK (norm_1 (v - cv) <= 2 * std::numeric_limits<real_type>::epsilon () * verrorbound, internal_logic ());
-#endif
-        return v;
+        return axpy_prod (e1, e2, v, init, storage_category ());
     }
     template<class V, class E1, class E2>
     BOOST_UBLAS_INLINE
@@ -264,8 +615,9 @@ namespace boost { namespace numeric { namespace ublas {
                const vector_expression<E2> &e2) {
         typedef V vector_type;
 
-        vector_type v (e1 ().size1 ());
-        return axpy_prod (e1, e2, v, true);
+        vector_type v (detail::uninitialized_vector<vector_type>::construct (e1 ().size1 ()));
+        axpy_prod (e1, e2, v, true);
+        return v;
     }
 
     template<class V, class E1, class T2, class IA2, class TA2>
@@ -277,7 +629,7 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename V::size_type size_type;
         typedef typename V::value_type value_type;
 
-        for (size_type j = 0; j < e2.filled1 () -1; ++ j) {
+        for (size_type j = 0; j + 1 < e2.filled1 (); ++ j) {
             size_type begin = e2.index1_data () [j];
             size_type end = e2.index1_data () [j + 1];
             value_type t (v (j));
@@ -296,7 +648,7 @@ namespace boost { namespace numeric { namespace ublas {
                V &v, row_major_tag) {
         typedef typename V::size_type size_type;
 
-        for (size_type i = 0; i < e2.filled1 () -1; ++ i) {
+        for (size_type i = 0; i + 1 < e2.filled1 (); ++ i) {
             size_type begin = e2.index1_data () [i];
             size_type end = e2.index1_data () [i + 1];
             for (size_type j = begin; j < end; ++ j)
@@ -336,8 +688,9 @@ namespace boost { namespace numeric { namespace ublas {
                const compressed_matrix<T2, L2, 0, IA2, TA2> &e2) {
         typedef V vector_type;
 
-        vector_type v (e2.size2 ());
-        return axpy_prod (e1, e2, v, true);
+        vector_type v (detail::uninitialized_vector<vector_type>::construct (e2.size2 ()));
+        axpy_prod (e1, e2, v, true);
+        return v;
     }
 
     template<class V, class E1, class E2>
@@ -427,6 +780,53 @@ namespace boost { namespace numeric { namespace ublas {
     }
 
 
+    // Dense storage case
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const vector_expression<E1> &e1,
+               const matrix_expression<E2> &e2,
+               V &v, bool init, boost::mpl::true_) {
+        typedef typename V::value_type value_type;
+
+#if BOOST_UBLAS_TYPE_CHECK
+        vector<value_type> cv (v);
+        if (init)
+            cv.clear ();
+        typedef typename type_traits<value_type>::real_type real_type;
+        real_type verrorbound (norm_1 (cv) + norm_1 (e1) * norm_1 (e2));
+        indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
+#endif
+        detail::gemv_axpy (detail::transposed (detail::matrix_view (e2 ())), e1, value_type (1), v, init);
+#if BOOST_UBLAS_TYPE_CHECK
+        BOOST_UBLAS_CHECK (norm_1 (v - cv) <= 2 * std::numeric_limits<real_type>::epsilon () * verrorbound, internal_logic ());
+#endif
+        return v;
+    }
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const vector_expression<E1> &e1,
+               const matrix_expression<E2> &e2,
+               V &v, bool init, boost::mpl::false_) {
+        typedef typename V::value_type value_type;
+        typedef typename E1::const_iterator::iterator_category iterator_category;
+
+        if (init)
+            v.assign (zero_vector<value_type> (e2 ().size2 ()));
+#if BOOST_UBLAS_TYPE_CHECK
+        vector<value_type> cv (v);
+        typedef typename type_traits<value_type>::real_type real_type;
+        real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
+        indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
+#endif
+        axpy_prod (e1, e2, v, iterator_category ());
+#if BOOST_UBLAS_TYPE_CHECK
+        BOOST_UBLAS_CHECK (norm_1 (v - cv) <= 2 * std::numeric_limits<real_type>::epsilon () * verrorbound, internal_logic ());
+#endif
+        return v;
+    }
+
   /** \brief computes <tt>v += A<sup>T</sup> x</tt> or <tt>v = A<sup>T</sup> x</tt> in an
           optimized fashion.
 
@@ -458,22 +858,9 @@ namespace boost { namespace numeric { namespace ublas {
     axpy_prod (const vector_expression<E1> &e1,
                const matrix_expression<E2> &e2,
                V &v, bool init = true) {
-        typedef typename V::value_type value_type;
-        typedef typename E1::const_iterator::iterator_category iterator_category;
+        typedef boost::mpl::bool_<detail::matrix_storage<E2>::value && detail::vector_storage<V>::value> storage_category;
 
-        if (init)
-            v.assign (zero_vector<value_type> (e2 ().size2 ()));
-#if BOOST_UBLAS_TYPE_CHECK
-        vector<value_type> cv (v);
-        typedef typename type_traits<value_type>::real_type real_type;
-        real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
-        indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
-#endif
-        axpy_prod (e1, e2, v, iterator_category ());
-#if BOOST_UBLAS_TYPE_CHECK
-        BOOST_UBLAS_CHECK (norm_1 (v - cv) <= 2 * std::numeric_limits<real_type>::epsilon () * verrorbound, internal_logic ());
-#endif
-        return v;
+        return axpy_prod (e1, e2, v, init, storage_category ());
     }
     template<class V, class E1, class E2>
     BOOST_UBLAS_INLINE
@@ -482,8 +869,9 @@ namespace boost { namespace numeric { namespace ublas {
                const matrix_expression<E2> &e2) {
         typedef V vector_type;
 
-        vector_type v (e2 ().size2 ());
-        return axpy_prod (e1, e2, v, true);
+        vector_type v (detail::uninitialized_vector<vector_type>::construct (e2 ().size2 ()));
+        axpy_prod (e1, e2, v, true);
+        return v;
     }
 
     template<class M, class E1, class E2, class TRI>
@@ -662,8 +1050,50 @@ namespace boost { namespace numeric { namespace ublas {
         typedef M matrix_type;
         typedef TRI triangular_restriction;
 
-        matrix_type m (e1 ().size1 (), e2 ().size2 ());
-        return axpy_prod (e1, e2, m, triangular_restriction (), true);
+        matrix_type m (detail::uninitialized_matrix<matrix_type>::construct (e1 ().size1 (), e2 ().size2 ()));
+        axpy_prod (e1, e2, m, triangular_restriction (), true);
+        return m;
+    }
+
+    // Each row of the result adds the rows of e2 scaled by the band elements of the same row of e1,
+    // e2 being first copied into a row major matrix. Rows are evaluated in parallel when parallel_policy allows it,
+    // and with init are written without a zeroing pass.
+    template<class M, class T1, class L1, class A1, class E2>
+    BOOST_UBLAS_INLINE
+    M &
+    axpy_prod (const banded_matrix<T1, L1, A1> &e1,
+               const matrix_expression<E2> &e2,
+               M &m, bool init = true) {
+        typedef typename M::value_type value_type;
+        typedef const banded_matrix<T1, L1, A1> matrix_type;
+        typedef detail::band_storage<matrix_type> storage_type;
+        typedef typename storage_type::type view_type;
+        const std::size_t size1 = e1.size1 ();
+        const std::size_t size2 = e1.size2 ();
+        const std::size_t n = e2 ().size2 ();
+
+        BOOST_UBLAS_CHECK (size2 == e2 ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (size1 == m.size1 () && n == m.size2 (), bad_size ());
+        const matrix<value_type, row_major> b (e2);
+        const view_type a (storage_type::view (e1));
+        const detail::banded_axpy_block_row_task<view_type, value_type, M>
+            task (a, e1.lower (), e1.upper (), size2, size2 * n ? &b.data () [0] : 0, n, m, init);
+        if (detail::parallel_axpy_prod<M> (size1 * (e1.lower () + 1 + e1.upper ()) * n))
+            detail::parallel_for (0, size1, 1, task);
+        else
+            task (0, size1);
+        return m;
+    }
+    template<class M, class T1, class L1, class A1, class E2>
+    BOOST_UBLAS_INLINE
+    M
+    axpy_prod (const banded_matrix<T1, L1, A1> &e1,
+               const matrix_expression<E2> &e2) {
+        typedef M matrix_type;
+
+        matrix_type m (detail::uninitialized_matrix<matrix_type>::construct (e1.size1 (), e2 ().size2 ()));
+        axpy_prod (e1, e2, m, true);
+        return m;
     }
 
   /** \brief computes <tt>M += A X</tt> or <tt>M = A X</tt> in an
@@ -711,8 +1141,9 @@ namespace boost { namespace numeric { namespace ublas {
                const matrix_expression<E2> &e2) {
         typedef M matrix_type;
 
-        matrix_type m (e1 ().size1 (), e2 ().size2 ());
-        return axpy_prod (e1, e2, m, full (), true);
+        matrix_type m (detail::uninitialized_matrix<matrix_type>::construct (e1 ().size1 (), e2 ().size2 ()));
+        axpy_prod (e1, e2, m, full (), true);
+        return m;
     }
 
 
@@ -821,8 +1252,9 @@ namespace boost { namespace numeric { namespace ublas {
               const matrix_expression<E2> &e2) {
         typedef M matrix_type;
 
-        matrix_type m (e1 ().size1 (), e2 ().size2 ());
-        return opb_prod (e1, e2, m, true);
+        matrix_type m (detail::uninitialized_matrix<matrix_type>::construct (e1 ().size1 (), e2 ().size2 ()));
+        opb_prod (e1, e2, m, true);
+        return m;
     }
 
 }}}
@@ -0,0 +1,114 @@
+/**
+ * -*- c++ -*-
+ *
+ * \file fixed_size.hpp
+ *
+ * \brief The \c det, \c invert, \c inverse and \c transpose operations on fixed size matrices.
+ *
+ * Copyright (c) 2014, Mark Lingle, David Bellot
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef BOOST_NUMERIC_UBLAS_OPERATION_FIXED_SIZE_HPP
+#define BOOST_NUMERIC_UBLAS_OPERATION_FIXED_SIZE_HPP
+
+
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/detail/fixed_kernels.hpp>
+#include <boost/numeric/ublas/exception.hpp>
+#include <boost/numeric/ublas/expression_types.hpp>
+#include <boost/utility/enable_if.hpp>
+
+
+namespace boost { namespace numeric { namespace ublas {
+
+    /**
+     * \brief Whether \c E is a square matrix whose size is known at compile time.
+     */
+    template <typename E>
+    struct is_fixed_square {
+        enum {
+            value = fixed_size_traits<E>::value && int (fixed_size_traits<E>::rows) == int (fixed_size_traits<E>::cols),
+        };
+    };
+
+    /**
+     * \brief Return the determinant of a square fixed size matrix.
+     * Sizes up to 4 use closed forms, larger ones Gaussian elimination with partial pivoting.
+     * \tparam E A fixed size matrix type, such as \c fixed_matrix.
+     * \param m A square matrix.
+     * \return The determinant of \a m.
+     */
+    template <typename E>
+    BOOST_UBLAS_INLINE
+    typename ::boost::enable_if_c<is_fixed_square<E>::value, typename fixed_size_traits<E>::value_type>::type
+    det (matrix_expression<E> const& m)
+    {
+        typedef fixed_size_traits<E> traits;
+        // det (trans (m)) == det (m), so the storage order does not matter
+        return detail::fixed_determinant_kernel<typename traits::value_type, traits::rows>::apply (traits::data (m ()));
+    }
+
+    /**
+     * \brief Compute the inverse of a square fixed size matrix.
+     * Sizes up to 4 use the adjugate, larger ones Gauss-Jordan elimination with partial pivoting.
+     * \tparam E A fixed size matrix type, such as \c fixed_matrix.
+     * \param m A square matrix.
+     * \param inv The matrix receiving the inverse, it may be \a m itself. Unspecified if \a m is singular.
+     * \return \c false if \a m is singular.
+     */
+    template <typename E>
+    BOOST_UBLAS_INLINE
+    typename ::boost::enable_if_c<is_fixed_square<E>::value, bool>::type
+    invert (E const& m, E& inv)
+    {
+        typedef fixed_size_traits<E> traits;
+        // inverse (trans (m)) == trans (inverse (m)), so the storage order does not matter
+        return detail::fixed_inverse_kernel<typename traits::value_type, traits::rows>::apply (traits::data (m), traits::data (inv));
+    }
+
+    /**
+     * \brief Return the inverse of a square fixed size matrix.
+     * \tparam E A fixed size matrix type, such as \c fixed_matrix.
+     * \param m A square matrix.
+     * \return The inverse of \a m.
+     * \throw singular if \a m is singular.
+     */
+    template <typename E>
+    BOOST_UBLAS_INLINE
+    typename ::boost::enable_if_c<is_fixed_square<E>::value, E>::type
+    inverse (E const& m)
+    {
+        E inv;
+        if (! invert (m, inv))
+            singular ().raise ();
+        return inv;
+    }
+
+    /**
+     * \brief Return the transpose of a fixed size matrix as a new matrix.
+     * Unlike the lazy \c trans, the elements are copied at once by an unrolled kernel.
+     * \tparam E A fixed size matrix type, such as \c fixed_matrix.
+     * \param m A matrix.
+     * \return The transpose of \a m, with the same storage order.
+     */
+    template <typename E>
+    BOOST_UBLAS_INLINE
+    typename ::boost::enable_if_c<fixed_size_traits<E>::value, typename fixed_size_traits<E>::transpose_type>::type
+    transpose (E const& m)
+    {
+        typedef fixed_size_traits<E> traits;
+        typedef typename traits::transpose_type transpose_type;
+        transpose_type t;
+        detail::fixed_transpose<typename traits::value_type, traits::rows, traits::cols> (
+            traits::data (m), fixed_size_traits<transpose_type>::data (t), typename traits::orientation_category ());
+        return t;
+    }
+
+}}} // Namespace boost::numeric::ublas
+
+
+#endif // BOOST_NUMERIC_UBLAS_OPERATION_FIXED_SIZE_HPP
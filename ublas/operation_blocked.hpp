@@ -14,8 +14,10 @@
 #define _BOOST_UBLAS_OPERATION_BLOCKED_
 
 #include <boost/numeric/ublas/traits.hpp>
+#include <boost/numeric/ublas/matrix.hpp> // uninitialized_vector, uninitialized_matrix
 #include <boost/numeric/ublas/detail/vector_assign.hpp> // indexing_vector_assign
 #include <boost/numeric/ublas/detail/matrix_assign.hpp> // indexing_matrix_assign
+#include <boost/numeric/ublas/detail/scratch.hpp>
 
 
 namespace boost { namespace numeric { namespace ublas {
@@ -31,12 +33,15 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename V::size_type size_type;
         typedef typename V::value_type value_type;
         const size_type block_size = BS;
+        // The blocks are copied into temporaries drawn from the scratch arena of the thread
+        typedef unbounded_array<value_type, detail::scratch_allocator<value_type> > scratch_array_type;
+        detail::scratch_scope scope;
 
-        V v (e1 ().size1 ());
+        V v (detail::uninitialized_vector<V>::construct (e1 ().size1 ()));
 #if BOOST_UBLAS_TYPE_CHECK
         vector<value_type> cv (v.size ());
         typedef typename type_traits<value_type>::real_type real_type;
-        real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
+        real_type verrorbound (norm_1 (e1) * norm_1 (e2));
         indexing_vector_assign<scalar_assign> (cv, prod (e1, e2));
 #endif
         size_type i_size = e1 ().size1 ();
@@ -48,7 +53,7 @@ namespace boost { namespace numeric { namespace ublas {
             vector_range<vector_type> v_range (v, range (i_begin, i_end));
 #else
             // vector<value_type, bounded_array<value_type, block_size> > v_range (i_end - i_begin);
-            vector<value_type> v_range (i_end - i_begin);
+            vector<value_type, scratch_array_type> v_range (i_end - i_begin, no_init_tag ());
 #endif
             v_range.assign (zero_vector<value_type> (i_end - i_begin));
             for (size_type j_begin = 0; j_begin < j_size; j_begin += block_size) {
@@ -60,8 +65,8 @@ namespace boost { namespace numeric { namespace ublas {
 #else
                 // const matrix<value_type, row_major, bounded_array<value_type, block_size * block_size> > e1_range (project (e1 (), range (i_begin, i_end), range (j_begin, j_end)));
                 // const vector<value_type, bounded_array<value_type, block_size> > e2_range (project (e2 (), range (j_begin, j_end)));
-                const matrix<value_type, row_major> e1_range (project (e1 (), range (i_begin, i_end), range (j_begin, j_end)));
-                const vector<value_type> e2_range (project (e2 (), range (j_begin, j_end)));
+                const matrix<value_type, row_major, scratch_array_type> e1_range (project (e1 (), range (i_begin, i_end), range (j_begin, j_end)));
+                const vector<value_type, scratch_array_type> e2_range (project (e2 (), range (j_begin, j_end)));
                 v_range.plus_assign (prod (e1_range, e2_range));
 #endif
             }
@@ -86,12 +91,15 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename V::size_type size_type;
         typedef typename V::value_type value_type;
         const size_type block_size = BS;
+        // The blocks are copied into temporaries drawn from the scratch arena of the thread
+        typedef unbounded_array<value_type, detail::scratch_allocator<value_type> > scratch_array_type;
+        detail::scratch_scope scope;
 
-        V v (e2 ().size2 ());
+        V v (detail::uninitialized_vector<V>::construct (e2 ().size2 ()));
 #if BOOST_UBLAS_TYPE_CHECK
         vector<value_type> cv (v.size ());
         typedef typename type_traits<value_type>::real_type real_type;
-        real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
+        real_type verrorbound (norm_1 (e1) * norm_1 (e2));
         indexing_vector_assign<scalar_assign> (cv, prod (e1, e2));
 #endif
         size_type i_size = BOOST_UBLAS_SAME (e1 ().size (), e2 ().size1 ());
@@ -103,7 +111,7 @@ namespace boost { namespace numeric { namespace ublas {
             vector_range<vector_type> v_range (v, range (j_begin, j_end));
 #else
             // vector<value_type, bounded_array<value_type, block_size> > v_range (j_end - j_begin);
-            vector<value_type> v_range (j_end - j_begin);
+            vector<value_type, scratch_array_type> v_range (j_end - j_begin, no_init_tag ());
 #endif
             v_range.assign (zero_vector<value_type> (j_end - j_begin));
             for (size_type i_begin = 0; i_begin < i_size; i_begin += block_size) {
@@ -114,8 +122,8 @@ namespace boost { namespace numeric { namespace ublas {
 #else
                 // const vector<value_type, bounded_array<value_type, block_size> > e1_range (project (e1 (), range (i_begin, i_end)));
                 // const matrix<value_type, column_major, bounded_array<value_type, block_size * block_size> > e2_range (project (e2 (), range (i_begin, i_end), range (j_begin, j_end)));
-                const vector<value_type> e1_range (project (e1 (), range (i_begin, i_end)));
-                const matrix<value_type, column_major> e2_range (project (e2 (), range (i_begin, i_end), range (j_begin, j_end)));
+                const vector<value_type, scratch_array_type> e1_range (project (e1 (), range (i_begin, i_end)));
+                const matrix<value_type, column_major, scratch_array_type> e2_range (project (e2 (), range (i_begin, i_end), range (j_begin, j_end)));
 #endif
                 v_range.plus_assign (prod (e1_range, e2_range));
             }
@@ -141,12 +149,15 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename M::size_type size_type;
         typedef typename M::value_type value_type;
         const size_type block_size = BS;
+        // The blocks are copied into temporaries drawn from the scratch arena of the thread
+        typedef unbounded_array<value_type, detail::scratch_allocator<value_type> > scratch_array_type;
+        detail::scratch_scope scope;
 
-        M m (e1 ().size1 (), e2 ().size2 ());
+        M m (detail::uninitialized_matrix<M>::construct (e1 ().size1 (), e2 ().size2 ()));
 #if BOOST_UBLAS_TYPE_CHECK
         matrix<value_type, row_major> cm (m.size1 (), m.size2 ());
         typedef typename type_traits<value_type>::real_type real_type;
-        real_type merrorbound (norm_1 (m) + norm_1 (e1) * norm_1 (e2));
+        real_type merrorbound (norm_1 (e1) * norm_1 (e2));
         indexing_matrix_assign<scalar_assign> (cm, prod (e1, e2), row_major_tag ());
         disable_type_check<bool>::value = true;
 #endif
@@ -162,7 +173,7 @@ namespace boost { namespace numeric { namespace ublas {
                 matrix_range<matrix_type> m_range (m, range (i_begin, i_end), range (j_begin, j_end));
 #else
                 // matrix<value_type, row_major, bounded_array<value_type, block_size * block_size> > m_range (i_end - i_begin, j_end - j_begin);
-                matrix<value_type, row_major> m_range (i_end - i_begin, j_end - j_begin);
+                matrix<value_type, row_major, scratch_array_type> m_range (i_end - i_begin, j_end - j_begin, no_init_tag ());
 #endif
                 m_range.assign (zero_matrix<value_type> (i_end - i_begin, j_end - j_begin));
                 for (size_type k_begin = 0; k_begin < k_size; k_begin += block_size) {
@@ -173,8 +184,8 @@ namespace boost { namespace numeric { namespace ublas {
 #else
                     // const matrix<value_type, row_major, bounded_array<value_type, block_size * block_size> > e1_range (project (e1 (), range (i_begin, i_end), range (k_begin, k_end)));
                     // const matrix<value_type, column_major, bounded_array<value_type, block_size * block_size> > e2_range (project (e2 (), range (k_begin, k_end), range (j_begin, j_end)));
-                    const matrix<value_type, row_major> e1_range (project (e1 (), range (i_begin, i_end), range (k_begin, k_end)));
-                    const matrix<value_type, column_major> e2_range (project (e2 (), range (k_begin, k_end), range (j_begin, j_end)));
+                    const matrix<value_type, row_major, scratch_array_type> e1_range (project (e1 (), range (i_begin, i_end), range (k_begin, k_end)));
+                    const matrix<value_type, column_major, scratch_array_type> e2_range (project (e2 (), range (k_begin, k_end), range (j_begin, j_end)));
 #endif
                     m_range.plus_assign (prod (e1_range, e2_range));
                 }
@@ -202,12 +213,15 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename M::size_type size_type;
         typedef typename M::value_type value_type;
         const size_type block_size = BS;
+        // The blocks are copied into temporaries drawn from the scratch arena of the thread
+        typedef unbounded_array<value_type, detail::scratch_allocator<value_type> > scratch_array_type;
+        detail::scratch_scope scope;
 
-        M m (e1 ().size1 (), e2 ().size2 ());
+        M m (detail::uninitialized_matrix<M>::construct (e1 ().size1 (), e2 ().size2 ()));
 #if BOOST_UBLAS_TYPE_CHECK
         matrix<value_type, column_major> cm (m.size1 (), m.size2 ());
         typedef typename type_traits<value_type>::real_type real_type;
-        real_type merrorbound (norm_1 (m) + norm_1 (e1) * norm_1 (e2));
+        real_type merrorbound (norm_1 (e1) * norm_1 (e2));
         indexing_matrix_assign<scalar_assign> (cm, prod (e1, e2), column_major_tag ());
         disable_type_check<bool>::value = true;
 #endif
@@ -223,7 +237,7 @@ namespace boost { namespace numeric { namespace ublas {
                 matrix_range<matrix_type> m_range (m, range (i_begin, i_end), range (j_begin, j_end));
 #else
                 // matrix<value_type, column_major, bounded_array<value_type, block_size * block_size> > m_range (i_end - i_begin, j_end - j_begin);
-                matrix<value_type, column_major> m_range (i_end - i_begin, j_end - j_begin);
+                matrix<value_type, column_major, scratch_array_type> m_range (i_end - i_begin, j_end - j_begin, no_init_tag ());
 #endif
                 m_range.assign (zero_matrix<value_type> (i_end - i_begin, j_end - j_begin));
                 for (size_type k_begin = 0; k_begin < k_size; k_begin += block_size) {
@@ -234,8 +248,8 @@ namespace boost { namespace numeric { namespace ublas {
 #else
                     // const matrix<value_type, row_major, bounded_array<value_type, block_size * block_size> > e1_range (project (e1 (), range (i_begin, i_end), range (k_begin, k_end)));
                     // const matrix<value_type, column_major, bounded_array<value_type, block_size * block_size> > e2_range (project (e2 (), range (k_begin, k_end), range (j_begin, j_end)));
-                    const matrix<value_type, row_major> e1_range (project (e1 (), range (i_begin, i_end), range (k_begin, k_end)));
-                    const matrix<value_type, column_major> e2_range (project (e2 (), range (k_begin, k_end), range (j_begin, j_end)));
+                    const matrix<value_type, row_major, scratch_array_type> e1_range (project (e1 (), range (i_begin, i_end), range (k_begin, k_end)));
+                    const matrix<value_type, column_major, scratch_array_type> e2_range (project (e2 (), range (k_begin, k_end), range (j_begin, j_end)));
 #endif
                     m_range.plus_assign (prod (e1_range, e2_range));
                 }
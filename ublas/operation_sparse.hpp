@@ -13,7 +13,14 @@
 #ifndef _BOOST_UBLAS_OPERATION_SPARSE_
 #define _BOOST_UBLAS_OPERATION_SPARSE_
 
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/numeric/ublas/traits.hpp>
+#include <boost/numeric/ublas/matrix.hpp> // uninitialized_vector, uninitialized_matrix
+#include <boost/numeric/ublas/detail/parallel.hpp>
 
 // These scaled additions were borrowed from MTL unashamedly.
 // But Alexei Novakov had a lot of ideas to improve these. Thanks.
@@ -138,6 +145,202 @@ namespace boost { namespace numeric { namespace ublas {
         return m;
     }
 
+namespace detail {
+
+    /*
+        Sparse product of compressed matrices (Gustavson's algorithm) on their raw storage.
+
+        Computes the row major compressed storage r of c0 + a * b, reading a, b and the optional c0 as row
+        major compressed storage too (the column major case is the same computation on the transposes).
+        A symbolic pass counts the non zeros of every row of the result so that its arrays are allocated
+        once with their exact size, then a numeric pass fills every row in place with a dense accumulator
+        and a marker array, both of the width of the result and private to each thread.
+        Rows are processed in parallel when parallel_policy allows it, the symbolic pass splitting them by
+        non zeros of a and the numeric pass by non zeros of the result.
+        Structural zeros, from cancellation, are kept.
+    */
+    template<class M>
+    struct compressed_rows {
+        typedef typename M::value_type value_type;
+
+        compressed_rows (const M *m):
+            m (m), filled (m && m->filled1 () > 0 ? m->filled1 () - 1 : 0) {}
+
+        std::size_t begin (std::size_t i) const {
+            return i < filled ? m->index1_data () [i] : 0;
+        }
+        std::size_t end (std::size_t i) const {
+            return i < filled ? m->index1_data () [i + 1] : 0;
+        }
+        std::size_t index (std::size_t k) const {
+            return m->index2_data () [k];
+        }
+        const value_type &value (std::size_t k) const {
+            return m->value_data () [k];
+        }
+
+        const M *m;
+        std::size_t filled;
+    };
+
+    template<class MA, class MB, class MC, class R>
+    class sparse_product_kernel {
+    public:
+        typedef typename R::value_type value_type;
+
+        sparse_product_kernel (const MA &a, const MB &b, const MC *c0, R &r, std::size_t size2):
+            a (&a), b (&b), c0 (c0), r (r), size2 (size2) {}
+
+        // Counts the non zeros of the rows [first, last) into index1 [i + 1]
+        void symbolic (std::size_t first, std::size_t last) const {
+            std::vector<std::size_t> marker (size2, std::size_t (-1));
+            for (std::size_t i = first; i < last; ++ i) {
+                std::size_t count = 0;
+                for (std::size_t k = c0.begin (i); k < c0.end (i); ++ k)
+                    mark (marker, c0.index (k), i, count);
+                for (std::size_t ka = a.begin (i); ka < a.end (i); ++ ka) {
+                    const std::size_t j = a.index (ka);
+                    for (std::size_t kb = b.begin (j); kb < b.end (j); ++ kb)
+                        mark (marker, b.index (kb), i, count);
+                }
+                r.index1_data () [i + 1] = count;
+            }
+        }
+
+        // Fills the rows [first, last), whose extents in index1 are already known
+        void numeric (std::size_t first, std::size_t last) const {
+            std::vector<std::size_t> marker (size2, std::size_t (-1));
+            std::vector<value_type> accumulator (size2);
+            for (std::size_t i = first; i < last; ++ i) {
+                const std::size_t row = r.index1_data () [i];
+                std::size_t count = 0;
+                for (std::size_t k = c0.begin (i); k < c0.end (i); ++ k)
+                    accumulate (marker, accumulator, c0.index (k), c0.value (k), i, row, count);
+                for (std::size_t ka = a.begin (i); ka < a.end (i); ++ ka) {
+                    const std::size_t j = a.index (ka);
+                    const typename MA::value_type t = a.value (ka);
+                    for (std::size_t kb = b.begin (j); kb < b.end (j); ++ kb)
+                        accumulate (marker, accumulator, b.index (kb), t * b.value (kb), i, row, count);
+                }
+                std::sort (r.index2_data ().begin () + row, r.index2_data ().begin () + row + count);
+                for (std::size_t k = row; k < row + count; ++ k)
+                    r.value_data () [k] = accumulator [r.index2_data () [k]];
+            }
+        }
+
+        struct symbolic_task {
+            symbolic_task (const sparse_product_kernel &kernel, const std::vector<std::size_t> &bounds):
+                kernel (kernel), bounds (bounds) {}
+            void operator () (std::size_t first, std::size_t last) const {
+                kernel.symbolic (bounds [first], bounds [last]);
+            }
+            const sparse_product_kernel &kernel;
+            const std::vector<std::size_t> &bounds;
+        };
+
+        struct numeric_task {
+            numeric_task (const sparse_product_kernel &kernel, const std::vector<std::size_t> &bounds):
+                kernel (kernel), bounds (bounds) {}
+            void operator () (std::size_t first, std::size_t last) const {
+                kernel.numeric (bounds [first], bounds [last]);
+            }
+            const sparse_product_kernel &kernel;
+            const std::vector<std::size_t> &bounds;
+        };
+
+        void run (std::size_t size1) {
+            typename R::index_array_type &index1 = r.index1_data ();
+            const std::size_t parts = parallel_policy::enabled (a.m->nnz () + b.m->nnz ()) ? parallel_policy::num_threads () : 1;
+            std::vector<std::size_t> bounds;
+
+            if (parts > 1) {
+                detail::nonzero_partition (a.m->index1_data (), a.filled, parts, bounds);
+                bounds.back () = size1;
+                detail::parallel_for (0, parts, 1, symbolic_task (*this, bounds));
+            }
+            else {
+                symbolic (0, size1);
+            }
+
+            index1 [0] = 0;
+            for (std::size_t i = 0; i < size1; ++ i)
+                index1 [i + 1] += index1 [i];
+            const std::size_t nnz = index1 [size1];
+            r.reserve (nnz, false);
+
+            if (parts > 1) {
+                detail::nonzero_partition (index1, size1, parts, bounds);
+                detail::parallel_for (0, parts, 1, numeric_task (*this, bounds));
+            }
+            else {
+                numeric (0, size1);
+            }
+            r.set_filled (size1 + 1, nnz);
+        }
+
+    private:
+        static void mark (std::vector<std::size_t> &marker, std::size_t j, std::size_t i, std::size_t &count) {
+            if (marker [j] != i) {
+                marker [j] = i;
+                ++ count;
+            }
+        }
+
+        template<class T>
+        void accumulate (std::vector<std::size_t> &marker, std::vector<value_type> &accumulator,
+                         std::size_t j, const T &t, std::size_t i, std::size_t row, std::size_t &count) const {
+            if (marker [j] != i) {
+                marker [j] = i;
+                accumulator [j] = t;
+                r.index2_data () [row + count] = j;
+                ++ count;
+            }
+            else {
+                accumulator [j] += t;
+            }
+        }
+
+        compressed_rows<MA> a;
+        compressed_rows<MB> b;
+        compressed_rows<MC> c0;
+        R &r;
+        std::size_t size2;
+    };
+
+    // m = e1 * e2, or m += e1 * e2 without init, on the row major storage of compressed matrices.
+    // r has the shape of the result, size1 x size2 being the shape of its storage.
+    template<class M, class M1, class M2>
+    BOOST_UBLAS_INLINE
+    void compressed_sparse_prod (const M1 &e1, const M2 &e2, M &m, bool init, M &r, std::size_t size1, std::size_t size2) {
+        if (size1 > 0) {
+            sparse_product_kernel<M1, M2, M, M> kernel (e1, e2, init ? 0 : &m, r, size2);
+            kernel.run (size1);
+        }
+        m.swap (r);
+    }
+
+}
+
+    // Product of compressed matrices of the same orientation without index base, written straight into
+    // the compressed storage of m. With init == false the product is added to m.
+    template<class T, class L, class IA, class TA, class T1, class IA1, class TA1, class T2, class IA2, class TA2>
+    BOOST_UBLAS_INLINE
+    compressed_matrix<T, L, 0, IA, TA> &
+    sparse_prod (const compressed_matrix<T1, L, 0, IA1, TA1> &e1,
+                 const compressed_matrix<T2, L, 0, IA2, TA2> &e2,
+                 compressed_matrix<T, L, 0, IA, TA> &m, bool init = true) {
+        BOOST_UBLAS_CHECK (e1.size2 () == e2.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (init || (m.size1 () == e1.size1 () && m.size2 () == e2.size2 ()), bad_size ());
+        // computed aside and swapped in, m may also be an operand
+        compressed_matrix<T, L, 0, IA, TA> r (e1.size1 (), e2.size2 ());
+        if (boost::is_same<typename L::orientation_category, column_major_tag>::value)
+            // the column major storage of e1 * e2 is the row major storage of trans (e2) * trans (e1)
+            detail::compressed_sparse_prod (e2, e1, m, init, r, e2.size2 (), e1.size1 ());
+        else
+            detail::compressed_sparse_prod (e1, e2, m, init, r, e1.size1 (), e2.size2 ());
+        return m;
+    }
+
     // Dispatcher
     template<class M, class E1, class E2, class TRI>
     BOOST_UBLAS_INLINE
@@ -162,10 +365,11 @@ namespace boost { namespace numeric { namespace ublas {
         typedef M matrix_type;
         typedef TRI triangular_restriction;
 
-        matrix_type m (e1 ().size1 (), e2 ().size2 ());
+        matrix_type m (detail::uninitialized_matrix<matrix_type>::construct (e1 ().size1 (), e2 ().size2 ()));
         // FIXME needed for c_matrix?!
         // return sparse_prod (e1, e2, m, triangular_restriction (), false);
-        return sparse_prod (e1, e2, m, triangular_restriction (), true);
+        sparse_prod (e1, e2, m, triangular_restriction (), true);
+        return m;
     }
     template<class M, class E1, class E2>
     BOOST_UBLAS_INLINE
@@ -187,10 +391,280 @@ namespace boost { namespace numeric { namespace ublas {
                  const matrix_expression<E2> &e2) {
         typedef M matrix_type;
 
-        matrix_type m (e1 ().size1 (), e2 ().size2 ());
+        matrix_type m (detail::uninitialized_matrix<matrix_type>::construct (e1 ().size1 (), e2 ().size2 ()));
         // FIXME needed for c_matrix?!
         // return sparse_prod (e1, e2, m, full (), false);
-        return sparse_prod (e1, e2, m, full (), true);
+        sparse_prod (e1, e2, m, full (), true);
+        return m;
+    }
+
+namespace detail {
+
+    /*
+        Bulk construction of compressed storage from triplets (i, j, t) in any order.
+
+        Inserting unsorted elements one by one shifts the storage arrays at every insertion. The triplets
+        are instead bucketed by major index as in a counting sort: the elements of every major index are
+        counted, the counts summed into the extents of the major indices, and the triplets scattered into
+        the index2 and value arrays of the matrix, allocated once for all of them. Every major index is
+        then sorted by minor index, its duplicates summed, and the major indices finally packed together.
+        Beside the matrix, this takes one count per major index, and per thread when the triplets are
+        split over the threads of parallel_policy, which only happens when that is below the triplet count.
+        Duplicates are summed in the order of the triplets, whatever the number of threads.
+    */
+
+    // Triplets from three arrays of zero based indices and values
+    template<class L, class I1, class I2, class IT>
+    struct array_triplets {
+        array_triplets (std::size_t size, I1 index1, I2 index2, IT values):
+            size (size), index1 (index1), index2 (index2), values (values) {}
+
+        std::size_t major (std::size_t k) const {
+            return L::index_M (index1 [k], index2 [k]);
+        }
+        std::size_t minor (std::size_t k) const {
+            return L::index_m (index1 [k], index2 [k]);
+        }
+        typename std::iterator_traits<IT>::reference value (std::size_t k) const {
+            return values [k];
+        }
+
+        std::size_t size;
+        I1 index1;
+        I2 index2;
+        IT values;
+    };
+
+    // Triplets from the storage of a coordinate matrix, whose elements may be unsorted
+    template<class L, class C>
+    struct coordinate_triplets {
+        typedef typename C::orientation_category orientation_category;
+
+        coordinate_triplets (const C &c):
+            size (c.filled ()), c (c) {}
+
+        // (i, j) = (index_M, index_m) of the element in the layout of c
+        std::size_t index1 (std::size_t k) const {
+            return boost::is_same<orientation_category, row_major_tag>::value ? element1 (k) : element2 (k);
+        }
+        std::size_t index2 (std::size_t k) const {
+            return boost::is_same<orientation_category, row_major_tag>::value ? element2 (k) : element1 (k);
+        }
+        std::size_t major (std::size_t k) const {
+            return L::index_M (index1 (k), index2 (k));
+        }
+        std::size_t minor (std::size_t k) const {
+            return L::index_m (index1 (k), index2 (k));
+        }
+        const typename C::value_type &value (std::size_t k) const {
+            return c.value_data () [k];
+        }
+
+        std::size_t size;
+        const C &c;
+
+    private:
+        std::size_t element1 (std::size_t k) const {
+            return c.index1_data () [k] - C::index_base ();
+        }
+        std::size_t element2 (std::size_t k) const {
+            return c.index2_data () [k] - C::index_base ();
+        }
+    };
+
+    template<class M, class S>
+    class compressed_builder {
+    public:
+        typedef typename M::value_type value_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::index_array_type index_array_type;
+        typedef typename M::value_array_type value_array_type;
+        typedef std::pair<size_type, value_type> element_type;
+
+        compressed_builder (M &m, const S &s, std::size_t size_M, std::size_t size_m):
+            m (m), s (s), size_M (size_M), size_m (size_m), index2 (0), values (0) {}
+
+        // Counts the triplets [first, last) of part p by major index
+        void count (std::size_t p, std::size_t first, std::size_t last) {
+            std::size_t *c = position.data () + p * size_M;
+            for (std::size_t k = first; k < last; ++ k) {
+                BOOST_UBLAS_CHECK (s.major (k) < size_M && s.minor (k) < size_m, bad_index ());
+                ++ c [s.major (k)];
+            }
+        }
+
+        // Writes the triplets [first, last) of part p after those of the previous parts
+        void scatter (std::size_t p, std::size_t first, std::size_t last) {
+            std::size_t *c = position.data () + p * size_M;
+            for (std::size_t k = first; k < last; ++ k) {
+                const std::size_t q = c [s.major (k)] ++;
+                (*index2) [q] = size_type (s.minor (k));
+                (*values) [q] = s.value (k);
+            }
+        }
+
+        // Sorts the major indices [first, last) by minor index and sums their duplicates
+        void combine (std::size_t first, std::size_t last) {
+            std::vector<element_type> elements;
+            for (std::size_t r = first; r < last; ++ r) {
+                const std::size_t begin = start [r], end = start [r + 1];
+                elements.resize (end - begin);
+                for (std::size_t k = begin; k < end; ++ k)
+                    elements [k - begin] = element_type ((*index2) [k], (*values) [k]);
+                sort (elements);
+
+                std::size_t q = begin;
+                for (std::size_t k = 0; k < elements.size (); ++ q) {
+                    const size_type j = elements [k].first;
+                    value_type t = elements [k].second;
+                    for (++ k; k < elements.size () && elements [k].first == j; ++ k)
+                        t += elements [k].second;
+                    (*index2) [q] = j + M::index_base ();
+                    (*values) [q] = t;
+                }
+                filled [r] = q - begin;
+            }
+        }
+
+        void run () {
+            const std::size_t nnz = s.size;
+            std::size_t parts = parallel_policy::enabled (nnz) ? parallel_policy::num_threads () : 1;
+            parts = (std::max) ((std::min) (parts, nnz / (size_M + 1)), std::size_t (1));
+            std::vector<std::size_t> bounds (parts + 1);
+            for (std::size_t p = 0; p <= parts; ++ p)
+                bounds [p] = nnz / parts * p + nnz % parts * p / parts;
+
+            m.reserve (nnz, false);
+            // The capacity of m is at most size1 * size2: duplicated triplets beyond it are gathered aside
+            if (m.nnz_capacity () < nnz) {
+                spare_index2.resize (nnz);
+                spare_values.resize (nnz);
+                index2 = &spare_index2;
+                values = &spare_values;
+            }
+            else {
+                index2 = &m.index2_data ();
+                values = &m.value_data ();
+            }
+            position.assign (parts * size_M, 0);
+            parallel_for (0, parts, 1, [&] (std::size_t first, std::size_t last) {
+                for (std::size_t p = first; p < last; ++ p)
+                    count (p, bounds [p], bounds [p + 1]);
+            });
+
+            // Extents of the major indices, each part starting after the previous ones
+            start.resize (size_M + 1);
+            std::size_t sum = 0;
+            for (std::size_t r = 0; r < size_M; ++ r) {
+                start [r] = sum;
+                for (std::size_t p = 0; p < parts; ++ p) {
+                    const std::size_t c = position [p * size_M + r];
+                    position [p * size_M + r] = sum;
+                    sum += c;
+                }
+            }
+            start [size_M] = sum;
+
+            parallel_for (0, parts, 1, [&] (std::size_t first, std::size_t last) {
+                for (std::size_t p = first; p < last; ++ p)
+                    scatter (p, bounds [p], bounds [p + 1]);
+            });
+            std::vector<std::size_t> ().swap (position);
+
+            filled.resize (size_M);
+            if (parts > 1) {
+                nonzero_partition (start, size_M, parts, bounds);
+                parallel_for (0, parts, 1, [&] (std::size_t first, std::size_t last) {
+                    combine (bounds [first], bounds [last]);
+                });
+            }
+            else {
+                combine (0, size_M);
+            }
+
+            // Packs the major indices, whose duplicates left gaps
+            std::size_t q = 0;
+            for (std::size_t r = 0; r < size_M; ++ r) {
+                m.index1_data () [r] = q + M::index_base ();
+                if (q != start [r]) {
+                    std::copy (index2->begin () + start [r], index2->begin () + start [r] + filled [r], index2->begin () + q);
+                    std::copy (values->begin () + start [r], values->begin () + start [r] + filled [r], values->begin () + q);
+                }
+                q += filled [r];
+            }
+            m.index1_data () [size_M] = q + M::index_base ();
+            if (index2 == &spare_index2) {
+                m.reserve (q, true);
+                std::copy (spare_index2.begin (), spare_index2.begin () + q, m.index2_data ().begin ());
+                std::copy (spare_values.begin (), spare_values.begin () + q, m.value_data ().begin ());
+            }
+            m.set_filled (size_M + 1, q);
+        }
+
+    private:
+        static bool less (const element_type &e1, const element_type &e2) {
+            return e1.first < e2.first;
+        }
+
+        // Stable, so that duplicates are summed in the order of the triplets.
+        // The elements of a major index are usually few: insertion sort below 32 of them.
+        static void sort (std::vector<element_type> &elements) {
+            if (elements.size () > 32) {
+                std::stable_sort (elements.begin (), elements.end (), less);
+                return;
+            }
+            for (std::size_t k = 1; k < elements.size (); ++ k) {
+                const element_type e = elements [k];
+                std::size_t l = k;
+                for (; l > 0 && e.first < elements [l - 1].first; -- l)
+                    elements [l] = elements [l - 1];
+                elements [l] = e;
+            }
+        }
+
+        M &m;
+        const S &s;
+        std::size_t size_M;
+        std::size_t size_m;
+        std::vector<std::size_t> position;
+        std::vector<std::size_t> start;
+        std::vector<std::size_t> filled;
+        index_array_type *index2;
+        value_array_type *values;
+        index_array_type spare_index2;
+        value_array_type spare_values;
+    };
+
+}
+
+    // Builds m, of size size1 x size2, from the nnz triplets (index1 [k], index2 [k], values [k]) given in any
+    // order, summing duplicates. Indices are zero based. The storage of m is allocated once for nnz elements.
+    template<class T, class L, std::size_t IB, class IA, class TA, class I1, class I2, class IT>
+    compressed_matrix<T, L, IB, IA, TA> &
+    build_compressed (compressed_matrix<T, L, IB, IA, TA> &m,
+                      typename IA::value_type size1, typename IA::value_type size2,
+                      std::size_t nnz, I1 index1, I2 index2, IT values) {
+        typedef detail::array_triplets<L, I1, I2, IT> triplets_type;
+
+        m.resize (size1, size2, false);
+        triplets_type s (nnz, index1, index2, values);
+        detail::compressed_builder<compressed_matrix<T, L, IB, IA, TA>, triplets_type> builder (m, s, L::size_M (size1, size2), L::size_m (size1, size2));
+        builder.run ();
+        return m;
+    }
+
+    // Builds m from the elements of c, sorted or not, summing duplicates. c is left as it is.
+    template<class T, class L, std::size_t IB, class IA, class TA, class TC, class LC, std::size_t IBC, class IAC, class TAC>
+    compressed_matrix<T, L, IB, IA, TA> &
+    build_compressed (compressed_matrix<T, L, IB, IA, TA> &m,
+                      const coordinate_matrix<TC, LC, IBC, IAC, TAC> &c) {
+        typedef detail::coordinate_triplets<L, coordinate_matrix<TC, LC, IBC, IAC, TAC> > triplets_type;
+
+        m.resize (c.size1 (), c.size2 (), false);
+        triplets_type s (c);
+        detail::compressed_builder<compressed_matrix<T, L, IB, IA, TA>, triplets_type> builder (m, s, L::size_M (c.size1 (), c.size2 ()), L::size_m (c.size1 (), c.size2 ()));
+        builder.run ();
+        return m;
     }
 
 }}}
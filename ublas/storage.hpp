@@ -76,6 +76,21 @@ namespace boost { namespace numeric { namespace ublas {
           else
               data_ = 0;
         }
+        // Elements are left uninitialized, to be first written by the code computing them.
+        // Elements which must be destroyed are still value initialised.
+        BOOST_UBLAS_INLINE
+        unbounded_array (size_type size, no_init_tag, const ALLOC &a = ALLOC()):
+            alloc_ (a), size_ (size) {
+            if (size_) {
+                data_ = alloc_.allocate (size_);
+                if (! detail::has_trivial_destructor<T>::value) {
+                    for (pointer d = data_; d != data_ + size_; ++d)
+                        alloc_.construct(d, value_type());
+                }
+            }
+            else
+                data_ = 0;
+        }
         // No value initialised, but still be default constructed
         BOOST_UBLAS_INLINE
         unbounded_array (size_type size, const value_type &init, const ALLOC &a = ALLOC()):
@@ -98,6 +113,16 @@ namespace boost { namespace numeric { namespace ublas {
             else
                 data_ = 0;
         }
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        // Steals the storage of c, left empty
+        BOOST_UBLAS_INLINE
+        unbounded_array (unbounded_array &&c) BOOST_NOEXCEPT:
+            storage_array<unbounded_array<T, ALLOC> >(),
+            alloc_ (std::move (c.alloc_)), size_ (c.size_), data_ (c.data_) {
+            c.size_ = 0;
+            c.data_ = 0;
+        }
+#endif
         BOOST_UBLAS_INLINE
         ~unbounded_array () {
             if (size_) {
@@ -123,15 +148,16 @@ namespace boost { namespace numeric { namespace ublas {
                     if (preserve) {
                         pointer si = p_data;
                         pointer di = data_;
+                        // The old elements are destroyed below, so they may be moved from
                         if (size < size_) {
                             for (; di != data_ + size; ++di) {
-                                alloc_.construct (di, *si);
+                                alloc_.construct (di, BOOST_UBLAS_MOVE_ELEMENT (*si));
                                 ++si;
                             }
                         }
                         else {
                             for (pointer si = p_data; si != p_data + size_; ++si) {
-                                alloc_.construct (di, *si);
+                                alloc_.construct (di, BOOST_UBLAS_MOVE_ELEMENT (*si));
                                 ++di;
                             }
                             for (; di != data_ + size; ++di) {
@@ -212,12 +238,20 @@ namespace boost { namespace numeric { namespace ublas {
             swap (a);
             return *this;
         }
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        BOOST_UBLAS_INLINE
+        unbounded_array &operator = (unbounded_array &&a) BOOST_NOEXCEPT {
+            swap (a);
+            return *this;
+        }
+#endif
 
         // Swapping
         BOOST_UBLAS_INLINE
         void swap (unbounded_array &a) {
             if (this != &a) {
                 std::swap (size_, a.size_);
+                std::swap (alloc_, a.alloc_);
                 std::swap (data_, a.data_);
             }
         }
@@ -326,6 +360,11 @@ namespace boost { namespace numeric { namespace ublas {
             // data_ (an array) elements are already default constructed
         }
         BOOST_UBLAS_INLINE
+        bounded_array (size_type size, no_init_tag):
+            size_ (size) /*, data_ ()*/ {
+            BOOST_UBLAS_CHECK (size_ <= N, bad_size ());
+        }
+        BOOST_UBLAS_INLINE
         bounded_array (size_type size, const value_type &init):
             size_ (size) /*, data_ ()*/ {
             BOOST_UBLAS_CHECK (size_ <= N, bad_size ());
@@ -502,9 +541,19 @@ namespace boost { namespace numeric { namespace ublas {
             }
         }
         
+        // Elements are left uninitialized, as in unbounded_array
+        explicit BOOST_UBLAS_INLINE
+        aligned_array(no_init_tag) : alloc_ (allocator_type()), size_(N) {
+            data_ = alloc_.allocate (N);
+            if(!detail::has_trivial_destructor<T>::value) {
+                for(pointer d = data_; d != data_ + size_; ++d)
+                    alloc_.construct(d, value_type());
+            }
+        }
+        
         BOOST_UBLAS_INLINE
         aligned_array(const std::initializer_list<value_type>& init) :
-        alloc_ (allocator_type()), storage_array<self_type> () {
+        alloc_ (allocator_type()), size_ (init.size()) {
             data_ = alloc_.allocate (init.size());
             std::copy(init.begin(), init.end(), begin());
         }
@@ -521,6 +570,13 @@ namespace boost { namespace numeric { namespace ublas {
             data_ = alloc_.allocate (size_);
             std::copy(c.begin(), c.end(), begin());
         }
+        // Steals the storage of c, left empty
+        BOOST_UBLAS_INLINE
+        aligned_array(aligned_array&& c) BOOST_NOEXCEPT :
+        alloc_ (c.alloc_), size_ (c.size_), data_ (c.data_) {
+            c.size_ = 0;
+            c.data_ = 0;
+        }
         BOOST_UBLAS_INLINE
         aligned_array(size_type size, const value_type& init) :
         alloc_ (allocator_type()), size_(size) {
@@ -560,6 +616,11 @@ namespace boost { namespace numeric { namespace ublas {
         BOOST_UBLAS_INLINE
         aligned_array& operator = (const aligned_array& a) {
             if(this != &a) {
+                if (! data_) {
+                    // Moved from
+                    data_ = alloc_.allocate (a.size_);
+                    size_ = a.size_;
+                }
                 BOOST_UBLAS_CHECK(a.size_ == size_, bad_index ()); //should throw something other than bad_index()
                 size_ = a.size_;
                 std::copy (a.data_, a.data_ + a.size_, data_);
@@ -567,17 +628,23 @@ namespace boost { namespace numeric { namespace ublas {
             return *this;
         }
         BOOST_UBLAS_INLINE
+        aligned_array& operator = (aligned_array&& a) BOOST_NOEXCEPT {
+            swap (a);
+            return *this;
+        }
+        BOOST_UBLAS_INLINE
         aligned_array& assign_temporary (aligned_array& a) {
-            *this = a;
+            swap (a);
             return *this;
         }
         
         // Swapping
+        // The allocator is stateless, so the storage itself changes hands
         BOOST_UBLAS_INLINE
-        void swap (aligned_array &a) {
+        void swap (aligned_array &a) BOOST_NOEXCEPT {
             if (this != &a) {
-                BOOST_UBLAS_CHECK(a.size_ == size_, bad_index ()); //should throw something other than bad_index()
-                std::swap_ranges (data_, data_ + (std::max) (size_, a.size_), a.data_); //?
+                std::swap (size_, a.size_);
+                std::swap (data_, a.data_);
             }
         }
         BOOST_UBLAS_INLINE
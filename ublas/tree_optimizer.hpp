@@ -9,6 +9,8 @@
 
 #include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <typeinfo>
 #include <cstdlib>
 #include <ctime>
@@ -48,12 +50,21 @@
 #include <boost/numeric/ublas/expression_types.hpp>
 #include <boost/numeric/ublas/matrix_expression.hpp>
 #include <boost/numeric/ublas/functional.hpp>
+#include <boost/numeric/ublas/detail/packet.hpp>
+#include <boost/numeric/ublas/detail/parallel.hpp>
+#include <boost/numeric/ublas/detail/chain_order.hpp>
+#include <boost/numeric/ublas/detail/scratch.hpp>
+#include <boost/numeric/ublas/detail/fixed_kernels.hpp>
 
 namespace boost { namespace numeric { namespace ublas {
     
     // This is the maximum recursion depth for the mpl::vector expressions defined below.
     // This is to limit the maximum number of expression reogranizations for possible edge cases or bugs.
+    // The rewrites stop as soon as no pattern applies, so the limit only matters for deep expressions.
+    // Products are not reassociated here: chains are ordered at evaluation time by the cost model below.
+    #ifndef MAX_RECURSION_DEPTH
     #define MAX_RECURSION_DEPTH 5
+    #endif
     
     /*
         Start with the tree optimizer classes.
@@ -316,28 +327,6 @@ namespace boost { namespace numeric { namespace ublas {
         }
     };
     
-    // catch A * B - C and builds -C + A * B
-    template <typename A, typename B, typename C>
-    class tree_optimizer< dmatrix_difference< dmatrix_product<A, B>, C> > {
-        
-    private:
-        typedef dmatrix_difference<dmatrix_product<A, B>, C> MatXpr;
-        typedef typename tree_optimizer<C>::ReturnType New_C;
-        
-    public:
-        typedef dmatrix_sum<New_C, dmatrix_product<A, B> > ReturnType;
-        
-        enum {
-            treechanges = 1,
-        };
-        
-        static BOOST_UBLAS_INLINE
-        ReturnType build(const MatXpr& mxpr) {
-            return tree_optimizer<C>::build( (mxpr.mexpression2() *= C::value_type(-1)) ) + mxpr.mexpression1();
-        }
-        
-    };
-    
     // catch C + A * B - D and builds (C - D) + (A * B)
     template <typename A, typename B, typename C, typename D>
     class tree_optimizer< dmatrix_difference< dmatrix_sum<C, dmatrix_product<A, B> >, D> > {
@@ -384,29 +373,6 @@ namespace boost { namespace numeric { namespace ublas {
         
     };
 
-    // catch (A * B) * C and builds A * (B * C)
-    // very useful if C is a vector!
-    template <typename A, typename B, typename C>
-    class tree_optimizer< dmatrix_product< dmatrix_product<A, B>, C> > {
-        
-    private:
-        typedef dmatrix_product< dmatrix_product<A, B>, C> MatXpr;
-        typedef typename tree_optimizer<C>::ReturnType New_C;
-        
-    public:
-        typedef dmatrix_product< A, dmatrix_product<B, New_C> > ReturnType;
-        
-        enum {
-            treechanges = 1,
-        };
-        
-        static BOOST_UBLAS_INLINE
-        ReturnType build(const MatXpr& mxpr) {
-            return tree_optimizer<A>::build(mxpr.mexpression1().mexpression1()) * (tree_optimizer<B>::build(mxpr.mexpression1().mexpression2()) * tree_optimizer<C>::build(mxpr.mexpression2()));
-        }
-        
-    };
-    
     // catch (A * B) + (C * D) and builds (A * B) + (C * D)
     template <typename A, typename B, typename C, typename D>
     class tree_optimizer< dmatrix_sum< dmatrix_product<A, B>, dmatrix_product<C, D> > > {
@@ -548,6 +514,14 @@ namespace boost { namespace numeric { namespace ublas {
 
     template <typename T> class evaluator;
     
+    /*
+        Besides element access through operator() (i, j), evaluators of dense expressions expose linear access
+        in storage order: coeff (index) for one element and packet (index) for a SIMD packet of elements.
+        vectorizable tells whether linear and packet access are available, and orientation_category whether
+        the linear index runs over rows or columns. Two evaluators can be traversed together linearly only
+        if both are vectorizable and share the same orientation.
+    */
+    
     // Default evaluator
     template <typename E>
     class evaluator {
@@ -555,8 +529,13 @@ namespace boost { namespace numeric { namespace ublas {
     public:
         typedef typename E::value_type value_type;
         typedef typename E::size_type size_type;
+        typedef typename E::orientation_category orientation_category;
         typedef evaluator eval_type;
         
+        enum {
+            vectorizable = 0,
+        };
+        
         BOOST_UBLAS_INLINE
         evaluator(const E& e) : matxpr(e) { }
         
@@ -576,10 +555,17 @@ namespace boost { namespace numeric { namespace ublas {
     public:
         typedef T value_type;
         typedef typename fixed_matrix<T, M, N, L, A>::size_type size_type;
+        typedef typename L::orientation_category orientation_category;
+        typedef detail::packet_traits<T> packet_traits;
+        typedef typename packet_traits::type packet_type;
         typedef evaluator eval_type;
         
+        enum {
+            vectorizable = packet_traits::vectorized,
+        };
+        
         BOOST_UBLAS_INLINE
-        evaluator(const fixed_matrix<T, M, N, L, A>& e) : matxpr(e) { }
+        evaluator(const fixed_matrix<T, M, N, L, A>& e) : matxpr(e), data_(&e.data()[0]) { }
         
         BOOST_UBLAS_INLINE
         value_type operator() (size_type i, size_type j) const { return matxpr(i, j); }
@@ -587,8 +573,27 @@ namespace boost { namespace numeric { namespace ublas {
         BOOST_UBLAS_INLINE
         value_type& operator() (size_type i, size_type j) { return const_cast<fixed_matrix<T, M, N, L, A>&> (matxpr)(i, j); }
         
+        // Linear access in storage order
+        BOOST_UBLAS_INLINE
+        const value_type* data () const { return data_; }
+        
+        BOOST_UBLAS_INLINE
+        value_type coeff (size_type index) const { return data_[index]; }
+        
+        BOOST_UBLAS_INLINE
+        value_type& coeff_ref (size_type index) { return const_cast<value_type*> (data_)[index]; }
+        
+        BOOST_UBLAS_INLINE
+        packet_type packet (size_type index) const { return packet_traits::loadu(data_ + index); }
+        
+        BOOST_UBLAS_INLINE
+        void store_packet (size_type index, const packet_type& p) { packet_traits::storeu(const_cast<value_type*> (data_) + index, p); }
+        
         const fixed_matrix<T, M, N, L, A>& matxpr;
         
+    private:
+        const value_type* data_;
+        
     };
     
     template <typename T, typename L, typename A>
@@ -597,10 +602,17 @@ namespace boost { namespace numeric { namespace ublas {
     public:
         typedef T value_type;
         typedef typename matrix<T, L, A>::size_type size_type;
+        typedef typename L::orientation_category orientation_category;
+        typedef detail::packet_traits<T> packet_traits;
+        typedef typename packet_traits::type packet_type;
         typedef evaluator eval_type;
         
+        enum {
+            vectorizable = packet_traits::vectorized,
+        };
+        
         BOOST_UBLAS_INLINE
-        evaluator(const matrix<T, L, A>& e) : matxpr(e) { }
+        evaluator(const matrix<T, L, A>& e) : matxpr(e), data_(e.data().size() ? &e.data()[0] : 0) { }
       
         BOOST_UBLAS_INLINE
         value_type operator() (size_type i, size_type j) const { return matxpr(i, j); }
@@ -608,8 +620,49 @@ namespace boost { namespace numeric { namespace ublas {
         BOOST_UBLAS_INLINE
         value_type& operator() (size_type i, size_type j) { return const_cast<matrix<T, L, A>&> (matxpr)(i, j); }
         
+        // Linear access in storage order
+        BOOST_UBLAS_INLINE
+        const value_type* data () const { return data_; }
+        
+        BOOST_UBLAS_INLINE
+        value_type coeff (size_type index) const { return data_[index]; }
+        
+        BOOST_UBLAS_INLINE
+        value_type& coeff_ref (size_type index) { return const_cast<value_type*> (data_)[index]; }
+        
+        BOOST_UBLAS_INLINE
+        packet_type packet (size_type index) const { return packet_traits::loadu(data_ + index); }
+        
+        BOOST_UBLAS_INLINE
+        void store_packet (size_type index, const packet_type& p) { packet_traits::storeu(const_cast<value_type*> (data_) + index, p); }
+        
         const matrix<T, L, A>& matxpr;
         
+    private:
+        const value_type* data_;
+        
+    };
+    
+    // Closures of containers are matrix_references, evaluate the referred container directly
+    template <typename E>
+    class evaluator< matrix_reference<E> > : public evaluator<typename boost::remove_const<E>::type> {
+        
+    public:
+        typedef evaluator eval_type;
+        
+        BOOST_UBLAS_INLINE
+        evaluator(const matrix_reference<E>& e) : evaluator<typename boost::remove_const<E>::type>(e.expression()) { }
+        
+    };
+    
+    // Two evaluators can be traversed linearly together when both allow it in the same storage order
+    template <typename EvalA, typename EvalB>
+    struct linear_traversal {
+        enum {
+            value = EvalA::vectorizable && EvalB::vectorizable
+            && boost::is_same<typename EvalA::orientation_category, typename EvalB::orientation_category>::value
+            && boost::is_same<typename EvalA::value_type, typename EvalB::value_type>::value,
+        };
     };
 
     // evaluator of A + B
@@ -620,7 +673,17 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename dmatrix_sum<A, B>::value_type value_type;
         typedef typename dmatrix_sum<A, B>::size_type size_type;
         typedef typename dmatrix_sum<A, B>::functor_type functor_type;
+        typedef typename evaluator<A>::eval_type lhs_type;
+        typedef typename evaluator<B>::eval_type rhs_type;
+        typedef typename lhs_type::orientation_category orientation_category;
+        typedef detail::packet_traits<value_type> packet_traits;
+        typedef typename packet_traits::type packet_type;
         typedef evaluator eval_type;
+        
+        enum {
+            vectorizable = linear_traversal<lhs_type, rhs_type>::value
+            && boost::is_same<typename lhs_type::value_type, value_type>::value,
+        };
 
         BOOST_UBLAS_INLINE
         evaluator(const dmatrix_sum<A, B>& plus) : matrixl( plus.mexpression1() ), matrixr( plus.mexpression2() ) { }
@@ -628,8 +691,14 @@ namespace boost { namespace numeric { namespace ublas {
         BOOST_UBLAS_INLINE
         const value_type operator() (size_type i, size_type j) const { return functor_type::apply(matrixl, matrixr, i, j); }
         
-        typename evaluator<A>::eval_type matrixl;
-        typename evaluator<B>::eval_type matrixr;
+        BOOST_UBLAS_INLINE
+        value_type coeff (size_type index) const { return matrixl.coeff(index) + matrixr.coeff(index); }
+        
+        BOOST_UBLAS_INLINE
+        packet_type packet (size_type index) const { return packet_traits::add(matrixl.packet(index), matrixr.packet(index)); }
+        
+        lhs_type matrixl;
+        rhs_type matrixr;
 
     };
     
@@ -641,19 +710,121 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename dmatrix_difference<A, B>::value_type value_type;
         typedef typename dmatrix_difference<A, B>::size_type size_type;
         typedef typename dmatrix_difference<A, B>::functor_type functor_type;
+        typedef typename evaluator<A>::eval_type lhs_type;
+        typedef typename evaluator<B>::eval_type rhs_type;
+        typedef typename lhs_type::orientation_category orientation_category;
+        typedef detail::packet_traits<value_type> packet_traits;
+        typedef typename packet_traits::type packet_type;
         typedef evaluator eval_type;
         
+        enum {
+            vectorizable = linear_traversal<lhs_type, rhs_type>::value
+            && boost::is_same<typename lhs_type::value_type, value_type>::value,
+        };
+        
         BOOST_UBLAS_INLINE
         evaluator(const dmatrix_difference<A, B>& difference) : matrixl( difference.mexpression1() ), matrixr( difference.mexpression2() ) { }
         
         BOOST_UBLAS_INLINE
         const value_type operator() (size_type i, size_type j) const { return functor_type::apply(matrixl, matrixr, i, j); }
         
-        typename evaluator<A>::eval_type matrixl;
-        typename evaluator<B>::eval_type matrixr;
+        BOOST_UBLAS_INLINE
+        value_type coeff (size_type index) const { return matrixl.coeff(index) - matrixr.coeff(index); }
+        
+        BOOST_UBLAS_INLINE
+        packet_type packet (size_type index) const { return packet_traits::sub(matrixl.packet(index), matrixr.packet(index)); }
+        
+        lhs_type matrixl;
+        rhs_type matrixr;
+        
+    };
+    
+    // evaluator of t * A
+    template <typename E, typename T1, typename T2>
+    class evaluator< matrix_binary_scalar1<const T1, E, scalar_multiplies<T1, T2> > > {
+        
+    public:
+        typedef matrix_binary_scalar1<const T1, E, scalar_multiplies<T1, T2> > MatXpr;
+        typedef typename MatXpr::value_type value_type;
+        typedef typename MatXpr::size_type size_type;
+        typedef typename evaluator<typename boost::remove_const<typename boost::remove_reference<typename MatXpr::expression2_closure_type>::type>::type>::eval_type matrix_eval_type;
+        typedef typename matrix_eval_type::orientation_category orientation_category;
+        typedef detail::packet_traits<value_type> packet_traits;
+        typedef typename packet_traits::type packet_type;
+        typedef evaluator eval_type;
+        
+        enum {
+            vectorizable = matrix_eval_type::vectorizable
+            && boost::is_same<typename matrix_eval_type::value_type, value_type>::value
+            && boost::is_same<T1, value_type>::value,
+        };
+        
+        BOOST_UBLAS_INLINE
+        evaluator(const MatXpr& e) : scalar( e.expression1() ), matrixr( e.expression2() ), pscalar( packet_traits::set1(value_type(scalar)) ) { }
+        
+        BOOST_UBLAS_INLINE
+        const value_type operator() (size_type i, size_type j) const { return scalar * matrixr(i, j); }
+        
+        BOOST_UBLAS_INLINE
+        value_type coeff (size_type index) const { return scalar * matrixr.coeff(index); }
+        
+        BOOST_UBLAS_INLINE
+        packet_type packet (size_type index) const { return packet_traits::mul(pscalar, matrixr.packet(index)); }
+        
+        T1 scalar;
+        matrix_eval_type matrixr;
+        
+    private:
+        packet_type pscalar;
+        
+    };
+    
+    // evaluator of A * t
+    template <typename E, typename T1, typename T2>
+    class evaluator< matrix_binary_scalar2<E, const T2, scalar_multiplies<T1, T2> > > {
+        
+    public:
+        typedef matrix_binary_scalar2<E, const T2, scalar_multiplies<T1, T2> > MatXpr;
+        typedef typename MatXpr::value_type value_type;
+        typedef typename MatXpr::size_type size_type;
+        typedef typename evaluator<typename boost::remove_const<typename boost::remove_reference<typename MatXpr::expression1_closure_type>::type>::type>::eval_type matrix_eval_type;
+        typedef typename matrix_eval_type::orientation_category orientation_category;
+        typedef detail::packet_traits<value_type> packet_traits;
+        typedef typename packet_traits::type packet_type;
+        typedef evaluator eval_type;
+        
+        enum {
+            vectorizable = matrix_eval_type::vectorizable
+            && boost::is_same<typename matrix_eval_type::value_type, value_type>::value
+            && boost::is_same<T2, value_type>::value,
+        };
+        
+        BOOST_UBLAS_INLINE
+        evaluator(const MatXpr& e) : matrixl( e.expression1() ), scalar( e.expression2() ), pscalar( packet_traits::set1(value_type(scalar)) ) { }
+        
+        BOOST_UBLAS_INLINE
+        const value_type operator() (size_type i, size_type j) const { return matrixl(i, j) * scalar; }
+        
+        BOOST_UBLAS_INLINE
+        value_type coeff (size_type index) const { return matrixl.coeff(index) * scalar; }
+        
+        BOOST_UBLAS_INLINE
+        packet_type packet (size_type index) const { return packet_traits::mul(matrixl.packet(index), pscalar); }
+        
+        matrix_eval_type matrixl;
+        T2 scalar;
+        
+    private:
+        packet_type pscalar;
         
     };
     
+    // Dense temporary whose storage comes from the scratch arena of the current thread,
+    // released at the end of the top level assignment, so that evaluating the same
+    // expression again does not allocate
+    template <typename T>
+    using scratch_matrix = matrix<T, row_major, unbounded_array<T, detail::scratch_allocator<T> > >;
+    
     /**
         Matrix product evaluator, products must be evaluated into a temporary
         unless the evaluator is by passed by specializations of Assignment<>
@@ -666,42 +837,532 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename dmatrix_product<A, B>::value_type value_type;
         typedef typename dmatrix_product<A, B>::size_type size_type;
         typedef typename dmatrix_product<A, B>::functor_type functor_type;
+        typedef scratch_matrix<value_type> result_type;
+        typedef row_major_tag orientation_category;
+        typedef detail::packet_traits<value_type> packet_traits;
+        typedef typename packet_traits::type packet_type;
         typedef evaluator eval_type;
         
+        enum {
+            vectorizable = packet_traits::vectorized,
+        };
+        
         BOOST_UBLAS_INLINE
-        evaluator(const dmatrix_product<A, B>& product) : result(value_type(0)) {
-            product_add_impl(result, product); // evaluate to a temporary!
+        evaluator(const dmatrix_product<A, B>& product) : result(product.size1(), product.size2(), no_init_tag()) {
+            product_impl(result, product, value_type(1), value_type(0)); // evaluate to a temporary, beta = 0 writes every element
         }
         
         BOOST_UBLAS_INLINE
         const value_type operator() (size_type i, size_type j) const { return result(i, j); }
         
-        fixed_matrix<value_type, A::ColsAtCompileTime, B::RowsAtCompileTime> result; //fix me!
-        typename evaluator<A>::eval_type matrixl;
-        typename evaluator<B>::eval_type matrixr;
+        // Linear access in storage order of the temporary
+        BOOST_UBLAS_INLINE
+        value_type coeff (size_type index) const { return result.data()[index]; }
+        
+        BOOST_UBLAS_INLINE
+        packet_type packet (size_type index) const { return packet_traits::loadu(&result.data()[index]); }
+        
+        result_type result;
         
     };
     
-    /**
-        performs dest += a * b;
-        A general implementation must be available outside the evaluator because it is needed by both
-        evaluator<Product> and assignment<..., product<...> > for in-place product evaluation
+    template <typename A, typename B, typename Op>
+    void dense_assignment_loop(A& a, const B& b, const Op& op);
+    
+    //-------------------
+    // --- Cost model ---
+    //-------------------
+    
+    /*
+        Costs of evaluating an expression, in the units of num_traits<value_type>:
+        coeff is the cost of computing one element on demand, flops (e) the arithmetic needed to evaluate
+        every element once, memory (e) the elements read and written by that evaluation weighted by ReadCost.
+        direct tells whether the elements are read straight from dense storage.
+        describe (e, plan, operand) appends the evaluation of e to plan and returns its printed form,
+        operand numbering the leaves from the left.
+    */
+    struct expression_plan;
+    
+    template <typename E>
+    struct expression_cost {
+        typedef typename E::value_type value_type;
+        
+        enum {
+            direct = 0,
+            coeff = num_traits<value_type>::ReadCost,
+        };
+        
+        static double flops(const E&) { return 0.; }
+        static double memory(const E& e) { return double(num_traits<value_type>::ReadCost) * e.size1() * e.size2(); }
+        static std::string describe(const E&, expression_plan&, std::size_t& operand);
+    };
+    
+    template <typename T, typename L, typename A>
+    struct expression_cost< matrix<T, L, A> > {
+        typedef T value_type;
+        
+        enum {
+            direct = 1,
+            coeff = num_traits<value_type>::ReadCost,
+        };
+        
+        static double flops(const matrix<T, L, A>&) { return 0.; }
+        static double memory(const matrix<T, L, A>& e) { return double(coeff) * e.size1() * e.size2(); }
+        static std::string describe(const matrix<T, L, A>&, expression_plan&, std::size_t& operand);
+    };
+    
+    template <typename T, std::size_t M, std::size_t N, typename L, typename A>
+    struct expression_cost< fixed_matrix<T, M, N, L, A> > {
+        typedef T value_type;
+        
+        enum {
+            direct = 1,
+            coeff = num_traits<value_type>::ReadCost,
+        };
+        
+        static double flops(const fixed_matrix<T, M, N, L, A>&) { return 0.; }
+        static double memory(const fixed_matrix<T, M, N, L, A>&) { return double(coeff) * M * N; }
+        static std::string describe(const fixed_matrix<T, M, N, L, A>&, expression_plan&, std::size_t& operand);
+    };
+    
+    template <typename E>
+    struct expression_cost< matrix_reference<E> > {
+        typedef expression_cost<typename boost::remove_const<E>::type> referred;
+        typedef typename referred::value_type value_type;
+        
+        enum {
+            direct = referred::direct,
+            coeff = referred::coeff,
+        };
+        
+        static double flops(const matrix_reference<E>& e) { return referred::flops(e.expression()); }
+        static double memory(const matrix_reference<E>& e) { return referred::memory(e.expression()); }
+        static std::string describe(const matrix_reference<E>& e, expression_plan& plan, std::size_t& operand) {
+            return referred::describe(e.expression(), plan, operand);
+        }
+    };
+    
+    // Element-wise binary operations: A + B and A - B
+    template <typename A, typename B, typename Xpr, char Symbol>
+    struct elementwise_cost {
+        typedef typename Xpr::value_type value_type;
+        
+        enum {
+            direct = 0,
+            coeff = expression_cost<A>::coeff + expression_cost<B>::coeff + num_traits<value_type>::AddCost,
+        };
+        
+        static double flops(const Xpr& e) {
+            return expression_cost<A>::flops(e.mexpression1()) + expression_cost<B>::flops(e.mexpression2())
+                + double(num_traits<value_type>::AddCost) * e.size1() * e.size2();
+        }
+        static double memory(const Xpr& e) {
+            return expression_cost<A>::memory(e.mexpression1()) + expression_cost<B>::memory(e.mexpression2());
+        }
+        static std::string describe(const Xpr& e, expression_plan& plan, std::size_t& operand) {
+            const std::string lhs = expression_cost<A>::describe(e.mexpression1(), plan, operand);
+            return "(" + lhs + " " + Symbol + " " + expression_cost<B>::describe(e.mexpression2(), plan, operand) + ")";
+        }
+    };
+    
+    template <typename A, typename B>
+    struct expression_cost< dmatrix_sum<A, B> > : elementwise_cost<A, B, dmatrix_sum<A, B>, '+'> {};
+    
+    template <typename A, typename B>
+    struct expression_cost< dmatrix_difference<A, B> > : elementwise_cost<A, B, dmatrix_difference<A, B>, '-'> {};
+    
+    // Scaling by a scalar: t * A and A * t, Operand is the closure of A
+    template <typename Operand, typename Xpr>
+    struct scaling_cost {
+        typedef typename Xpr::value_type value_type;
+        typedef typename boost::remove_const<typename boost::remove_reference<Operand>::type>::type operand_type;
+        
+        enum {
+            direct = 0,
+            coeff = expression_cost<operand_type>::coeff + num_traits<value_type>::MultCost,
+        };
+        
+        template <typename E, typename T1, typename T2>
+        static const operand_type& matrix_operand(const matrix_binary_scalar1<const T1, E, scalar_multiplies<T1, T2> >& e) { return e.expression2(); }
+        template <typename E, typename T1, typename T2>
+        static const operand_type& matrix_operand(const matrix_binary_scalar2<E, const T2, scalar_multiplies<T1, T2> >& e) { return e.expression1(); }
+        
+        static double flops(const Xpr& e) {
+            return expression_cost<operand_type>::flops(matrix_operand(e)) + double(num_traits<value_type>::MultCost) * e.size1() * e.size2();
+        }
+        static double memory(const Xpr& e) { return expression_cost<operand_type>::memory(matrix_operand(e)); }
+        static std::string describe(const Xpr& e, expression_plan& plan, std::size_t& operand) {
+            return "(t * " + expression_cost<operand_type>::describe(matrix_operand(e), plan, operand) + ")";
+        }
+    };
+    
+    template <typename E, typename T1, typename T2>
+    struct expression_cost< matrix_binary_scalar1<const T1, E, scalar_multiplies<T1, T2> > >
+        : scaling_cost<typename matrix_binary_scalar1<const T1, E, scalar_multiplies<T1, T2> >::expression2_closure_type,
+                       matrix_binary_scalar1<const T1, E, scalar_multiplies<T1, T2> > > {};
+    
+    template <typename E, typename T1, typename T2>
+    struct expression_cost< matrix_binary_scalar2<E, const T2, scalar_multiplies<T1, T2> > >
+        : scaling_cost<typename matrix_binary_scalar2<E, const T2, scalar_multiplies<T1, T2> >::expression1_closure_type,
+                       matrix_binary_scalar2<E, const T2, scalar_multiplies<T1, T2> > > {};
+    
+    /*
+        A product chain A0 * A1 * ... * An-1 flattened into its operands, whatever the association written
+        by the user. collect (e, f) calls f on every operand from the left.
     */
+    template <typename E>
+    struct product_chain {
+        enum {
+            length = 1,
+        };
+        
+        template <typename F>
+        static void collect(const E& e, F& f) { f(e); }
+    };
+    
+    template <typename A, typename B>
+    struct product_chain< dmatrix_product<A, B> > {
+        enum {
+            length = product_chain<A>::length + product_chain<B>::length,
+        };
+        
+        template <typename F>
+        static void collect(const dmatrix_product<A, B>& e, F& f) {
+            product_chain<A>::collect(e.mexpression1(), f);
+            product_chain<B>::collect(e.mexpression2(), f);
+        }
+    };
+    
+    // Collects the dimensions of the operands of a chain, then its optimal association
+    struct chain_dimensions {
+        std::vector<std::size_t> dims;
+        
+        template <typename E>
+        void operator() (const E& e) {
+            if(dims.empty())
+                dims.push_back(e.size1());
+            dims.push_back(e.size2());
+        }
+    };
+    
+    template <typename A, typename B>
+    detail::matrix_chain_order product_chain_order(const dmatrix_product<A, B>& product) {
+        typedef typename dmatrix_product<A, B>::value_type value_type;
+        chain_dimensions dimensions;
+        product_chain< dmatrix_product<A, B> >::collect(product, dimensions);
+        return detail::matrix_chain_order(dimensions.dims, double(num_traits<value_type>::MultCost + num_traits<value_type>::AddCost));
+    }
+    
+    /*
+        Whether an operand of a product is evaluated once into a temporary rather than every time the GEMM
+        kernel packs it: the operand is read reads times, each time at its element cost, against a single
+        evaluation plus writing and reading back the temporary. Operands of longer chains always go through
+        temporaries unless they are dense containers.
+    */
+    template <typename E>
+    bool product_operand_temporary(std::size_t reads) {
+        typedef expression_cost<E> cost;
+        typedef typename cost::value_type value_type;
+        return ! cost::direct
+            && double(cost::coeff) * reads > double(cost::coeff) + 2. * num_traits<value_type>::ReadCost;
+    }
+    
+    // Number of times the packed GEMM kernel reads the left operand of a m x k by k x n product.
+    // The right operand is packed once per panel and read once.
+    template <typename T>
+    std::size_t product_lhs_reads(std::size_t n) {
+        const std::size_t nc = detail::gemm_blocking<T>::nc;
+        return n > nc ? (n + nc - 1) / nc : 1;
+    }
+    
+    template <typename A, typename B>
+    struct expression_cost< dmatrix_product<A, B> > {
+        typedef typename dmatrix_product<A, B>::value_type value_type;
+        
+        enum {
+            direct = 0,
+            coeff = num_traits<value_type>::ReadCost,
+        };
+        
+        struct operand_costs {
+            double flops;
+            double memory;
+            
+            template <typename E>
+            void operator() (const E& e) {
+                flops += expression_cost<E>::flops(e);
+                if(! expression_cost<E>::direct)
+                    memory += expression_cost<E>::memory(e) + double(num_traits<value_type>::ReadCost) * e.size1() * e.size2();
+            }
+        };
+        
+        static double flops(const dmatrix_product<A, B>& e) {
+            operand_costs operands = { 0., 0. };
+            product_chain< dmatrix_product<A, B> >::collect(e, operands);
+            return operands.flops + product_chain_order(e).cost();
+        }
+        static double memory(const dmatrix_product<A, B>& e) {
+            operand_costs operands = { 0., 0. };
+            product_chain< dmatrix_product<A, B> >::collect(e, operands);
+            const detail::matrix_chain_order order(product_chain_order(e));
+            return operands.memory + double(num_traits<value_type>::ReadCost) * order.elements(0, order.size() - 1);
+        }
+        static std::string describe(const dmatrix_product<A, B>& e, expression_plan& plan, std::size_t& operand);
+    };
+    
+    /*
+        Evaluation plan chosen for an expression, as returned by make_plan ().
+        order prints the expression with operands numbered from the left, and products associated the way
+        they are evaluated, e.g. "(A0 * (A1 * A2))". flops and memory are the costs of the whole evaluation
+        and temporaries counts the intermediate results of product chains and the operands evaluated before
+        a product.
+    */
+    struct expression_plan {
+        std::string order;
+        double flops;
+        double memory;
+        std::size_t temporaries;
+        
+        expression_plan() : flops(0.), memory(0.), temporaries(0) { }
+    };
+    
+    template <typename E>
+    std::string leaf_name(std::size_t& operand) {
+        std::ostringstream s;
+        s << 'A' << operand++;
+        return s.str();
+    }
+    
+    template <typename E>
+    std::string expression_cost<E>::describe(const E&, expression_plan&, std::size_t& operand) {
+        return leaf_name<E>(operand);
+    }
+    
+    template <typename T, typename L, typename A>
+    std::string expression_cost< matrix<T, L, A> >::describe(const matrix<T, L, A>&, expression_plan&, std::size_t& operand) {
+        return leaf_name< matrix<T, L, A> >(operand);
+    }
+    
+    template <typename T, std::size_t M, std::size_t N, typename L, typename A>
+    std::string expression_cost< fixed_matrix<T, M, N, L, A> >::describe(const fixed_matrix<T, M, N, L, A>&, expression_plan&, std::size_t& operand) {
+        return leaf_name< fixed_matrix<T, M, N, L, A> >(operand);
+    }
+    
+    // Describes the operands of a chain, counting those evaluated into temporaries
+    struct chain_description {
+        expression_plan& plan;
+        std::size_t& operand;
+        std::vector<std::string> names;
+        std::size_t length;
+        std::size_t index;
+        std::size_t n;
+        
+        template <typename E>
+        void operator() (const E& e) {
+            names.push_back(expression_cost<E>::describe(e, plan, operand));
+            const bool temporary = length > 2 ? ! expression_cost<E>::direct
+                                              : index == 0 && product_operand_temporary<E>(product_lhs_reads<typename E::value_type>(n));
+            if(temporary)
+                ++plan.temporaries;
+            ++index;
+        }
+    };
+    
+    template <typename A, typename B>
+    std::string expression_cost< dmatrix_product<A, B> >::describe(const dmatrix_product<A, B>& e, expression_plan& plan, std::size_t& operand) {
+        const std::size_t length = product_chain< dmatrix_product<A, B> >::length;
+        chain_description operands = { plan, operand, std::vector<std::string>(), length, 0, e.size2() };
+        product_chain< dmatrix_product<A, B> >::collect(e, operands);
+        plan.temporaries += length - 2;
+        return product_chain_order(e).to_string(operands.names);
+    }
+    
+    // The plan the cost model chooses for evaluating e
+    template <typename E>
+    expression_plan make_plan(const matrix_expression<E>& e) {
+        expression_plan plan;
+        std::size_t operand = 0;
+        plan.order = expression_cost<E>::describe(e(), plan, operand);
+        plan.flops = expression_cost<E>::flops(e());
+        plan.memory = expression_cost<E>::memory(e());
+        return plan;
+    }
+    
+    //------------------------------
+    // --- Product implementation ---
+    //------------------------------
+    
+    // Collects the operands of a chain as strided views of dense storage,
+    // evaluating the other operands into temporaries first.
+    template <typename T>
+    struct chain_operands {
+        std::vector< detail::strided_view<T> >& views;
+        std::vector< scratch_matrix<T> >& temporaries;
+        
+        template <typename L, typename A>
+        void operator() (const matrix<T, L, A>& e) {
+            views.push_back(view(e.size1() * e.size2() ? &e.data()[0] : 0, e.size1(), e.size2(), typename L::orientation_category()));
+        }
+        
+        template <std::size_t M, std::size_t N, typename L, typename A>
+        void operator() (const fixed_matrix<T, M, N, L, A>& e) {
+            views.push_back(view(&e.data()[0], M, N, typename L::orientation_category()));
+        }
+        
+        template <typename E>
+        void operator() (const matrix_reference<E>& e) {
+            (*this)(e.expression());
+        }
+        
+        template <typename E>
+        void operator() (const E& e) {
+            temporaries.emplace_back(e.size1(), e.size2(), no_init_tag());
+            dense_assignment_loop(temporaries.back(), e, scalar_assign<T, typename E::value_type>());
+            (*this)(temporaries.back());
+        }
+        
+        static detail::strided_view<T> view(const T* data, std::size_t size1, std::size_t size2, row_major_tag) {
+            return detail::strided_view<T>(data, size1, size2, size2, 1);
+        }
+        
+        static detail::strided_view<T> view(const T* data, std::size_t size1, std::size_t size2, column_major_tag) {
+            return detail::strided_view<T>(data, size1, size2, 1, size1);
+        }
+    };
+    
+    // Evaluates Ai * ... * Aj of a chain following its optimal association
+    template <typename T>
+    detail::strided_view<T> chain_product(const detail::matrix_chain_order& order, const std::vector< detail::strided_view<T> >& operands,
+                                          chain_operands<T>& collect, std::size_t i, std::size_t j) {
+        if(i == j)
+            return operands[i];
+        const std::size_t k = order.split(i, j);
+        const detail::strided_view<T> lhs = chain_product(order, operands, collect, i, k);
+        const detail::strided_view<T> rhs = chain_product(order, operands, collect, k + 1, j);
+        collect.temporaries.emplace_back(lhs.size1(), rhs.size2(), no_init_tag());
+        scratch_matrix<T>& result = collect.temporaries.back();
+        detail::gemm<T>(result, lhs, rhs, lhs.size1(), rhs.size2(), lhs.size2(), T(1), T(0));
+        collect(result);
+        return collect.views.back();
+    }
+    
+    // dest = beta * dest + alpha * a * b for chains of three or more operands, associated by the cost model
     template <typename Dest, typename A, typename B>
-    void product_add_impl(Dest& dest, const dmatrix_product<A, B>& product) {
+    void product_impl(Dest& dest, const dmatrix_product<A, B>& product,
+                      const typename dmatrix_product<A, B>::value_type& alpha,
+                      const typename dmatrix_product<A, B>::value_type& beta, boost::mpl::true_) {
         
+        typedef typename dmatrix_product<A, B>::value_type value_type;
         typedef typename dmatrix_product<A, B>::functor_type functor_type;
+        const std::size_t length = product_chain< dmatrix_product<A, B> >::length;
+        
+        // reserved up front: views keep pointing into the temporaries
+        std::vector< detail::strided_view<value_type> > views;
+        std::vector< scratch_matrix<value_type> > temporaries;
+        views.reserve(3 * length);
+        temporaries.reserve(2 * length);
+        chain_operands<value_type> collect = { views, temporaries };
+        product_chain< dmatrix_product<A, B> >::collect(product, collect);
+        
+        const std::vector< detail::strided_view<value_type> > operands(views);
+        const detail::matrix_chain_order order(product_chain_order(product));
+        const std::size_t k = order.split(0, length - 1);
+        const detail::strided_view<value_type> lhs = chain_product(order, operands, collect, 0, k);
+        const detail::strided_view<value_type> rhs = chain_product(order, operands, collect, k + 1, length - 1);
+        
+        functor_type::gemm(dest, lhs, rhs, lhs.size2(), alpha, beta);
+    }
+    
+    // dest = beta * dest + alpha * a * b for a single product
+    template <typename Dest, typename A, typename B>
+    void product_impl(Dest& dest, const dmatrix_product<A, B>& product,
+                      const typename dmatrix_product<A, B>::value_type& alpha,
+                      const typename dmatrix_product<A, B>::value_type& beta, boost::mpl::false_) {
         
-        evaluator<A> lhs(product.mexpression1());
-        evaluator<B> rhs(product.mexpression2());
+        typedef typename dmatrix_product<A, B>::value_type value_type;
+        typedef typename dmatrix_product<A, B>::functor_type functor_type;
         
-        for(std::size_t i = 0; i < dest.size1(); ++i) {
-            for(std::size_t j = 0; j < dest.size2(); ++j) {
-                dest(i, j) += functor_type::apply(lhs.matxpr, rhs.matxpr, i, j);
-            }
+        typename evaluator<B>::eval_type rhs(product.mexpression2());
+        
+        if(product_operand_temporary<A>(product_lhs_reads<value_type>(product.size2()))) {
+            const scratch_matrix<value_type> temporary(product.mexpression1());
+            typename evaluator< scratch_matrix<value_type> >::eval_type lhs(temporary);
+            functor_type::gemm(dest, lhs, rhs, product.mexpression1().size2(), alpha, beta);
+        }
+        else {
+            typename evaluator<A>::eval_type lhs(product.mexpression1());
+            functor_type::gemm(dest, lhs, rhs, product.mexpression1().size2(), alpha, beta);
         }
+    }
+    
+    // Whether dest = a * b can use the unrolled kernel on the storage of small fixed size matrices
+    template <typename Dest, typename A, typename B>
+    struct fixed_product {
+        enum {
+            value = fixed_size_compatible<Dest, A>::value && fixed_size_compatible<A, B>::value
+                && int(fixed_size_traits<A>::cols) == int(fixed_size_traits<B>::rows)
+                && int(fixed_size_traits<Dest>::rows) == int(fixed_size_traits<A>::rows)
+                && int(fixed_size_traits<Dest>::cols) == int(fixed_size_traits<B>::cols),
+        };
     };
     
+    struct fixed_product_tag {};
+    
+    // dest = beta * dest + alpha * a * b for small fixed size operands, without packing or temporaries on the heap
+    template <typename Dest, typename A, typename B>
+    void product_impl(Dest& dest, const dmatrix_product<A, B>& product,
+                      const typename dmatrix_product<A, B>::value_type& alpha,
+                      const typename dmatrix_product<A, B>::value_type& beta, fixed_product_tag) {
+        
+        typedef fixed_size_traits<A> traits_a;
+        typedef fixed_size_traits<B> traits_b;
+        typedef fixed_size_traits<Dest> traits_dest;
+        typedef typename traits_dest::value_type value_type;
+        const std::size_t size = traits_dest::rows * traits_dest::cols;
+        
+        // computed aside first, dest may be one of the operands
+        value_type result[size];
+        detail::fixed_product<value_type, traits_a::rows, traits_a::cols, traits_b::cols>(
+            traits_a::data(product.mexpression1()), traits_b::data(product.mexpression2()), result,
+            typename traits_dest::orientation_category());
+        
+        value_type* data = traits_dest::data(dest);
+        if(beta == value_type(0)) {
+            for(std::size_t i = 0; i < size; ++i)
+                data[i] = alpha == value_type(1) ? result[i] : alpha * result[i];
+        }
+        else {
+            for(std::size_t i = 0; i < size; ++i)
+                data[i] = beta * data[i] + alpha * result[i];
+        }
+    }
+    
+    /**
+        performs dest = beta * dest + alpha * a * b;
+        Small fixed size products use a fully unrolled kernel, all other in-place product evaluations
+        go through the packed GEMM kernel of the product functor.
+        Chains of products are associated by the cost model rather than as written.
+    */
+    template <typename Dest, typename A, typename B>
+    void product_impl(Dest& dest, const dmatrix_product<A, B>& product,
+                      const typename dmatrix_product<A, B>::value_type& alpha,
+                      const typename dmatrix_product<A, B>::value_type& beta) {
+        typedef typename boost::mpl::if_c<fixed_product<Dest, A, B>::value, fixed_product_tag,
+                                          boost::mpl::bool_<(product_chain< dmatrix_product<A, B> >::length > 2)> >::type dispatch;
+        product_impl(dest, product, alpha, beta, dispatch());
+    }
+    
+    /**
+        performs dest += a * b;
+        A general implementation must be available outside the evaluator because it is needed by both
+        evaluator<Product> and assignment<..., product<...> > for in-place product evaluation
+    */
+    template <typename Dest, typename A, typename B>
+    void product_add_impl(Dest& dest, const dmatrix_product<A, B>& product) {
+        typedef typename dmatrix_product<A, B>::value_type value_type;
+        product_impl(dest, product, value_type(1), value_type(1));
+    }
+    
     /**
         performs dest -= a * b;
         A general implementation must be available outside the evaluator because it is needed by both
@@ -709,18 +1370,9 @@ namespace boost { namespace numeric { namespace ublas {
      */
     template <typename Dest, typename A, typename B>
     void product_sub_impl(Dest& dest, const dmatrix_product<A, B>& product) {
-        
-        typedef typename dmatrix_product<A, B>::functor_type functor_type;
-        
-        evaluator<A> lhs(product.mexpression1());
-        evaluator<B> rhs(product.mexpression2());
-        
-        for(std::size_t i = 0; i < dest.size1(); ++i) {
-            for(std::size_t j = 0; j < dest.size2(); ++j) {
-                dest(i, j) -= functor_type::apply(lhs.matrixl, rhs.matrixr, i, j);
-            }
-        }
-    };
+        typedef typename dmatrix_product<A, B>::value_type value_type;
+        product_impl(dest, product, value_type(-1), value_type(1));
+    }
 
     //-------------------
     // --- Assignment ---
@@ -729,25 +1381,211 @@ namespace boost { namespace numeric { namespace ublas {
     template < typename A, typename B, typename Op>
     class assignment;
     
-    // Generic assignment loop for dense evaluators.
-    template <typename A, typename B, typename Op>
-    void dense_assignment_loop(A& a, const B& b, const Op& op) {
-        typename evaluator<A>::eval_type ea(a);
-        typename evaluator<B>::eval_type eb(b);
-
-        for(std::size_t i = 0; i < a.size1(); ++i) {
-            for(std::size_t j = 0; j < a.size2(); ++j) {
+    // Packet counterpart of the scalar assignment functors. Functors without one are never vectorized.
+    template <typename Op>
+    struct packet_assign_functor {
+        enum {
+            vectorizable = 0,
+        };
+    };
+    
+    template <typename T1, typename T2>
+    struct packet_assign_functor< scalar_assign<T1, T2> > {
+        enum {
+            vectorizable = 1,
+        };
+        
+        template <typename PacketTraits>
+        static BOOST_UBLAS_INLINE
+        typename PacketTraits::type apply(const typename PacketTraits::type&, const typename PacketTraits::type& b) {
+            return b;
+        }
+    };
+    
+    template <typename T1, typename T2>
+    struct packet_assign_functor< scalar_plus_assign<T1, T2> > {
+        enum {
+            vectorizable = 1,
+        };
+        
+        template <typename PacketTraits>
+        static BOOST_UBLAS_INLINE
+        typename PacketTraits::type apply(const typename PacketTraits::type& a, const typename PacketTraits::type& b) {
+            return PacketTraits::add(a, b);
+        }
+    };
+    
+    template <typename T1, typename T2>
+    struct packet_assign_functor< scalar_minus_assign<T1, T2> > {
+        enum {
+            vectorizable = 1,
+        };
+        
+        template <typename PacketTraits>
+        static BOOST_UBLAS_INLINE
+        typename PacketTraits::type apply(const typename PacketTraits::type& a, const typename PacketTraits::type& b) {
+            return PacketTraits::sub(a, b);
+        }
+    };
+    
+    // Whether an assignment functor subtracts its right hand side
+    template <typename Op>
+    struct is_minus_assign : boost::false_type {};
+    
+    template <typename T1, typename T2>
+    struct is_minus_assign< scalar_minus_assign<T1, T2> > : boost::true_type {};
+    
+    // Element by element assignment of the rows [first, last) of a row major destination.
+    template <typename EvalA, typename EvalB, typename Op>
+    void dense_assignment_tile(EvalA& ea, const EvalB& eb, std::size_t first, std::size_t last, std::size_t, std::size_t size2, const Op& op, row_major_tag) {
+        for(std::size_t i = first; i < last; ++i) {
+            for(std::size_t j = 0; j < size2; ++j) {
+                op.apply(ea(i, j), eb(i, j));
+            }
+        }
+    }
+    
+    // Element by element assignment of the columns [first, last) of a column major destination.
+    template <typename EvalA, typename EvalB, typename Op>
+    void dense_assignment_tile(EvalA& ea, const EvalB& eb, std::size_t first, std::size_t last, std::size_t size1, std::size_t, const Op& op, column_major_tag) {
+        for(std::size_t j = first; j < last; ++j) {
+            for(std::size_t i = 0; i < size1; ++i) {
                 op.apply(ea(i, j), eb(i, j));
             }
         }
-
+    }
+    
+    // Element by element assignment loop following the storage order of the destination.
+    // Large destinations are split into tiles of whole rows (or columns) evaluated on the thread pool;
+    // every element is computed exactly as in the serial loop.
+    template <typename EvalA, typename EvalB, typename Op>
+    void dense_assignment_loop(EvalA& ea, const EvalB& eb, std::size_t size1, std::size_t size2, const Op& op, boost::mpl::false_) {
+        typedef typename boost::mpl::if_<boost::is_same<typename EvalA::orientation_category, column_major_tag>,
+                                         column_major_tag, row_major_tag>::type orientation_category;
+        const std::size_t outer = boost::is_same<orientation_category, row_major_tag>::value ? size1 : size2;
+        
+        if(parallel_policy::enabled(size1 * size2)) {
+            detail::parallel_for(0, outer, 1, [&](std::size_t first, std::size_t last) {
+                dense_assignment_tile(ea, eb, first, last, size1, size2, op, orientation_category());
+            });
+        }
+        else {
+            dense_assignment_tile(ea, eb, 0, outer, size1, size2, op, orientation_category());
+        }
+    }
+    
+    // Packet assignment of the elements [first, last) in storage order; first must be aligned.
+    template <typename EvalA, typename EvalB, typename Op>
+    void dense_assignment_packets(EvalA& ea, const EvalB& eb, std::size_t first, std::size_t last, const Op&) {
+        typedef typename EvalA::packet_traits packet_traits;
+        typedef packet_assign_functor<Op> packet_functor;
+        
+        for(std::size_t index = first; index < last; index += packet_traits::size) {
+            ea.store_packet(index, packet_functor::template apply<packet_traits>(ea.packet(index), eb.packet(index)));
+        }
+    }
+    
+    // Linear assignment loop over whole packets: a scalar peel up to the first aligned element of the
+    // destination, the aligned packet loop, then a scalar tail for the remaining elements.
+    // When threads are enabled the packet loop is cut into chunks of whole cache lines, so that every
+    // element goes through the same peel, packet or tail path as in the serial loop.
+    template <typename EvalA, typename EvalB, typename Op>
+    void dense_assignment_loop(EvalA& ea, const EvalB& eb, std::size_t size1, std::size_t size2, const Op& op, boost::mpl::true_) {
+        typedef typename EvalA::value_type value_type;
+        typedef typename EvalA::packet_traits packet_traits;
+        const std::size_t psize = packet_traits::size;
+        const std::size_t size = size1 * size2;
+        
+        std::size_t peel = 0;
+        const std::size_t address = reinterpret_cast<std::size_t>(ea.data());
+        if(address % sizeof(value_type) == 0) {
+            peel = ((packet_traits::alignment - address % packet_traits::alignment) % packet_traits::alignment) / sizeof(value_type);
+            peel = (std::min)(peel, size);
+        }
+        const std::size_t packet_end = peel + (size - peel) / psize * psize;
+        
+        for(std::size_t index = 0; index < peel; ++index) {
+            op.apply(ea.coeff_ref(index), eb.coeff(index));
+        }
+        if(parallel_policy::enabled(size)) {
+            const std::size_t line = (std::max)(psize, std::size_t(64 / sizeof(value_type)) / psize * psize);
+            detail::parallel_for(peel, packet_end, line, [&](std::size_t first, std::size_t last) {
+                dense_assignment_packets(ea, eb, first, last, op);
+            });
+        }
+        else {
+            dense_assignment_packets(ea, eb, peel, packet_end, op);
+        }
+        for(std::size_t index = packet_end; index < size; ++index) {
+            op.apply(ea.coeff_ref(index), eb.coeff(index));
+        }
+    }
+    
+    // Element-wise assignments that the unrolled kernels can evaluate on the storage of small fixed size matrices
+    template <typename A, typename B, typename Op>
+    struct fixed_elementwise_assignment {
+        enum {
+            value = 0,
+        };
+    };
+    
+    template <typename A, typename L, typename R, typename Functor>
+    struct fixed_elementwise_operands {
+        enum {
+            value = fixed_size_compatible<A, L>::value && fixed_size_compatible<L, R>::value
+                && int(fixed_size_traits<A>::rows) == int(fixed_size_traits<L>::rows) && int(fixed_size_traits<A>::cols) == int(fixed_size_traits<L>::cols)
+                && int(fixed_size_traits<L>::rows) == int(fixed_size_traits<R>::rows) && int(fixed_size_traits<L>::cols) == int(fixed_size_traits<R>::cols),
+        };
+        
+        template <typename Xpr>
+        static void run(A& a, const Xpr& b) {
+            typedef fixed_size_traits<A> traits;
+            detail::fixed_elementwise_kernel<typename traits::value_type, traits::rows * traits::cols, Functor>::apply(
+                fixed_size_traits<L>::data(b.mexpression1()), fixed_size_traits<R>::data(b.mexpression2()), traits::data(a));
+        }
+    };
+    
+    template <typename A, typename L, typename R, typename T1, typename T2>
+    struct fixed_elementwise_assignment<A, dmatrix_sum<L, R>, scalar_assign<T1, T2> >:
+        fixed_elementwise_operands<A, L, R, detail::fixed_plus> {};
+    
+    template <typename A, typename L, typename R, typename T1, typename T2>
+    struct fixed_elementwise_assignment<A, dmatrix_difference<L, R>, scalar_assign<T1, T2> >:
+        fixed_elementwise_operands<A, L, R, detail::fixed_minus> {};
+    
+    template <typename A, typename B, typename Op>
+    void dense_assignment_loop(A& a, const B& b, const Op&, boost::mpl::true_) {
+        fixed_elementwise_assignment<A, B, Op>::run(a, b);
+    }
+    
+    template <typename A, typename B, typename Op>
+    void dense_assignment_loop(A& a, const B& b, const Op& op, boost::mpl::false_) {
+        typedef typename evaluator<A>::eval_type eval_a_type;
+        typedef typename evaluator<B>::eval_type eval_b_type;
+        typedef boost::mpl::bool_<linear_traversal<eval_a_type, eval_b_type>::value
+                                  && packet_assign_functor<Op>::vectorizable> vectorize;
+        
+        eval_a_type ea(a);
+        eval_b_type eb(b);
+        
+        dense_assignment_loop(ea, eb, a.size1(), a.size2(), op, vectorize());
+    }
+    
+    // Generic assignment loop for dense evaluators.
+    // Traverses both sides linearly with SIMD packets when their evaluators allow it;
+    // sums and differences of small fixed size matrices are fully unrolled.
+    template <typename A, typename B, typename Op>
+    void dense_assignment_loop(A& a, const B& b, const Op& op) {
+        dense_assignment_loop(a, b, op, boost::mpl::bool_<fixed_elementwise_assignment<A, B, Op>::value>());
     }
     
     /**
         This function exists to select the proper assignment class.
+        The temporaries of the assignment are drawn from the scratch arena of the thread.
     */
     template <typename Dest, typename Src, typename Func>
     void assign(Dest& dest, const Src& src, const Func& func) {
+        detail::scratch_scope scope;
         assignment<Dest, Src, Func>::run(dest, src, func);
     }
     
@@ -770,14 +1608,8 @@ namespace boost { namespace numeric { namespace ublas {
         
     public:
         static void run(A& a, const dmatrix_product<ProdLhs, ProdRhs>& b, const scalar_assign<typename ProdLhs::value_type, typename ProdRhs::value_type>&) {
-            // This is going to use += so we need to zero out the matrix a
-            for(std::size_t i = 0; i < a.size1(); ++i) {
-                for(std::size_t j = 0; j < a.size2(); ++j) {
-                    a(i, j) = value_type(0);
-                }
-            }
-            
-            product_add_impl(a, b);
+            // beta = 0 overwrites a without reading it, so no separate zeroing pass is needed
+            product_impl(a, b, value_type(1), value_type(0));
         }
     };
     
@@ -816,6 +1648,42 @@ namespace boost { namespace numeric { namespace ublas {
         
     };
     
+    // specialization for a = b * c - d
+    // evaluated as a = -d followed by a += b * c, so that d may be the destination itself
+    template<typename A, typename ProdLhs, typename ProdRhs, typename D, typename Op>
+    struct assignment<A, dmatrix_difference<dmatrix_product<ProdLhs, ProdRhs>, D>, Op> {
+        
+    private:
+        typedef typename dmatrix_product<ProdLhs, ProdRhs>::value_type value_type;
+        typedef typename boost::mpl::if_<is_minus_assign<Op>,
+                                         scalar_minus_assign<typename ProdLhs::value_type, typename ProdRhs::value_type>,
+                                         scalar_plus_assign<typename ProdLhs::value_type, typename ProdRhs::value_type> >::type product_op;
+        
+    public:
+        static void run(A& a, const dmatrix_difference<dmatrix_product<ProdLhs, ProdRhs>, D>& b, const Op& op) {
+            dense_assignment_loop(a, b.mexpression2() * value_type(-1), op);
+            assignment<A, dmatrix_product<ProdLhs, ProdRhs>, product_op>::run(a, b.mexpression1(), product_op());
+        }
+        
+    };
+    
+    // specialization for a = b * c - d * e
+    template<typename A, typename ProdLhs, typename ProdRhs, typename ProdLhs2, typename ProdRhs2, typename Op>
+    struct assignment<A, dmatrix_difference<dmatrix_product<ProdLhs, ProdRhs>, dmatrix_product<ProdLhs2, ProdRhs2> >, Op> {
+        
+    private:
+        typedef typename boost::mpl::if_<is_minus_assign<Op>,
+                                         scalar_plus_assign<typename ProdLhs2::value_type, typename ProdRhs2::value_type>,
+                                         scalar_minus_assign<typename ProdLhs2::value_type, typename ProdRhs2::value_type> >::type product_op;
+        
+    public:
+        static void run(A& a, const dmatrix_difference<dmatrix_product<ProdLhs, ProdRhs>, dmatrix_product<ProdLhs2, ProdRhs2> >& b, const Op& op) {
+            assignment<A, dmatrix_product<ProdLhs, ProdRhs>, Op>::run(a, b.mexpression1(), op);
+            assignment<A, dmatrix_product<ProdLhs2, ProdRhs2>, product_op>::run(a, b.mexpression2(), product_op());
+        }
+        
+    };
+    
     // specialization for a = d - b * c
     template<typename A, typename B, typename ProdLhs, typename ProdRhs, typename Op>
     struct assignment<A, dmatrix_difference<B, dmatrix_product<ProdLhs, ProdRhs> >, Op> {
@@ -109,6 +109,15 @@ namespace boost { namespace numeric { namespace ublas {
 	        vector_container<self_type> (),
 	        data_ (size, init) {}
 
+	/// \brief Constructor of a vector with a predefined size leaving the elements uninitialized
+	/// Use it for vectors entirely overwritten afterwards, such as the result of a product:
+	/// the memory is then first touched by the code computing the elements.
+	/// \param size of the vector
+	    BOOST_UBLAS_INLINE
+	    vector (size_type size, no_init_tag):
+	        vector_container<self_type> (),
+	        data_ (size, no_init_tag ()) {}
+
 	/// \brief Copy-constructor of a vector
 	/// \param v is the vector to be duplicated
 	    BOOST_UBLAS_INLINE
@@ -116,6 +125,22 @@ namespace boost { namespace numeric { namespace ublas {
 	        vector_container<self_type> (),
 	        data_ (v.data_) {}
 
+#ifdef BOOST_UBLAS_CPP_GE_2011
+	/// \brief Move-constructor of a vector
+	/// \param v is the vector whose storage is taken over, it is left empty
+	    BOOST_UBLAS_INLINE
+	    vector (vector &&v) BOOST_NOEXCEPT_IF (std::is_nothrow_move_constructible<array_type>::value):
+	        vector_container<self_type> (),
+	        data_ (std::move (v.data_)) {}
+
+	/// \brief Constructor of a vector taking over another container
+	/// \param data container of type \c A
+	     BOOST_UBLAS_INLINE
+	     vector (array_type &&data):
+	         vector_container<self_type> (),
+	         data_ (std::move (data)) {}
+#endif
+
 	/// \brief Copy-constructor of a vector from a vector_expression
 	/// Depending on the vector_expression, this constructor can have the cost of the computations 
 	/// of the expression (trivial to say it, but it is to take into account in your complexity calculations).
@@ -273,7 +298,7 @@ namespace boost { namespace numeric { namespace ublas {
 	     }
 
 	     // Assignment
-#ifdef BOOST_UBLAS_MOVE_SEMANTICS
+#if defined (BOOST_UBLAS_MOVE_SEMANTICS) && ! defined (BOOST_UBLAS_CPP_GE_2011)
 
 	/// \brief Assign a full vector (\e RHS-vector) to the current vector (\e LHS-vector)
 	/// \param v is the source vector
@@ -294,6 +319,17 @@ namespace boost { namespace numeric { namespace ublas {
 	         return *this;
 	     }
 #endif
+#ifdef BOOST_UBLAS_CPP_GE_2011
+	/// \brief Assign a temporary vector (\e RHS-vector) to the current vector (\e LHS-vector)
+	/// The storage of \c v is swapped in and released with \c v.
+	/// \param v is the source vector
+	/// \return a reference to a vector (i.e. the destination vector)
+	     BOOST_UBLAS_INLINE
+	     vector &operator = (vector &&v) BOOST_NOEXCEPT {
+	         assign_temporary (v);
+	         return *this;
+	     }
+#endif
 
 	/// \brief Assign a full vector (\e RHS-vector) to the current vector (\e LHS-vector)
 	/// Assign a full vector (\e RHS-vector) to the current vector (\e LHS-vector). This method does not create any temporary.
@@ -548,8 +548,8 @@ namespace boost { namespace numeric { namespace ublas {
             return BOOST_UBLAS_SAME (e1_.size (), e2_.size ()); 
         }
 
-    private:
-        // Accessors
+    public:
+        // Expression accessors
         BOOST_UBLAS_INLINE
         const expression1_closure_type &expression1 () const {
             return e1_;
@@ -987,6 +987,17 @@ namespace boost { namespace numeric { namespace ublas {
             return e2_.size ();
         }
 
+    public:
+        // Expression accessors
+        BOOST_UBLAS_INLINE
+        expression1_closure_type expression1 () const {
+            return e1_;
+        }
+        BOOST_UBLAS_INLINE
+        const expression2_closure_type &expression2 () const {
+            return e2_;
+        }
+
     public:
         // Element access
         BOOST_UBLAS_INLINE
@@ -1214,6 +1225,17 @@ namespace boost { namespace numeric { namespace ublas {
             return e1_.size (); 
         }
 
+    public:
+        // Expression accessors
+        BOOST_UBLAS_INLINE
+        const expression1_closure_type &expression1 () const {
+            return e1_;
+        }
+        BOOST_UBLAS_INLINE
+        expression2_closure_type expression2 () const {
+            return e2_;
+        }
+
     public:
         // Element access
         BOOST_UBLAS_INLINE
@@ -1457,6 +1479,17 @@ namespace boost { namespace numeric { namespace ublas {
         // Dense random access specialization
         BOOST_UBLAS_INLINE
         value_type evaluate (dense_random_access_iterator_tag) const {
+            return evaluate (dense_random_access_iterator_tag (), boost::mpl::bool_<detail::vector_storage<expression_closure_type>::value> ());
+        }
+
+        // Dense storage, reduced by the kernels of detail/reduce.hpp
+        BOOST_UBLAS_INLINE
+        value_type evaluate (dense_random_access_iterator_tag, boost::mpl::true_) const {
+            return functor_type::apply (detail::vector_storage<expression_closure_type>::view (e_));
+        }
+
+        BOOST_UBLAS_INLINE
+        value_type evaluate (dense_random_access_iterator_tag, boost::mpl::false_) const {
 #ifdef BOOST_UBLAS_USE_INDEXING
             return functor_type::apply (e_);
 #elif BOOST_UBLAS_USE_ITERATING
@@ -1594,6 +1627,20 @@ namespace boost { namespace numeric { namespace ublas {
         BOOST_UBLAS_INLINE
         value_type evaluate (dense_random_access_iterator_tag) const {
             BOOST_UBLAS_CHECK (e1_.size () == e2_.size (), external_logic());
+            return evaluate (dense_random_access_iterator_tag (),
+                             boost::mpl::bool_<detail::vector_storage<expression1_closure_type>::value &&
+                                               detail::vector_storage<expression2_closure_type>::value> ());
+        }
+
+        // Dense storage, reduced by the kernels of detail/reduce.hpp
+        BOOST_UBLAS_INLINE
+        value_type evaluate (dense_random_access_iterator_tag, boost::mpl::true_) const {
+            return functor_type::apply (detail::vector_storage<expression1_closure_type>::view (e1_),
+                                        detail::vector_storage<expression2_closure_type>::view (e2_));
+        }
+
+        BOOST_UBLAS_INLINE
+        value_type evaluate (dense_random_access_iterator_tag, boost::mpl::false_) const {
 #ifdef BOOST_UBLAS_USE_INDEXING
             return functor_type::apply (e1_, e2_);
 #elif BOOST_UBLAS_USE_ITERATING
@@ -16,6 +16,7 @@
 #include <boost/numeric/ublas/storage_sparse.hpp>
 #include <boost/numeric/ublas/vector_expression.hpp>
 #include <boost/numeric/ublas/detail/vector_assign.hpp>
+#include <boost/numeric/ublas/detail/radix_sort.hpp>
 #if BOOST_UBLAS_TYPE_CHECK
 #include <boost/numeric/ublas/vector.hpp>
 #endif
@@ -1847,32 +1848,26 @@ namespace boost { namespace numeric { namespace ublas {
         BOOST_UBLAS_INLINE
         void sort () const {
             if (! sorted_ && filled_ > 0) {
-                typedef index_pair_array<index_array_type, value_array_type> array_pair;
-                array_pair ipa (filled_, index_data_, value_data_);
 #ifndef BOOST_UBLAS_COO_ALWAYS_DO_FULL_SORT
-                const typename array_pair::iterator iunsorted = ipa.begin () + sorted_filled_;
-                // sort new elements and merge
-                std::sort (iunsorted, ipa.end ());
-                inplace_merge(0, sorted_filled_, filled_);
+                const std::size_t sorted = sorted_filled_;
 #else
-                const typename array_pair::iterator iunsorted = ipa.begin ();
-                std::sort (iunsorted, ipa.end ());
+                const std::size_t sorted = 0;
 #endif
-
-                // sum duplicates with += and remove
-                size_type filled = 0;
-                for (size_type i = 1; i < filled_; ++ i) {
-                    if (index_data_ [filled] != index_data_ [i]) {
-                        ++ filled;
-                        if (filled != i) {
-                            index_data_ [filled] = index_data_ [i];
-                            value_data_ [filled] = value_data_ [i];
+                // The values gathered aside
+                std::vector<value_type> values (filled_);
+                filled_ = detail::radix_sort_elements (sorted, filled_, detail::radix_bits (size_),
+                    [this] (std::size_t k) {
+                        return std::size_t (zero_based (index_data_ [k]));
+                    },
+                    [this, &values] (std::size_t q, std::size_t key, std::size_t k, bool first) {
+                        if (first) {
+                            index_data_ [q] = k_based (size_type (key));
+                            values [q] = value_data_ [k];
                         }
-                    } else {
-                        value_data_ [filled] += value_data_ [i];
-                    }
-                }
-                filled_ = filled + 1;
+                        else
+                            values [q] += value_data_ [k];
+                    });
+                std::copy (values.begin (), values.begin () + filled_, value_data_.begin ());
                 sorted_filled_ = filled_;
                 sorted_ = true;
                 storage_invariants ();